@@ -8,6 +8,7 @@
 
 #include <stdint.h>
 
+#include <algorithm>
 #include <utility>
 #include <variant>
 
@@ -23,6 +24,10 @@ bool IsVerticalFeatureTag(uint32_t tag) {
          tag == CFX_FontMapper::MakeTag('v', 'e', 'r', 't');
 }
 
+// Bounds the work of flattening overlapping coverage ranges. Real fonts
+// substitute a few thousand glyphs at most.
+constexpr size_t kMaxCoverageVisits = 4 * 65536;
+
 }  // namespace
 
 CFX_CTTGSUBTable::CFX_CTTGSUBTable(pdfium::span<const uint8_t> gsub) {
@@ -39,16 +44,22 @@ CFX_CTTGSUBTable::CFX_CTTGSUBTable(pdfium::span<const uint8_t> gsub) {
       }
     }
   }
-  if (!feature_set_.empty()) {
-    return;
+  if (feature_set_.empty()) {
+    int i = 0;
+    for (const FeatureRecord& feature : feature_list_) {
+      if (IsVerticalFeatureTag(feature.feature_tag)) {
+        feature_set_.insert(i);
+      }
+      ++i;
+    }
   }
 
-  int i = 0;
-  for (const FeatureRecord& feature : feature_list_) {
-    if (IsVerticalFeatureTag(feature.feature_tag)) {
-      feature_set_.insert(i);
-    }
-    ++i;
+  if (BuildVerticalGlyphMap()) {
+    // The parsed tables are no longer needed.
+    feature_set_.clear();
+    script_list_.clear();
+    feature_list_.clear();
+    lookup_list_.clear();
   }
 }
 
@@ -71,6 +82,16 @@ bool CFX_CTTGSUBTable::LoadGSUBTable(pdfium::span<const uint8_t> gsub) {
 }
 
 uint32_t CFX_CTTGSUBTable::GetVerticalGlyph(uint32_t glyphnum) const {
+  if (vertical_glyphs_.has_value()) {
+    auto it = std::lower_bound(
+        vertical_glyphs_->begin(), vertical_glyphs_->end(), glyphnum,
+        [](const std::pair<uint32_t, uint32_t>& entry, uint32_t glyph) {
+          return entry.first < glyph;
+        });
+    return it != vertical_glyphs_->end() && it->first == glyphnum ? it->second
+                                                                   : 0;
+  }
+
   for (uint32_t item : feature_set_) {
     std::optional<uint32_t> result =
         GetVerticalGlyphSub(feature_list_[item], glyphnum);
@@ -81,6 +102,83 @@ uint32_t CFX_CTTGSUBTable::GetVerticalGlyph(uint32_t glyphnum) const {
   return 0;
 }
 
+bool CFX_CTTGSUBTable::BuildVerticalGlyphMap() {
+  // Adds substitutions in the order GetVerticalGlyphSub() searches them, and
+  // keeps the first one found for each glyph.
+  std::map<uint32_t, uint32_t> vertical_glyphs;
+  size_t remaining_visits = kMaxCoverageVisits;
+  for (uint32_t item : feature_set_) {
+    for (int index : feature_list_[item].lookup_list_indices) {
+      if (!fxcrt::IndexInBounds(lookup_list_, index) ||
+          lookup_list_[index].lookup_type != 1) {
+        continue;
+      }
+      for (const SubTable& sub_table : lookup_list_[index].sub_tables) {
+        if (!AddVerticalGlyphs(sub_table, vertical_glyphs, remaining_visits)) {
+          return false;
+        }
+      }
+    }
+  }
+  vertical_glyphs_.emplace(vertical_glyphs.begin(), vertical_glyphs.end());
+  return true;
+}
+
+bool CFX_CTTGSUBTable::AddVerticalGlyphs(
+    const SubTable& sub_table,
+    std::map<uint32_t, uint32_t>& vertical_glyphs,
+    size_t& remaining_visits) const {
+  if (std::holds_alternative<std::monostate>(sub_table.table_data)) {
+    return true;
+  }
+
+  // Like GetCoverageIndex(), use the first coverage index of each glyph.
+  std::map<uint32_t, uint32_t> coverage_indices;
+  if (std::holds_alternative<DataVector<uint16_t>>(sub_table.coverage)) {
+    const auto& glyph_array =
+        std::get<DataVector<uint16_t>>(sub_table.coverage);
+    if (glyph_array.size() > remaining_visits) {
+      return false;
+    }
+    remaining_visits -= glyph_array.size();
+    uint32_t i = 0;
+    for (uint16_t glyph : glyph_array) {
+      coverage_indices.try_emplace(glyph, i++);
+    }
+  } else if (std::holds_alternative<std::vector<RangeRecord>>(
+                 sub_table.coverage)) {
+    for (const auto& range_rec :
+         std::get<std::vector<RangeRecord>>(sub_table.coverage)) {
+      if (range_rec.start > range_rec.end) {
+        continue;
+      }
+      const size_t count = range_rec.end - range_rec.start + 1;
+      if (count > remaining_visits) {
+        return false;
+      }
+      remaining_visits -= count;
+      for (uint32_t g = range_rec.start; g <= range_rec.end; ++g) {
+        coverage_indices.try_emplace(
+            g, range_rec.start_coverage_index + g - range_rec.start);
+      }
+    }
+  }
+
+  for (const auto& [glyph, index] : coverage_indices) {
+    if (std::holds_alternative<int16_t>(sub_table.table_data)) {
+      vertical_glyphs.try_emplace(
+          glyph, glyph + std::get<int16_t>(sub_table.table_data));
+      continue;
+    }
+    const auto& substitutes =
+        std::get<DataVector<uint16_t>>(sub_table.table_data);
+    if (fxcrt::IndexInBounds(substitutes, index)) {
+      vertical_glyphs.try_emplace(glyph, substitutes[index]);
+    }
+  }
+  return true;
+}
+
 std::optional<uint32_t> CFX_CTTGSUBTable::GetVerticalGlyphSub(
     const FeatureRecord& feature,
     uint32_t glyphnum) const {
@@ -9,19 +9,25 @@
 
 #include <stdint.h>
 
+#include <map>
 #include <optional>
 #include <set>
+#include <utility>
 #include <variant>
 #include <vector>
 
 #include "core/fxcrt/data_vector.h"
+#include "core/fxcrt/retain_ptr.h"
 #include "core/fxcrt/span.h"
 
-class CFX_CTTGSUBTable {
+// Reads the vertical glyph substitutions of a GSUB table. They are flattened
+// into one glyph to glyph map when the table is loaded, so instances can be
+// shared by all fonts using the same face.
+class CFX_CTTGSUBTable final : public Retainable {
  public:
-  explicit CFX_CTTGSUBTable(pdfium::span<const uint8_t> gsub);
-  ~CFX_CTTGSUBTable();
+  CONSTRUCT_VIA_MAKE_RETAIN;
 
+  // Returns 0 if `glyphnum` has no vertical substitute.
   uint32_t GetVerticalGlyph(uint32_t glyphnum) const;
 
  private:
@@ -77,6 +83,9 @@ class CFX_CTTGSUBTable {
     SubTables sub_tables;
   };
 
+  explicit CFX_CTTGSUBTable(pdfium::span<const uint8_t> gsub);
+  ~CFX_CTTGSUBTable() override;
+
   bool LoadGSUBTable(pdfium::span<const uint8_t> gsub);
   void Parse(pdfium::span<const uint8_t> scriptlist,
              pdfium::span<const uint8_t> featurelist,
@@ -92,6 +101,12 @@ class CFX_CTTGSUBTable {
   CoverageFormat ParseCoverage(pdfium::span<const uint8_t> raw);
   SubTable ParseSingleSubst(pdfium::span<const uint8_t> raw);
 
+  // Returns false if the substitutions cover too many glyphs to flatten.
+  bool BuildVerticalGlyphMap();
+  bool AddVerticalGlyphs(const SubTable& sub_table,
+                         std::map<uint32_t, uint32_t>& vertical_glyphs,
+                         size_t& remaining_visits) const;
+
   std::optional<uint32_t> GetVerticalGlyphSub(const FeatureRecord& feature,
                                               uint32_t glyphnum) const;
   std::optional<uint32_t> GetVerticalGlyphSub2(const Lookup& lookup,
@@ -108,6 +123,10 @@ class CFX_CTTGSUBTable {
   std::vector<ScriptRecord> script_list_;
   std::vector<FeatureRecord> feature_list_;
   std::vector<Lookup> lookup_list_;
+
+  // Glyphs and their vertical substitutes, sorted by glyph. When this is
+  // unset, the parsed lookups are searched instead.
+  std::optional<std::vector<std::pair<uint32_t, uint32_t>>> vertical_glyphs_;
 };
 
 #endif  // CORE_FPDFAPI_FONT_CFX_CTTGSUBTABLE_H_
@@ -0,0 +1,59 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fpdfapi/font/cfx_cttgsubtable.h"
+
+#include <stdint.h>
+
+#include "core/fxcrt/retain_ptr.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+// A GSUB table with no scripts and a 'vert' feature with two single
+// substitution lookups:
+// - Format 1, covering glyphs 5 and 6, adding 100.
+// - Format 2, covering glyphs 5 to 9, with substitutes for glyphs 5 to 8.
+constexpr uint8_t kGsubTable[] = {
+    // Header: version, ScriptList, FeatureList and LookupList offsets.
+    0x00, 0x01, 0x00, 0x00, 0x00, 0x0a, 0x00, 0x0c, 0x00, 0x1c,
+    // ScriptList at 10: no scripts.
+    0x00, 0x00,
+    // FeatureList at 12: one 'vert' feature.
+    0x00, 0x01, 'v', 'e', 'r', 't', 0x00, 0x08,
+    // Feature at 20: lookups 0 and 1.
+    0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x01,
+    // LookupList at 28: two lookups.
+    0x00, 0x02, 0x00, 0x06, 0x00, 0x1c,
+    // Lookup 0 at 34: one single substitution subtable.
+    0x00, 0x01, 0x00, 0x00, 0x00, 0x01, 0x00, 0x08,
+    // SingleSubst format 1 at 42: delta 100.
+    0x00, 0x01, 0x00, 0x06, 0x00, 0x64,
+    // Coverage format 1 at 48: glyphs 5 and 6.
+    0x00, 0x01, 0x00, 0x02, 0x00, 0x05, 0x00, 0x06,
+    // Lookup 1 at 56: one single substitution subtable.
+    0x00, 0x01, 0x00, 0x00, 0x00, 0x01, 0x00, 0x08,
+    // SingleSubst format 2 at 64: substitutes 200 to 203.
+    0x00, 0x02, 0x00, 0x0e, 0x00, 0x04, 0x00, 0xc8, 0x00, 0xc9, 0x00, 0xca,
+    0x00, 0xcb,
+    // Coverage format 2 at 78: glyphs 5 to 9.
+    0x00, 0x02, 0x00, 0x01, 0x00, 0x05, 0x00, 0x09, 0x00, 0x00};
+
+}  // namespace
+
+TEST(CFXCTTGSUBTableTest, GetVerticalGlyph) {
+  auto table = pdfium::MakeRetain<CFX_CTTGSUBTable>(kGsubTable);
+
+  // The first lookup that covers a glyph wins.
+  EXPECT_EQ(105u, table->GetVerticalGlyph(5));
+  EXPECT_EQ(106u, table->GetVerticalGlyph(6));
+  EXPECT_EQ(202u, table->GetVerticalGlyph(7));
+  EXPECT_EQ(203u, table->GetVerticalGlyph(8));
+
+  // Glyph 9 is covered, but has no substitute.
+  EXPECT_EQ(0u, table->GetVerticalGlyph(9));
+  EXPECT_EQ(0u, table->GetVerticalGlyph(4));
+  EXPECT_EQ(0u, table->GetVerticalGlyph(10));
+  EXPECT_EQ(0u, table->GetVerticalGlyph(0x10005));
+}
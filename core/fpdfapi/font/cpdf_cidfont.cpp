@@ -8,7 +8,9 @@
 
 #include <algorithm>
 #include <array>
+#include <iterator>
 #include <limits>
+#include <map>
 #include <utility>
 #include <vector>
 
@@ -26,7 +28,6 @@
 #include "core/fpdfapi/parser/cpdf_stream_acc.h"
 #include "core/fxcrt/check.h"
 #include "core/fxcrt/check_op.h"
-#include "core/fxcrt/fixed_size_data_vector.h"
 #include "core/fxcrt/fx_codepage.h"
 #include "core/fxcrt/fx_memory.h"
 #include "core/fxcrt/fx_safe_types.h"
@@ -49,8 +50,70 @@ struct LowHighValXY : LowHighVal {
   int y;
 };
 
-bool IsMetricForCID(const LowHighVal& val, uint16_t cid) {
-  return val.low <= cid && cid <= val.high;
+// A run of CIDs that take their metrics from `ranges[source]`, as returned by
+// ResolveMetricsRanges().
+struct CIDRun {
+  uint16_t first;
+  uint16_t last;
+  size_t source;
+};
+
+// Resolves `ranges` into sorted, disjoint runs of CIDs. When ranges overlap,
+// the first one to list a CID wins.
+template <typename T>
+std::vector<CIDRun> ResolveMetricsRanges(pdfium::span<const T> ranges) {
+  std::vector<CIDRun> runs;
+  // The CIDs already taken, as disjoint intervals that are merged when they
+  // touch, so that each range only steps over the intervals it joins.
+  std::map<int, int> taken;
+  for (size_t i = 0; i < ranges.size(); ++i) {
+    const int low = std::max(ranges[i].low, 0);
+    const int high =
+        std::min(ranges[i].high,
+                 static_cast<int>(std::numeric_limits<uint16_t>::max()));
+    if (low > high) {
+      continue;
+    }
+
+    auto it = taken.upper_bound(low);
+    if (it != taken.begin() && std::prev(it)->second >= low - 1) {
+      --it;
+    }
+    int next = low;
+    int merged_low = low;
+    int merged_high = high;
+    while (it != taken.end() && it->first <= high + 1) {
+      if (it->first > next) {
+        runs.push_back({static_cast<uint16_t>(next),
+                        static_cast<uint16_t>(it->first - 1), i});
+      }
+      next = std::max(next, it->second + 1);
+      merged_low = std::min(merged_low, it->first);
+      merged_high = std::max(merged_high, it->second);
+      it = taken.erase(it);
+    }
+    if (next <= high) {
+      runs.push_back(
+          {static_cast<uint16_t>(next), static_cast<uint16_t>(high), i});
+    }
+    taken[merged_low] = merged_high;
+  }
+  std::sort(runs.begin(), runs.end(), [](const CIDRun& a, const CIDRun& b) {
+    return a.first < b.first;
+  });
+  return runs;
+}
+
+template <typename T>
+const T* FindCIDRange(const std::vector<T>& ranges, uint16_t cid) {
+  auto it = std::upper_bound(
+      ranges.begin(), ranges.end(), cid,
+      [](uint16_t cid, const T& range) { return cid < range.first_cid; });
+  if (it == ranges.begin()) {
+    return nullptr;
+  }
+  --it;
+  return cid <= it->last_cid ? &*it : nullptr;
 }
 
 constexpr std::array<FX_CodePage, CIDSET_NUM_SETS> kCharsetCodePages = {
@@ -504,7 +567,7 @@ bool CPDF_CIDFont::Load() {
   default_width_ = pCIDFontDict->GetIntegerFor("DW", 1000);
   RetainPtr<const CPDF_Array> pWidthArray = pCIDFontDict->GetArrayFor("W");
   if (pWidthArray) {
-    LoadMetricsArray(std::move(pWidthArray), &width_list_, 1);
+    LoadWidths(std::move(pWidthArray));
   }
 
   if (!IsEmbedded()) {
@@ -528,7 +591,7 @@ bool CPDF_CIDFont::Load() {
   if (IsVertWriting()) {
     RetainPtr<const CPDF_Array> pWidth2Array = pCIDFontDict->GetArrayFor("W2");
     if (pWidth2Array) {
-      LoadMetricsArray(std::move(pWidth2Array), &vert_metrics_, 3);
+      LoadVertMetrics(std::move(pWidth2Array));
     }
 
     RetainPtr<const CPDF_Array> pDefaultArray =
@@ -583,46 +646,71 @@ int CPDF_CIDFont::GetCharWidthF(uint32_t charcode) {
   if (charcode < 0x80 && ansi_widths_fixed_) {
     return (charcode >= 32 && charcode < 127) ? 500 : 0;
   }
-  uint16_t cid = CIDFromCharCode(charcode);
-  auto lhv_span =
-      fxcrt::reinterpret_span<const LowHighVal>(pdfium::span(width_list_));
-  for (const auto& lhv : lhv_span) {
-    if (IsMetricForCID(lhv, cid)) {
-      return lhv.val;
-    }
-  }
-  return default_width_;
+  const WidthRange* range = FindWidthRange(CIDFromCharCode(charcode));
+  return range ? range->width : default_width_;
 }
 
 int16_t CPDF_CIDFont::GetVertWidth(uint16_t cid) const {
-  auto lhvxy_span =
-      fxcrt::reinterpret_span<const LowHighValXY>(pdfium::span(vert_metrics_));
-  for (const auto& lhvxy : lhvxy_span) {
-    if (IsMetricForCID(lhvxy, cid)) {
-      return lhvxy.val;
-    }
-  }
-  return default_w1_;
+  const VertMetricsRange* range = FindVertMetricsRange(cid);
+  return range ? range->width : default_w1_;
 }
 
 CFX_Point16 CPDF_CIDFont::GetVertOrigin(uint16_t cid) const {
-  auto lhvxy_span =
-      fxcrt::reinterpret_span<const LowHighValXY>(pdfium::span(vert_metrics_));
-  for (const auto& lhvxy : lhvxy_span) {
-    if (IsMetricForCID(lhvxy, cid)) {
-      return {static_cast<int16_t>(lhvxy.x), static_cast<int16_t>(lhvxy.y)};
-    }
+  const VertMetricsRange* vert_range = FindVertMetricsRange(cid);
+  if (vert_range) {
+    return {static_cast<int16_t>(vert_range->origin_x),
+            static_cast<int16_t>(vert_range->origin_y)};
   }
-  int width = default_width_;
+  const WidthRange* range = FindWidthRange(cid);
+  const int width = range ? range->width : default_width_;
+  return {static_cast<int16_t>(width / 2), default_vy_};
+}
+
+void CPDF_CIDFont::LoadWidths(RetainPtr<const CPDF_Array> widths) {
+  std::vector<int> metrics;
+  LoadMetricsArray(std::move(widths), &metrics, 1);
   auto lhv_span =
-      fxcrt::reinterpret_span<const LowHighVal>(pdfium::span(width_list_));
-  for (const auto& lhv : lhv_span) {
-    if (IsMetricForCID(lhv, cid)) {
-      width = lhv.val;
-      break;
+      fxcrt::reinterpret_span<const LowHighVal>(pdfium::span(metrics));
+  for (const CIDRun& run : ResolveMetricsRanges(lhv_span)) {
+    const int width = lhv_span[run.source].val;
+    if (!width_ranges_.empty() &&
+        width_ranges_.back().last_cid + 1 == run.first &&
+        width_ranges_.back().width == width) {
+      width_ranges_.back().last_cid = run.last;
+      continue;
     }
+    width_ranges_.push_back({run.first, run.last, width});
   }
-  return {static_cast<int16_t>(width / 2), default_vy_};
+}
+
+void CPDF_CIDFont::LoadVertMetrics(RetainPtr<const CPDF_Array> vert_metrics) {
+  std::vector<int> metrics;
+  LoadMetricsArray(std::move(vert_metrics), &metrics, 3);
+  auto lhvxy_span =
+      fxcrt::reinterpret_span<const LowHighValXY>(pdfium::span(metrics));
+  for (const CIDRun& run : ResolveMetricsRanges(lhvxy_span)) {
+    const LowHighValXY& lhvxy = lhvxy_span[run.source];
+    if (!vert_metrics_ranges_.empty()) {
+      VertMetricsRange& last = vert_metrics_ranges_.back();
+      if (last.last_cid + 1 == run.first && last.width == lhvxy.val &&
+          last.origin_x == lhvxy.x && last.origin_y == lhvxy.y) {
+        last.last_cid = run.last;
+        continue;
+      }
+    }
+    vert_metrics_ranges_.push_back(
+        {run.first, run.last, lhvxy.val, lhvxy.x, lhvxy.y});
+  }
+}
+
+const CPDF_CIDFont::WidthRange* CPDF_CIDFont::FindWidthRange(
+    uint16_t cid) const {
+  return FindCIDRange(width_ranges_, cid);
+}
+
+const CPDF_CIDFont::VertMetricsRange* CPDF_CIDFont::FindVertMetricsRange(
+    uint16_t cid) const {
+  return FindCIDRange(vert_metrics_ranges_, cid);
 }
 
 int CPDF_CIDFont::GetGlyphIndex(uint32_t unicode, bool* pVertGlyph) {
@@ -639,26 +727,14 @@ int CPDF_CIDFont::GetGlyphIndex(uint32_t unicode, bool* pVertGlyph) {
     return index;
   }
 
-  if (ttg_subtable_) {
-    return GetVerticalGlyph(index, pVertGlyph);
+  if (!ttg_subtable_loaded_) {
+    ttg_subtable_ =
+        CPDF_FontGlobals::GetInstance()->GetGSUBTable(font_.GetFace());
+    ttg_subtable_loaded_ = true;
   }
-
-  static constexpr uint32_t kGsubTag =
-      CFX_FontMapper::MakeTag('G', 'S', 'U', 'B');
-  RetainPtr<CFX_Face> face = font_.GetFace();
-  size_t length = face->GetSfntTable(kGsubTag, {});
-  if (!length) {
+  if (!ttg_subtable_) {
     return index;
   }
-
-  auto sub_data = FixedSizeDataVector<uint8_t>::Uninit(length);
-  if (!face->GetSfntTable(kGsubTag, sub_data.span())) {
-    return index;
-  }
-
-  // CFX_CTTGSUBTable parses the data and stores all the values in its structs.
-  // It does not store pointers into `sub_data`.
-  ttg_subtable_ = std::make_unique<CFX_CTTGSUBTable>(sub_data.span());
   return GetVerticalGlyph(index, pVertGlyph);
 }
 
@@ -10,7 +10,6 @@
 #include <stdint.h>
 
 #include <array>
-#include <memory>
 #include <vector>
 
 #include "core/fpdfapi/font/cpdf_font.h"
@@ -40,6 +39,7 @@ struct CIDTransform {
 };
 
 class CFX_CTTGSUBTable;
+class CPDF_Array;
 class CPDF_CID2UnicodeMap;
 class CPDF_CMap;
 class CPDF_StreamAcc;
@@ -79,18 +79,39 @@ class CPDF_CIDFont final : public CPDF_Font {
     kTrueType  // CIDFontType2
   };
 
+  // The metrics of CIDs `first_cid` to `last_cid`, compiled from /W.
+  struct WidthRange {
+    uint16_t first_cid;
+    uint16_t last_cid;
+    int width;
+  };
+
+  // The metrics of CIDs `first_cid` to `last_cid`, compiled from /W2.
+  struct VertMetricsRange {
+    uint16_t first_cid;
+    uint16_t last_cid;
+    int width;
+    int origin_x;
+    int origin_y;
+  };
+
   CPDF_CIDFont(CPDF_Document* pDocument, RetainPtr<CPDF_Dictionary> pFontDict);
 
   void LoadGB2312();
   int GetGlyphIndex(uint32_t unicodeb, bool* pVertGlyph);
   int GetVerticalGlyph(int index, bool* pVertGlyph);
   void LoadSubstFont();
+  void LoadWidths(RetainPtr<const CPDF_Array> widths);
+  void LoadVertMetrics(RetainPtr<const CPDF_Array> vert_metrics);
   wchar_t GetUnicodeFromCharCode(uint32_t charcode) const;
+  const WidthRange* FindWidthRange(uint16_t cid) const;
+  const VertMetricsRange* FindVertMetricsRange(uint16_t cid) const;
 
   RetainPtr<const CPDF_CMap> cmap_;
   UnownedPtr<const CPDF_CID2UnicodeMap> cid2unicode_map_;
   RetainPtr<CPDF_StreamAcc> stream_acc_;
-  std::unique_ptr<CFX_CTTGSUBTable> ttg_subtable_;
+  RetainPtr<const CFX_CTTGSUBTable> ttg_subtable_;
+  bool ttg_subtable_loaded_ = false;
   CIDFontType font_type_ = CIDFontType::kTrueType;
   bool cid_is_gid_ = false;
   bool ansi_widths_fixed_ = false;
@@ -99,8 +120,9 @@ class CPDF_CIDFont final : public CPDF_Font {
   int16_t default_width_ = 1000;
   int16_t default_vy_ = 880;
   int16_t default_w1_ = -1000;
-  std::vector<int> width_list_;
-  std::vector<int> vert_metrics_;
+  // Sorted and disjoint, for binary searches.
+  std::vector<WidthRange> width_ranges_;
+  std::vector<VertMetricsRange> vert_metrics_ranges_;
   std::array<FX_RECT, 256> char_bbox_;
 };
 
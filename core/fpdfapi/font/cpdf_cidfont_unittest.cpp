@@ -11,6 +11,7 @@
 #include "core/fpdfapi/parser/cpdf_dictionary.h"
 #include "core/fpdfapi/parser/cpdf_document.h"
 #include "core/fpdfapi/parser/cpdf_name.h"
+#include "core/fpdfapi/parser/cpdf_number.h"
 #include "core/fpdfapi/parser/cpdf_test_document.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
@@ -50,3 +51,57 @@ TEST_F(CPDFCIDFontTest, Bug920636) {
               font->GlyphFromCharCode(test_case.charcode, nullptr));
   }
 }
+
+TEST_F(CPDFCIDFontTest, OverlappingWidths) {
+  CPDF_TestDocument doc;
+  auto font_dict = pdfium::MakeRetain<CPDF_Dictionary>();
+  font_dict->SetNewFor<CPDF_Name>("Encoding", "Identity-H");
+
+  {
+    auto descendant_fonts = pdfium::MakeRetain<CPDF_Array>();
+    {
+      auto descendant_font = pdfium::MakeRetain<CPDF_Dictionary>();
+      descendant_font->SetNewFor<CPDF_Name>("BaseFont", "CourierStd");
+      descendant_font->SetNewFor<CPDF_Number>("DW", 300);
+      // [10 20 600] [15 [700 710]] [5 12 800] [30 [900]]
+      auto widths = descendant_font->SetNewFor<CPDF_Array>("W");
+      widths->AppendNew<CPDF_Number>(10);
+      widths->AppendNew<CPDF_Number>(20);
+      widths->AppendNew<CPDF_Number>(600);
+      widths->AppendNew<CPDF_Number>(15);
+      {
+        auto list = widths->AppendNew<CPDF_Array>();
+        list->AppendNew<CPDF_Number>(700);
+        list->AppendNew<CPDF_Number>(710);
+      }
+      widths->AppendNew<CPDF_Number>(5);
+      widths->AppendNew<CPDF_Number>(12);
+      widths->AppendNew<CPDF_Number>(800);
+      widths->AppendNew<CPDF_Number>(30);
+      {
+        auto list = widths->AppendNew<CPDF_Array>();
+        list->AppendNew<CPDF_Number>(900);
+      }
+      descendant_fonts->Append(std::move(descendant_font));
+    }
+    font_dict->SetFor("DescendantFonts", std::move(descendant_fonts));
+  }
+
+  auto font = pdfium::MakeRetain<CPDF_CIDFont>(&doc, std::move(font_dict));
+  ASSERT_TRUE(font->Load());
+
+  // Where ranges overlap, the first one listed wins.
+  struct {
+    uint32_t charcode;
+    int width;
+  } static constexpr kTestCases[] = {
+      {4, 300},  {5, 800},  {9, 800},  {10, 600}, {12, 600},
+      {15, 600}, {20, 600}, {21, 300}, {29, 300}, {30, 900},
+      {31, 300}, {0, 300},  {65535, 300},
+  };
+
+  for (const auto& test_case : kTestCases) {
+    EXPECT_EQ(test_case.width, font->GetCharWidthF(test_case.charcode))
+        << test_case.charcode;
+  }
+}
@@ -281,6 +281,12 @@ CPDF_CMap::CPDF_CMap(ByteStringView bsPredefinedName)
     return;
   }
 
+  embed_map_cids_ =
+      FixedSizeDataVector<uint16_t>::Uninit(kDirectMapTableSize);
+  pdfium::span<uint16_t> cids = embed_map_cids_.span();
+  for (uint32_t code = 0; code < cids.size(); ++code) {
+    cids[code] = fxcmap::CIDFromCharCode(embed_map_, code);
+  }
   loaded_ = true;
 }
 
@@ -306,7 +312,10 @@ uint16_t CPDF_CMap::CIDFromCharCode(uint32_t charcode) const {
   }
 
   if (embed_map_) {
-    return fxcmap::CIDFromCharCode(embed_map_, charcode);
+    pdfium::span<const uint16_t> cids = embed_map_cids_.span();
+    return charcode < cids.size()
+               ? cids[charcode]
+               : fxcmap::CIDFromCharCode(embed_map_, charcode);
   }
 
   if (direct_charcode_to_cidtable_.empty()) {
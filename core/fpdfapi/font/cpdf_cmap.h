@@ -100,6 +100,9 @@ class CPDF_CMap final : public Retainable {
   FixedSizeDataVector<uint16_t> direct_charcode_to_cidtable_;
   std::vector<CIDRange> additional_charcode_to_cidmappings_;
   UnownedPtr<const fxcmap::CMap> embed_map_;
+  // The CIDs of `embed_map_` for all 16-bit char codes. Predefined CMaps are
+  // shared by all documents, so searching `embed_map_` once pays off.
+  FixedSizeDataVector<uint16_t> embed_map_cids_;
 };
 
 #endif  // CORE_FPDFAPI_FONT_CPDF_CMAP_H_
@@ -12,12 +12,15 @@
 #include "core/fpdfapi/cmaps/GB1/cmaps_gb1.h"
 #include "core/fpdfapi/cmaps/Japan1/cmaps_japan1.h"
 #include "core/fpdfapi/cmaps/Korea1/cmaps_korea1.h"
+#include "core/fpdfapi/font/cfx_cttgsubtable.h"
 #include "core/fpdfapi/font/cfx_stockfontarray.h"
 #include "core/fpdfapi/font/cpdf_cid2unicodemap.h"
 #include "core/fpdfapi/font/cpdf_cmap.h"
 #include "core/fpdfapi/parser/cpdf_document.h"
 #include "core/fxcrt/check.h"
 #include "core/fxcrt/containers/contains.h"
+#include "core/fxcrt/fixed_size_data_vector.h"
+#include "core/fxge/cfx_face.h"
 
 namespace {
 
@@ -133,3 +136,38 @@ CPDF_CID2UnicodeMap* CPDF_FontGlobals::GetCID2UnicodeMap(CIDSet charset) {
   }
   return cid2unicode_maps_[charset].get();
 }
+
+RetainPtr<const CFX_CTTGSUBTable> CPDF_FontGlobals::GetGSUBTable(
+    RetainPtr<CFX_Face> face) {
+  auto it = gsub_tables_.find(face.Get());
+  if (it != gsub_tables_.end() && it->second.face) {
+    return it->second.table;
+  }
+
+  // Drop the entries of faces that are gone.
+  std::erase_if(gsub_tables_,
+                [](const auto& item) { return !item.second.face; });
+
+  GSUBTableEntry& entry = gsub_tables_[face.Get()];
+  entry.face.Reset(face.Get());
+  static constexpr uint32_t kGsubTag =
+      CFX_FontMapper::MakeTag('G', 'S', 'U', 'B');
+  size_t length = face->GetSfntTable(kGsubTag, {});
+  if (!length) {
+    return nullptr;
+  }
+
+  auto sub_data = FixedSizeDataVector<uint8_t>::Uninit(length);
+  if (!face->GetSfntTable(kGsubTag, sub_data.span())) {
+    return nullptr;
+  }
+
+  // CFX_CTTGSUBTable parses the data and stores all the values in its structs.
+  // It does not store pointers into `sub_data`.
+  entry.table = pdfium::MakeRetain<CFX_CTTGSUBTable>(sub_data.span());
+  return entry.table;
+}
+
+CPDF_FontGlobals::GSUBTableEntry::GSUBTableEntry() = default;
+
+CPDF_FontGlobals::GSUBTableEntry::~GSUBTableEntry() = default;
@@ -14,11 +14,14 @@
 
 #include "core/fpdfapi/cmaps/fpdf_cmaps.h"
 #include "core/fpdfapi/font/cpdf_cidfont.h"
+#include "core/fxcrt/observed_ptr.h"
 #include "core/fxcrt/raw_span.h"
 #include "core/fxcrt/retain_ptr.h"
 #include "core/fxcrt/span.h"
 #include "core/fxge/cfx_fontmapper.h"
 
+class CFX_CTTGSUBTable;
+class CFX_Face;
 class CFX_StockFontArray;
 class CPDF_Font;
 
@@ -55,7 +58,21 @@ class CPDF_FontGlobals {
   RetainPtr<const CPDF_CMap> GetPredefinedCMap(const ByteString& name);
   CPDF_CID2UnicodeMap* GetCID2UnicodeMap(CIDSet charset);
 
+  // Returns the GSUB table of `face`, loading it on first use, or nullptr if
+  // `face` has none. Fonts using the same face, in any document, share it.
+  RetainPtr<const CFX_CTTGSUBTable> GetGSUBTable(RetainPtr<CFX_Face> face);
+
  private:
+  struct GSUBTableEntry {
+    GSUBTableEntry();
+    ~GSUBTableEntry();
+
+    // Keys may outlive their faces, so entries are only valid while they
+    // still observe their key.
+    ObservedPtr<CFX_Face> face;
+    RetainPtr<const CFX_CTTGSUBTable> table;
+  };
+
   CPDF_FontGlobals();
   ~CPDF_FontGlobals();
 
@@ -75,6 +92,7 @@ class CPDF_FontGlobals {
            std::unique_ptr<CFX_StockFontArray>,
            std::less<>>
       stock_map_;
+  std::map<const CFX_Face*, GSUBTableEntry> gsub_tables_;
 };
 
 #endif  // CORE_FPDFAPI_FONT_CPDF_FONTGLOBALS_H_
@@ -6,7 +6,9 @@
 
 #include "core/fpdfapi/font/cpdf_tounicodemap.h"
 
+#include <algorithm>
 #include <set>
+#include <tuple>
 #include <utility>
 #include <variant>
 
@@ -15,9 +17,11 @@
 #include "core/fpdfapi/parser/cpdf_simple_parser.h"
 #include "core/fpdfapi/parser/cpdf_stream.h"
 #include "core/fpdfapi/parser/fpdf_parser_utility.h"
+#include "core/fxcrt/check.h"
 #include "core/fxcrt/containers/contains.h"
 #include "core/fxcrt/fx_extension.h"
 #include "core/fxcrt/fx_safe_types.h"
+#include "core/fxcrt/numerics/safe_conversions.h"
 
 namespace {
 
@@ -56,8 +60,8 @@ CPDF_ToUnicodeMap::CPDF_ToUnicodeMap(RetainPtr<const CPDF_Stream> pStream) {
 CPDF_ToUnicodeMap::~CPDF_ToUnicodeMap() = default;
 
 WideString CPDF_ToUnicodeMap::Lookup(uint32_t charcode) const {
-  auto it = multimap_.find(charcode);
-  if (it == multimap_.end()) {
+  std::optional<uint32_t> found = FindValue(charcode);
+  if (!found.has_value()) {
     if (!base_map_) {
       return WideString();
     }
@@ -65,7 +69,7 @@ WideString CPDF_ToUnicodeMap::Lookup(uint32_t charcode) const {
         base_map_->UnicodeFromCID(static_cast<uint16_t>(charcode)));
   }
 
-  uint32_t value = *it->second.begin();
+  uint32_t value = found.value();
   wchar_t unicode = static_cast<wchar_t>(value & 0xffff);
   if (unicode != 0xffff) {
     return WideString(unicode);
@@ -76,18 +80,21 @@ WideString CPDF_ToUnicodeMap::Lookup(uint32_t charcode) const {
 }
 
 uint32_t CPDF_ToUnicodeMap::ReverseLookup(wchar_t unicode) const {
-  for (const auto& pair : multimap_) {
-    if (pdfium::Contains(pair.second, static_cast<uint32_t>(unicode))) {
-      return pair.first;
-    }
-  }
-  return 0;
+  // The first entry for a value has its smallest code.
+  const uint32_t value = static_cast<uint32_t>(unicode);
+  auto it = std::lower_bound(
+      value_codes_.begin(), value_codes_.end(), value,
+      [](const ValueCode& entry, uint32_t value) {
+        return entry.value < value;
+      });
+  return it != value_codes_.end() && it->value == value ? it->code : 0;
 }
 
 size_t CPDF_ToUnicodeMap::GetUnicodeCountByCharcodeForTesting(
     uint32_t charcode) const {
-  auto it = multimap_.find(charcode);
-  return it != multimap_.end() ? it->second.size() : 0u;
+  return std::count_if(
+      value_codes_.begin(), value_codes_.end(),
+      [charcode](const ValueCode& entry) { return entry.code == charcode; });
 }
 
 // static
@@ -189,6 +196,7 @@ void CPDF_ToUnicodeMap::Load(RetainPtr<const CPDF_Stream> pStream) {
   if (cid_set != CIDSET_UNKNOWN) {
     base_map_ = CPDF_FontGlobals::GetInstance()->GetCID2UnicodeMap(cid_set);
   }
+  CompileLookups();
 }
 
 ByteStringView CPDF_ToUnicodeMap::HandleBeginBFChar(
@@ -404,3 +412,47 @@ void CPDF_ToUnicodeMap::InsertIntoMultimap(uint32_t code, uint32_t destcode) {
 
   it->second.emplace(destcode);
 }
+
+void CPDF_ToUnicodeMap::CompileLookups() {
+  size_t value_count = 0;
+  for (const auto& [code, values] : multimap_) {
+    // All codes were checked against `kCidLimit` when parsed.
+    CHECK_LE(code, kCidLimit);
+    uint16_t& page_index = code_page_indices_[code >> 8];
+    if (page_index == 0) {
+      code_pages_.emplace_back();
+      page_index = pdfium::checked_cast<uint16_t>(code_pages_.size());
+    }
+    CodePage& page = code_pages_[page_index - 1];
+    page.values[code & 0xff] = *values.begin();
+    page.mapped.set(code & 0xff);
+    value_count += values.size();
+  }
+
+  value_codes_.reserve(value_count);
+  for (const auto& [code, values] : multimap_) {
+    for (uint32_t value : values) {
+      value_codes_.push_back({value, code});
+    }
+  }
+  std::sort(value_codes_.begin(), value_codes_.end(),
+            [](const ValueCode& a, const ValueCode& b) {
+              return std::tie(a.value, a.code) < std::tie(b.value, b.code);
+            });
+  multimap_.clear();
+}
+
+std::optional<uint32_t> CPDF_ToUnicodeMap::FindValue(uint32_t charcode) const {
+  if (charcode > kCidLimit) {
+    return std::nullopt;
+  }
+  const uint16_t page_index = code_page_indices_[charcode >> 8];
+  if (page_index == 0) {
+    return std::nullopt;
+  }
+  const CodePage& page = code_pages_[page_index - 1];
+  if (!page.mapped.test(charcode & 0xff)) {
+    return std::nullopt;
+  }
+  return page.values[charcode & 0xff];
+}
@@ -7,6 +7,10 @@
 #ifndef CORE_FPDFAPI_FONT_CPDF_TOUNICODEMAP_H_
 #define CORE_FPDFAPI_FONT_CPDF_TOUNICODEMAP_H_
 
+#include <stdint.h>
+
+#include <array>
+#include <bitset>
 #include <map>
 #include <optional>
 #include <set>
@@ -53,7 +57,32 @@ class CPDF_ToUnicodeMap {
   // before.
   void InsertIntoMultimap(uint32_t code, uint32_t destcode);
 
+  // Builds the lookup tables below from `multimap_`, which is then released.
+  void CompileLookups();
+
+  // Returns the smallest value mapped to `charcode`, if any.
+  std::optional<uint32_t> FindValue(uint32_t charcode) const;
+
+  // The values of the codes of one 256 code page.
+  struct CodePage {
+    std::array<uint32_t, 256> values;
+    std::bitset<256> mapped;
+  };
+
+  // A value mapped to a code.
+  struct ValueCode {
+    uint32_t value;
+    uint32_t code;
+  };
+
+  // Only used while loading.
   std::map<uint32_t, std::set<uint32_t>> multimap_;
+  // Codes fit in 16 bits. Maps their high byte to 1 + the index of their page
+  // in `code_pages_`, or 0 if they have no page.
+  std::array<uint16_t, 256> code_page_indices_ = {};
+  std::vector<CodePage> code_pages_;
+  // All the values of all the codes, sorted by value, then by code.
+  std::vector<ValueCode> value_codes_;
   UnownedPtr<const CPDF_CID2UnicodeMap> base_map_;
   std::vector<WideString> multi_char_vec_;
 };
@@ -360,3 +360,27 @@ TEST(CPDFToUnicodeMapTest, NonBmpUnicodeLookup) {
   EXPECT_EQ(0u, map.ReverseLookup(0x20676));
 #endif
 }
+
+TEST(CPDFToUnicodeMapTest, LookupAcrossCodePages) {
+  static constexpr uint8_t kInput[] =
+      "3 beginbfchar<0041><0061><1234><4e00><ffff><0062>endbfchar\n"
+      "2 beginbfrange<3100><3103><0030><0000><0000><0020>endbfrange\n"
+      "1 beginbfchar<0042><0061>endbfchar";
+  CPDF_ToUnicodeMap map(pdfium::MakeRetain<CPDF_Stream>(kInput));
+  EXPECT_EQ(L"a", map.Lookup(0x0041));
+  EXPECT_EQ(L"a", map.Lookup(0x0042));
+  EXPECT_EQ(L"\x4e00", map.Lookup(0x1234));
+  EXPECT_EQ(L"b", map.Lookup(0xffff));
+  EXPECT_EQ(L" ", map.Lookup(0x0000));
+  EXPECT_EQ(L"0", map.Lookup(0x3100));
+  EXPECT_EQ(L"3", map.Lookup(0x3103));
+  EXPECT_EQ(L"", map.Lookup(0x0043));
+  EXPECT_EQ(L"", map.Lookup(0x30ff));
+  EXPECT_EQ(L"", map.Lookup(0x10041));
+
+  // The smallest code wins.
+  EXPECT_EQ(0x41u, map.ReverseLookup(L'a'));
+  EXPECT_EQ(0x3102u, map.ReverseLookup(L'2'));
+  EXPECT_EQ(0xffffu, map.ReverseLookup(L'b'));
+  EXPECT_EQ(0u, map.ReverseLookup(L'c'));
+}
@@ -56,6 +56,11 @@ bool CPDF_PageObjectHolder::IsPage() const {
   return false;
 }
 
+void CPDF_PageObjectHolder::SetTextOnly() {
+  DCHECK_EQ(parse_state_, ParseState::kNotParsed);
+  text_only_ = true;
+}
+
 void CPDF_PageObjectHolder::StartParse(
     std::unique_ptr<CPDF_ContentParser> pParser) {
   DCHECK_EQ(parse_state_, ParseState::kNotParsed);
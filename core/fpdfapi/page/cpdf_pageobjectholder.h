@@ -80,6 +80,14 @@ class CPDF_PageObjectHolder {
   void ContinueParse(PauseIndicatorIface* pPause);
   ParseState GetParseState() const { return parse_state_; }
 
+  // In text-only mode, parsing only builds text objects, plus the form
+  // objects that contain them, and the state that positions and colors them.
+  // Path, image and shading objects are dropped and clipping is ignored, so
+  // the objects must not be written back to the content stream. Must be set
+  // before parsing.
+  void SetTextOnly();
+  bool IsTextOnly() const { return text_only_; }
+
   CPDF_Document* GetDocument() const { return document_; }
   RetainPtr<const CPDF_Dictionary> GetDict() const { return dict_; }
   RetainPtr<CPDF_Dictionary> GetMutableDict() { return dict_; }
@@ -153,6 +161,7 @@ class CPDF_PageObjectHolder {
 
  private:
   bool background_alpha_needed_ = false;
+  bool text_only_ = false;
   ParseState parse_state_ = ParseState::kNotParsed;
   RetainPtr<CPDF_Dictionary> const dict_;
   UnownedPtr<CPDF_Document> document_;
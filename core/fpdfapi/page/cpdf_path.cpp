@@ -6,6 +6,8 @@
 
 #include "core/fpdfapi/page/cpdf_path.h"
 
+#include "core/fxge/cfx_glyphoutline.h"
+
 CPDF_Path::CPDF_Path() = default;
 
 CPDF_Path::CPDF_Path(const CPDF_Path& that) = default;
@@ -45,6 +47,11 @@ void CPDF_Path::Append(const CFX_Path& path, const CFX_Matrix* pMatrix) {
   ref_.GetPrivateCopy()->Append(path, pMatrix);
 }
 
+void CPDF_Path::AppendGlyphOutline(const CFX_GlyphOutline& outline,
+                                   const CFX_Matrix& matrix) {
+  outline.AppendToPath(*ref_.GetPrivateCopy(), matrix);
+}
+
 void CPDF_Path::AppendFloatRect(const CFX_FloatRect& rect) {
   ref_.GetPrivateCopy()->AppendFloatRect(rect);
 }
@@ -12,6 +12,8 @@
 #include "core/fxcrt/shared_copy_on_write.h"
 #include "core/fxge/cfx_path.h"
 
+class CFX_GlyphOutline;
+
 class CPDF_Path {
  public:
   CPDF_Path();
@@ -33,6 +35,8 @@ class CPDF_Path {
   void Transform(const CFX_Matrix& matrix);
 
   void Append(const CFX_Path& path, const CFX_Matrix* pMatrix);
+  void AppendGlyphOutline(const CFX_GlyphOutline& outline,
+                          const CFX_Matrix& matrix);
   void AppendFloatRect(const CFX_FloatRect& rect);
   void AppendRect(float left, float bottom, float right, float top);
   void AppendPoint(const CFX_PointF& point, CFX_Path::Point::Type type);
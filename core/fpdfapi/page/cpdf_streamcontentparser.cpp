@@ -404,6 +404,7 @@ CPDF_StreamContentParser::CPDF_StreamContentParser(
                                                 pPageResources.Get())),
       object_holder_(pObjHolder),
       recursion_state_(recursion_state),
+      text_only_(pObjHolder->IsTextOnly()),
       bbox_(rcBBox),
       cur_states_(std::make_unique<CPDF_AllStates>()) {
   if (pmtContentToUser) {
@@ -691,6 +692,10 @@ void CPDF_StreamContentParser::Handle_BeginImage() {
       break;
     }
   }
+  if (text_only_) {
+    return;
+  }
+
   CPDF_ImageObject* pObj = AddImageFromStream(std::move(pStream), /*name=*/"");
   // Record the bounding box of this image, so rendering code can draw it
   // properly.
@@ -791,7 +796,7 @@ void CPDF_StreamContentParser::Handle_ExecuteXObject() {
     return;
   }
 
-  if (type == "Image") {
+  if (type == "Image" && !text_only_) {
     CPDF_ImageObject* pObj =
         pXObject->IsInline()
             ? AddImageFromStream(ToStream(pXObject->Clone()), name)
@@ -816,6 +821,9 @@ void CPDF_StreamContentParser::AddForm(RetainPtr<CPDF_Stream> pStream,
   status.mutable_text_state() = cur_states_->text_state();
   auto form = std::make_unique<CPDF_Form>(document_, page_resources_,
                                           std::move(pStream), resources_.Get());
+  if (text_only_) {
+    form->SetTextOnly();
+  }
   form->ParseContent(&status, nullptr, recursion_state_);
 
   CFX_Matrix matrix =
@@ -910,7 +918,7 @@ void CPDF_StreamContentParser::Handle_EndMarkedContent() {
 }
 
 void CPDF_StreamContentParser::Handle_EndText() {
-  if (clip_text_list_.empty()) {
+  if (text_only_ || clip_text_list_.empty()) {
     return;
   }
 
@@ -1153,6 +1161,10 @@ void CPDF_StreamContentParser::Handle_SetColorPS_Stroke() {
 }
 
 void CPDF_StreamContentParser::Handle_ShadeFill() {
+  if (text_only_) {
+    return;
+  }
+
   RetainPtr<CPDF_ShadingPattern> pShading = FindShading(GetString(0));
   if (!pShading) {
     return;
@@ -1346,7 +1358,7 @@ void CPDF_StreamContentParser::AddTextObject(
         pText->CalcPositionData(cur_states_->text_horz_scale());
     cur_states_->IncrementTextPositionX(position.x);
     cur_states_->IncrementTextPositionY(position.y);
-    if (TextRenderingModeIsClipMode(text_mode)) {
+    if (!text_only_ && TextRenderingModeIsClipMode(text_mode)) {
       clip_text_list_.push_back(pText->Clone());
     }
     object_holder_->AppendPageObject(std::move(pText));
@@ -1526,6 +1538,12 @@ void CPDF_StreamContentParser::Handle_Invalid() {}
 
 void CPDF_StreamContentParser::AddPathPoint(const CFX_PointF& point,
                                             CFX_Path::Point::Type type) {
+  // Without path or clip objects to build, only the current point matters.
+  if (text_only_) {
+    path_current_ = point;
+    return;
+  }
+
   // If the path point is the same move as the previous one and neither of them
   // closes the path, then just skip it.
   if (type == CFX_Path::Point::Type::kMove && !path_points_.empty() &&
@@ -215,6 +215,8 @@ class CPDF_StreamContentParser {
   RetainPtr<CPDF_Dictionary> const resources_;
   UnownedPtr<CPDF_PageObjectHolder> const object_holder_;
   UnownedPtr<CPDF_Form::RecursionState> const recursion_state_;
+  // Mirrors CPDF_PageObjectHolder::IsTextOnly() for `object_holder_`.
+  const bool text_only_;
   CFX_Matrix mt_content_to_user_;
   const CFX_FloatRect bbox_;
   uint32_t param_start_pos_ = 0;
@@ -45,6 +45,12 @@ class CPDF_Document : public Observable,
     virtual ~LinkListIface() = default;
   };
 
+  class TreeIndexCacheIface {
+   public:
+    // CPDF_Document merely helps manage the lifetime.
+    virtual ~TreeIndexCacheIface() = default;
+  };
+
   class PageDataIface {
    public:
     PageDataIface();
@@ -134,6 +140,13 @@ class CPDF_Document : public Observable,
     links_context_ = std::move(pContext);
   }
 
+  TreeIndexCacheIface* GetTreeIndexCache() const {
+    return tree_index_cache_.get();
+  }
+  void SetTreeIndexCache(std::unique_ptr<TreeIndexCacheIface> pCache) {
+    tree_index_cache_ = std::move(pCache);
+  }
+
   // Behaves like NewIndirect<CPDF_Stream>(dict), but keeps track of the object
   // number assigned to the newly created stream.
   RetainPtr<CPDF_Stream> CreateModifiedAPStream(
@@ -225,6 +238,7 @@ class CPDF_Document : public Observable,
   std::unique_ptr<PageDataIface> const doc_page_;
   std::unique_ptr<JBig2_DocumentContext> codec_context_;
   std::unique_ptr<LinkListIface> links_context_;
+  std::unique_ptr<TreeIndexCacheIface> tree_index_cache_;
   std::set<uint32_t> modified_apstream_ids_;
   std::vector<uint32_t> page_list_;  // Page number to page's dict objnum.
 
@@ -11,15 +11,15 @@
 #include "build/build_config.h"
 #include "core/fpdfapi/page/cpdf_pageobject.h"
 #include "core/fpdfapi/parser/cpdf_dictionary.h"
+#include "core/fpdfapi/render/cpdf_rendercontext.h"
 #include "core/fpdfapi/render/cpdf_renderoptions.h"
 #include "core/fxge/cfx_defaultrenderdevice.h"
 #include "core/fxge/cfx_renderdevice.h"
 #include "core/fxge/dib/cfx_dibitmap.h"
+#include "core/fxge/dib/cfx_dibitmappool.h"
 #include "core/fxge/dib/fx_dib.h"
 
-#if BUILDFLAG(IS_WIN)
-#include "core/fpdfapi/render/cpdf_rendercontext.h"
-#else
+#if !BUILDFLAG(IS_WIN)
 #include "core/fxcrt/notreached.h"
 #endif
 
@@ -65,11 +65,8 @@ CPDF_DeviceBuffer::CPDF_DeviceBuffer(CPDF_RenderContext* pContext,
                                      const CPDF_PageObject* pObj,
                                      int max_dpi)
     : device_(pDevice),
-#if BUILDFLAG(IS_WIN)
       context_(pContext),
-#endif
       object_(pObj),
-      bitmap_(pdfium::MakeRetain<CFX_DIBitmap>()),
       rect_(rect),
       matrix_(CalculateMatrix(pDevice, rect, max_dpi, kScaleDeviceBuffer)) {
 }
@@ -81,15 +78,17 @@ RetainPtr<CFX_DIBitmap> CPDF_DeviceBuffer::Initialize() {
       matrix_.TransformRect(CFX_FloatRect(rect_)).GetOuterRect();
   // TODO(crbug.com/355630557): Consider adding support for
   // `FXDIB_Format::kBgraPremul`
-  if (!bitmap_->Create(bitmap_rect.Width(), bitmap_rect.Height(),
-                       FXDIB_Format::kBgra)) {
-    return nullptr;
-  }
+  bitmap_ = context_->GetBitmapPool()->Acquire(
+      bitmap_rect.Width(), bitmap_rect.Height(), FXDIB_Format::kBgra,
+      CFX_DIBitmapPool::Contents::kZeroed);
   return bitmap_;
 }
 
 void CPDF_DeviceBuffer::OutputToDevice() {
-  if (device_->GetDeviceCaps(FXDC_RENDER_CAPS) & FXRC_GET_BITS) {
+  // Devices that can composite alpha images do not need the background either,
+  // even if they cannot read it back.
+  if (device_->GetDeviceCaps(FXDC_RENDER_CAPS) &
+      (FXRC_GET_BITS | FXRC_ALPHA_IMAGE)) {
     if (matrix_.a == 1.0f && matrix_.d == 1.0f) {
       device_->SetDIBits(bitmap_, rect_.left, rect_.top);
       return;
@@ -12,6 +12,7 @@
 #include <array>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "core/fpdfapi/font/cpdf_type3font.h"
 #include "core/fpdfapi/page/cpdf_dib.h"
@@ -46,14 +47,31 @@ CPDF_DocRenderData::~CPDF_DocRenderData() = default;
 RetainPtr<CPDF_Type3Cache> CPDF_DocRenderData::GetCachedType3(
     CPDF_Type3Font* font) {
   CHECK(font);
-  auto it = type3_face_map_.find(font);
-  if (it != type3_face_map_.end() && it->second) {
-    return pdfium::WrapRetain(it->second.Get());
+  Type3CacheEntry& entry = type3_face_map_[font];
+  if (!entry.cache || entry.cache->GetFont() != font) {
+    entry.cache = pdfium::MakeRetain<CPDF_Type3Cache>(font);
+  }
+  entry.last_use = ++type3_use_count_;
+
+  // Callers hold the cache while they use its bitmaps, so this is the first
+  // glyph of a text object, and a safe time to free bitmaps.
+  if (entry.cache->HasOneRef()) {
+    TrimType3Caches();
   }
+  return entry.cache;
+}
 
-  auto cache = pdfium::MakeRetain<CPDF_Type3Cache>(font);
-  type3_face_map_[font].Reset(cache.Get());
-  return cache;
+void CPDF_DocRenderData::SetMaxType3GlyphBytes(size_t max_bytes) {
+  max_type3_glyph_bytes_ = max_bytes;
+  TrimType3Caches();
+}
+
+size_t CPDF_DocRenderData::GetType3GlyphBytes() const {
+  size_t total = 0;
+  for (const auto& [font, entry] : type3_face_map_) {
+    total += entry.cache->GetGlyphBytes();
+  }
+  return total;
 }
 
 RetainPtr<CPDF_TransferFunc> CPDF_DocRenderData::GetTransferFunc(
@@ -69,6 +87,43 @@ RetainPtr<CPDF_TransferFunc> CPDF_DocRenderData::GetTransferFunc(
   return func;
 }
 
+void CPDF_DocRenderData::TrimType3Caches() {
+  size_t total = 0;
+  std::vector<Type3CacheEntry*> idle_entries;
+  for (auto it = type3_face_map_.begin(); it != type3_face_map_.end();) {
+    Type3CacheEntry& entry = it->second;
+    const bool idle = entry.cache->HasOneRef();
+    if (idle && !entry.cache->GetFont()) {
+      it = type3_face_map_.erase(it);
+      continue;
+    }
+    total += entry.cache->GetGlyphBytes();
+    if (idle) {
+      idle_entries.push_back(&entry);
+    }
+    ++it;
+  }
+  if (total <= max_type3_glyph_bytes_) {
+    return;
+  }
+
+  // Leave some room, so the next glyphs do not trim again right away.
+  const size_t target = max_type3_glyph_bytes_ / 4 * 3;
+  std::sort(idle_entries.begin(), idle_entries.end(),
+            [](const Type3CacheEntry* a, const Type3CacheEntry* b) {
+              return a->last_use < b->last_use;
+            });
+  for (Type3CacheEntry* entry : idle_entries) {
+    if (total <= target) {
+      break;
+    }
+    const size_t bytes = entry->cache->GetGlyphBytes();
+    const size_t excess = total - target;
+    entry->cache->TrimGlyphs(bytes > excess ? bytes - excess : 0);
+    total -= bytes - entry->cache->GetGlyphBytes();
+  }
+}
+
 #if BUILDFLAG(IS_WIN)
 CFX_PSFontTracker* CPDF_DocRenderData::GetPSFontTracker() {
   if (!psfont_tracker_) {
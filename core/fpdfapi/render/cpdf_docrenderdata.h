@@ -7,6 +7,9 @@
 #ifndef CORE_FPDFAPI_RENDER_CPDF_DOCRENDERDATA_H_
 #define CORE_FPDFAPI_RENDER_CPDF_DOCRENDERDATA_H_
 
+#include <stddef.h>
+#include <stdint.h>
+
 #include <functional>
 #include <map>
 
@@ -31,6 +34,9 @@ class CFX_PSFontTracker;
 
 class CPDF_DocRenderData : public CPDF_Document::RenderDataIface {
  public:
+  // The default budget for the pixel data of Type 3 glyph bitmaps.
+  static constexpr size_t kDefaultMaxType3GlyphBytes = 16 * 1024 * 1024;
+
   static CPDF_DocRenderData* FromDocument(const CPDF_Document* pDoc);
 
   CPDF_DocRenderData();
@@ -44,6 +50,11 @@ class CPDF_DocRenderData : public CPDF_Document::RenderDataIface {
   RetainPtr<CPDF_TransferFunc> GetTransferFunc(
       RetainPtr<const CPDF_Object> obj);
 
+  // Type 3 glyph bitmaps are kept across pages. Once they exceed
+  // `max_bytes`, the least recently used ones that are not in use are freed.
+  void SetMaxType3GlyphBytes(size_t max_bytes);
+  size_t GetType3GlyphBytes() const;
+
 #if BUILDFLAG(IS_WIN)
   CFX_PSFontTracker* GetPSFontTracker();
 #endif
@@ -54,8 +65,19 @@ class CPDF_DocRenderData : public CPDF_Document::RenderDataIface {
       RetainPtr<const CPDF_Object> pObj) const;
 
  private:
-  // TODO(tsepez): investigate this map outliving its font keys.
-  std::map<CPDF_Font*, ObservedPtr<CPDF_Type3Cache>> type3_face_map_;
+  struct Type3CacheEntry {
+    RetainPtr<CPDF_Type3Cache> cache;
+    uint64_t last_use = 0;
+  };
+
+  // Trims the caches no one else holds, least recently used first.
+  void TrimType3Caches();
+
+  // Keys may outlive their fonts, so entries are only valid if their cache
+  // still observes the key.
+  std::map<CPDF_Font*, Type3CacheEntry> type3_face_map_;
+  size_t max_type3_glyph_bytes_ = kDefaultMaxType3GlyphBytes;
+  uint64_t type3_use_count_ = 0;
   std::map<RetainPtr<const CPDF_Object>,
            ObservedPtr<CPDF_TransferFunc>,
            std::less<>>
@@ -41,6 +41,7 @@
 #include "core/fxge/cfx_path.h"
 #include "core/fxge/dib/cfx_dibbase.h"
 #include "core/fxge/dib/cfx_dibitmap.h"
+#include "core/fxge/dib/cfx_dibitmappool.h"
 #include "core/fxge/dib/cfx_imagestretcher.h"
 
 #if BUILDFLAG(IS_WIN)
@@ -266,9 +267,11 @@ RetainPtr<const CFX_DIBitmap> CPDF_ImageRenderer::CalculateDrawImage(
     RetainPtr<CFX_DIBBase> pDIBBase,
     const CFX_Matrix& mtNewMatrix,
     const FX_RECT& rect) const {
-  auto mask_bitmap = pdfium::MakeRetain<CFX_DIBitmap>();
-  if (!mask_bitmap->Create(rect.Width(), rect.Height(),
-                           FXDIB_Format::k8bppRgb)) {
+  RetainPtr<CFX_DIBitmap> mask_bitmap =
+      render_status_->GetContext()->GetBitmapPool()->Acquire(
+          rect.Width(), rect.Height(), FXDIB_Format::k8bppRgb,
+          CFX_DIBitmapPool::Contents::kZeroed);
+  if (!mask_bitmap) {
     return nullptr;
   }
 
@@ -336,7 +339,11 @@ bool CPDF_ImageRenderer::DrawPatternImage() {
 
   CFX_Matrix new_matrix = GetDrawMatrix(rect);
   CFX_DefaultRenderDevice bitmap_device;
-  if (!bitmap_device.Create(rect.Width(), rect.Height(), FXDIB_Format::kBgra)) {
+  RetainPtr<CFX_DIBitmap> bitmap =
+      render_status_->GetContext()->GetBitmapPool()->Acquire(
+          rect.Width(), rect.Height(), FXDIB_Format::kBgra,
+          CFX_DIBitmapPool::Contents::kZeroed);
+  if (!bitmap || !bitmap_device.Attach(std::move(bitmap))) {
     return true;
   }
 
@@ -384,7 +391,11 @@ bool CPDF_ImageRenderer::DrawMaskedImage() {
 
   CFX_Matrix new_matrix = GetDrawMatrix(rect);
   CFX_DefaultRenderDevice bitmap_device;
-  if (!bitmap_device.Create(rect.Width(), rect.Height(), FXDIB_Format::kBgrx)) {
+  RetainPtr<CFX_DIBitmap> bitmap =
+      render_status_->GetContext()->GetBitmapPool()->Acquire(
+          rect.Width(), rect.Height(), FXDIB_Format::kBgrx,
+          CFX_DIBitmapPool::Contents::kUninitialized);
+  if (!bitmap || !bitmap_device.Attach(std::move(bitmap))) {
     return true;
   }
   bitmap_device.Clear(0xffffffff);
@@ -17,6 +17,7 @@
 #include "core/fxcrt/check.h"
 #include "core/fxcrt/pauseindicator_iface.h"
 #include "core/fxge/cfx_renderdevice.h"
+#include "core/fxge/dib/cfx_dibitmappool.h"
 
 CPDF_ProgressiveRenderer::CPDF_ProgressiveRenderer(
     CPDF_RenderContext* pContext,
@@ -44,6 +45,14 @@ void CPDF_ProgressiveRenderer::Start(PauseIndicatorIface* pPause) {
 }
 
 void CPDF_ProgressiveRenderer::Continue(PauseIndicatorIface* pPause) {
+  ContinueRendering(pPause);
+
+  // Whether the render is done or paused, the context stays idle until the
+  // embedder calls again, so do not hold on to scratch bitmaps until then.
+  context_->GetBitmapPool()->Trim();
+}
+
+void CPDF_ProgressiveRenderer::ContinueRendering(PauseIndicatorIface* pPause) {
   while (status_ == kToBeContinued) {
     if (!current_layer_) {
       if (layer_index_ >= context_->CountLayers()) {
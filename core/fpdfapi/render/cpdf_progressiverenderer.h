@@ -46,6 +46,8 @@ class CPDF_ProgressiveRenderer {
   // Maximum page objects to render before checking for pause.
   static constexpr int kStepLimit = 100;
 
+  void ContinueRendering(PauseIndicatorIface* pPause);
+
   Status status_ = kReady;
   UnownedPtr<CPDF_RenderContext> const context_;
   UnownedPtr<CFX_RenderDevice> const device_;
@@ -13,6 +13,7 @@
 #include "core/fxcrt/fx_coordinates.h"
 #include "core/fxcrt/retain_ptr.h"
 #include "core/fxcrt/unowned_ptr.h"
+#include "core/fxge/dib/cfx_dibitmappool.h"
 
 class CFX_DIBitmap;
 class CFX_Matrix;
@@ -75,11 +76,17 @@ class CPDF_RenderContext {
   }
   CPDF_PageImageCache* GetPageCache() const { return page_cache_; }
 
+  // Scratch bitmaps for groups, masks and other intermediates are recycled
+  // through this pool while rendering. CPDF_ProgressiveRenderer trims it
+  // whenever it finishes or pauses.
+  CFX_DIBitmapPool* GetBitmapPool() { return &bitmap_pool_; }
+
  private:
   UnownedPtr<CPDF_Document> const document_;
   RetainPtr<CPDF_Dictionary> const page_resources_;
   UnownedPtr<CPDF_PageImageCache> const page_cache_;
   std::vector<Layer> layers_;
+  CFX_DIBitmapPool bitmap_pool_;
 };
 
 #endif  // CORE_FPDFAPI_RENDER_CPDF_RENDERCONTEXT_H_
@@ -31,6 +31,7 @@ class CPDF_RenderOptions {
     bool bRectAA = false;
     bool bBreakForMasks = false;
     bool bNoTextSmooth = false;
+    bool bSubpixelText = false;
     bool bNoPathSmooth = false;
     bool bNoImageSmooth = false;
     bool bLimitedImageCache = false;
@@ -11,6 +11,7 @@
 #include <algorithm>
 #include <memory>
 #include <numeric>
+#include <optional>
 #include <set>
 #include <utility>
 #include <vector>
@@ -55,7 +56,6 @@
 #include "core/fxcrt/compiler_specific.h"
 #include "core/fxcrt/containers/contains.h"
 #include "core/fxcrt/data_vector.h"
-#include "core/fxcrt/fx_2d_size.h"
 #include "core/fxcrt/fx_safe_types.h"
 #include "core/fxcrt/fx_system.h"
 #include "core/fxcrt/notreached.h"
@@ -66,8 +66,10 @@
 #include "core/fxge/cfx_defaultrenderdevice.h"
 #include "core/fxge/cfx_fillrenderoptions.h"
 #include "core/fxge/cfx_glyphbitmap.h"
+#include "core/fxge/cfx_glyphoutline.h"
 #include "core/fxge/cfx_path.h"
 #include "core/fxge/dib/cfx_dibitmap.h"
+#include "core/fxge/dib/cfx_dibitmappool.h"
 #include "core/fxge/fx_font.h"
 #include "core/fxge/renderdevicedriver_iface.h"
 #include "core/fxge/text_char_pos.h"
@@ -143,6 +145,55 @@ FXDIB_Format GetFormatForLuminosity(bool is_luminosity) {
 #endif
 }
 
+// Returns the device-space area that the soft mask group form with
+// |group_dict| can paint into, or nothing if the group has no /BBox.
+std::optional<FX_RECT> GetSMaskGroupRect(const CPDF_Dictionary* group_dict,
+                                         const CFX_Matrix& smask_matrix) {
+  if (!group_dict->KeyExist("BBox")) {
+    return std::nullopt;
+  }
+
+  const CFX_Matrix form_matrix =
+      group_dict->GetMatrixFor("Matrix") * smask_matrix;
+  CFX_FloatRect rect =
+      form_matrix.TransformRect(group_dict->GetRectFor("BBox"));
+  // Pad by a pixel so anti-aliased edges of the /BBox clip stay inside.
+  rect.Inflate(1.0f, 1.0f);
+  return rect.GetOuterRect();
+}
+
+DataVector<uint8_t> GetSMaskTransfers(const CPDF_Function* pFunc) {
+  DataVector<uint8_t> transfers(256);
+  if (pFunc) {
+    std::vector<float> results(pFunc->OutputCount());
+    for (size_t i = 0; i < transfers.size(); ++i) {
+      float input = i / 255.0f;
+      pFunc->Call(pdfium::span_from_ref(input), results);
+      transfers[i] = FXSYS_roundf(results[0] * 255);
+    }
+  } else {
+    // Fill |transfers| with 0, 1, ... N.
+    std::iota(transfers.begin(), transfers.end(), 0);
+  }
+  return transfers;
+}
+
+std::unique_ptr<CPDF_Function> LoadSMaskTransferFunc(
+    const CPDF_Dictionary* smask_dict) {
+  RetainPtr<const CPDF_Object> pFuncObj =
+      smask_dict->GetDirectObjectFor(pdfium::transparency::kTR);
+  if (!pFuncObj || (!pFuncObj->IsDictionary() && !pFuncObj->IsStream())) {
+    return nullptr;
+  }
+  return CPDF_Function::Load(std::move(pFuncObj));
+}
+
+// Returns the gray level of the soft mask backdrop |color|, as seen by the
+// luminosity computation in CPDF_RenderStatus::LoadSMask().
+uint8_t GetSMaskBackdropGray(FX_ARGB color) {
+  return FXRGB2GRAY(FXARGB_R(color), FXARGB_G(color), FXARGB_B(color));
+}
+
 bool IsAvailableMatrix(const CFX_Matrix& matrix) {
   if (matrix.a == 0 || matrix.d == 0) {
     return matrix.b != 0 && matrix.c != 0;
@@ -175,6 +226,21 @@ bool Type3CharMissingStrokeColor(const CPDF_Type3Char* pChar,
 
 }  // namespace
 
+struct CPDF_RenderStatus::SMask {
+  // Returns the mask value where the group does not paint.
+  uint8_t GetBackdropValue() const {
+    return transfers[GetSMaskBackdropGray(background_color)];
+  }
+
+  RetainPtr<CPDF_Stream> group;
+  bool luminosity = false;
+  CPDF_ColorSpace::Family cs_family = CPDF_ColorSpace::Family::kUnknown;
+  FX_ARGB background_color = 0;
+  bool has_transfer_func = false;
+  // The /TR function, sampled at each 8-bit input.
+  DataVector<uint8_t> transfers;
+};
+
 CPDF_RenderStatus::CPDF_RenderStatus(CPDF_RenderContext* pContext,
                                      CFX_RenderDevice* pDevice)
     : context_(pContext), device_(pDevice) {}
@@ -664,24 +730,44 @@ bool CPDF_RenderStatus::ProcessTransparency(CPDF_PageObject* pPageObj,
 #endif
   FX_RECT rect = pPageObj->GetTransformedBBox(mtObj2Device);
   rect.Intersect(device_->GetClipBox());
+  std::optional<SMask> smask;
+  if (pSMaskDict) {
+    smask = ReadSMask(pSMaskDict.Get());
+  }
+  CFX_Matrix smask_matrix;
+  if (smask.has_value()) {
+    smask_matrix = *pPageObj->general_state().GetSMaskMatrix() * mtObj2Device;
+    std::optional<FX_RECT> smask_bounds =
+        GetSMaskBounds(smask.value(), smask_matrix);
+    if (smask_bounds.has_value()) {
+      rect.Intersect(smask_bounds.value());
+    }
+  }
   if (rect.IsEmpty()) {
     return true;
   }
 
   const int width = rect.Width();
   const int height = rect.Height();
+  CFX_DIBitmapPool* bitmap_pool = context_->GetBitmapPool();
   CFX_DefaultRenderDevice bitmap_device;
   RetainPtr<CFX_DIBitmap> backdrop;
   if (!transparency.IsIsolated() &&
       (device_->GetRenderCaps() & FXRC_GET_BITS)) {
-    backdrop = pdfium::MakeRetain<CFX_DIBitmap>();
-    if (!device_->CreateCompatibleBitmap(backdrop, width, height)) {
+    backdrop = bitmap_pool->Acquire(width, height,
+                                    device_->GetCompatibleBitmapFormat(),
+                                    CFX_DIBitmapPool::Contents::kZeroed);
+    if (!backdrop) {
       return true;
     }
     device_->GetDIBits(backdrop, rect.left, rect.top);
   }
-  if (!bitmap_device.CreateWithBackdrop(
-          width, height, GetCompatibleArgbFormat(), std::move(backdrop))) {
+  RetainPtr<CFX_DIBitmap> group_bitmap =
+      bitmap_pool->Acquire(width, height, GetCompatibleArgbFormat(),
+                           CFX_DIBitmapPool::Contents::kZeroed);
+  if (!group_bitmap || !bitmap_device.AttachWithBackdropAndGroupKnockout(
+                           std::move(group_bitmap), std::move(backdrop),
+                           /*bGroupKnockout=*/false)) {
     return true;
   }
 
@@ -690,8 +776,10 @@ bool CPDF_RenderStatus::ProcessTransparency(CPDF_PageObject* pPageObj,
 
   RetainPtr<CFX_DIBitmap> text_mask_bitmap;
   if (bTextClip) {
-    text_mask_bitmap = pdfium::MakeRetain<CFX_DIBitmap>();
-    if (!text_mask_bitmap->Create(width, height, FXDIB_Format::k8bppMask)) {
+    text_mask_bitmap =
+        bitmap_pool->Acquire(width, height, FXDIB_Format::k8bppMask,
+                             CFX_DIBitmapPool::Contents::kZeroed);
+    if (!text_mask_bitmap) {
       return true;
     }
 
@@ -722,11 +810,9 @@ bool CPDF_RenderStatus::ProcessTransparency(CPDF_PageObject* pPageObj,
   bitmap_render.Initialize(nullptr, nullptr);
   bitmap_render.ProcessObjectNoClip(pPageObj, new_matrix);
   stopped_ = bitmap_render.stopped_;
-  if (pSMaskDict) {
-    CFX_Matrix smask_matrix =
-        *pPageObj->general_state().GetSMaskMatrix() * mtObj2Device;
+  if (smask.has_value()) {
     RetainPtr<CFX_DIBitmap> smask_bitmap =
-        LoadSMask(pSMaskDict.Get(), rect, smask_matrix);
+        LoadSMask(smask.value(), rect, smask_matrix);
     if (smask_bitmap) {
       bitmap_device.MultiplyAlphaMask(std::move(smask_bitmap));
     }
@@ -761,22 +847,25 @@ RetainPtr<CFX_DIBitmap> CPDF_RenderStatus::GetBackdrop(
     bool bBackAlphaRequired) {
   int width = bbox.Width();
   int height = bbox.Height();
-  auto backdrop = pdfium::MakeRetain<CFX_DIBitmap>();
-  if (bBackAlphaRequired && !drop_objects_) {
-    // TODO(crbug.com/42271020): Consider adding support for
-    // `FXDIB_Format::kBgraPremul`
-    if (!backdrop->Create(width, height, FXDIB_Format::kBgra)) {
-      return nullptr;
-    }
-  } else {
-    if (!device_->CreateCompatibleBitmap(backdrop, width, height)) {
-      return nullptr;
-    }
+  // TODO(crbug.com/42271020): Consider adding support for
+  // `FXDIB_Format::kBgraPremul`
+  const FXDIB_Format format = bBackAlphaRequired && !drop_objects_
+                                  ? FXDIB_Format::kBgra
+                                  : device_->GetCompatibleBitmapFormat();
+  const int cap_to_check =
+      GetIsAlphaFromFormat(format) ? FXRC_ALPHA_OUTPUT : FXRC_GET_BITS;
+  const bool get_bits = !!(device_->GetRenderCaps() & cap_to_check);
+  // Only a non-alpha backdrop that is not read back gets fully cleared below.
+  const bool needs_zeroing = get_bits || GetIsAlphaFromFormat(format);
+  RetainPtr<CFX_DIBitmap> backdrop = context_->GetBitmapPool()->Acquire(
+      width, height, format,
+      needs_zeroing ? CFX_DIBitmapPool::Contents::kZeroed
+                    : CFX_DIBitmapPool::Contents::kUninitialized);
+  if (!backdrop) {
+    return nullptr;
   }
 
-  const int cap_to_check =
-      backdrop->IsAlphaFormat() ? FXRC_ALPHA_OUTPUT : FXRC_GET_BITS;
-  if (device_->GetRenderCaps() & cap_to_check) {
+  if (get_bits) {
     device_->GetDIBits(backdrop, bbox.left, bbox.top);
     return backdrop;
   }
@@ -1017,8 +1106,11 @@ bool CPDF_RenderStatus::ProcessType3Text(CPDF_TextObject* textobj,
         CFX_DefaultRenderDevice bitmap_device;
         // TODO(crbug.com/42271020): Consider adding support for
         // `FXDIB_Format::kBgraPremul`
-        if (!bitmap_device.Create(rect.Width(), rect.Height(),
-                                  FXDIB_Format::kBgra)) {
+        RetainPtr<CFX_DIBitmap> type3_bitmap =
+            context_->GetBitmapPool()->Acquire(
+                rect.Width(), rect.Height(), FXDIB_Format::kBgra,
+                CFX_DIBitmapPool::Contents::kZeroed);
+        if (!type3_bitmap || !bitmap_device.Attach(std::move(type3_bitmap))) {
           return true;
         }
         CPDF_RenderStatus status(context_, &bitmap_device);
@@ -1090,8 +1182,10 @@ bool CPDF_RenderStatus::ProcessType3Text(CPDF_TextObject* textobj,
   }
 
   FX_RECT rect = GetGlyphsBBox(glyphs, 0);
-  auto bitmap = pdfium::MakeRetain<CFX_DIBitmap>();
-  if (!bitmap->Create(rect.Width(), rect.Height(), FXDIB_Format::k8bppMask)) {
+  RetainPtr<CFX_DIBitmap> bitmap = context_->GetBitmapPool()->Acquire(
+      rect.Width(), rect.Height(), FXDIB_Format::k8bppMask,
+      CFX_DIBitmapPool::Contents::kZeroed);
+  if (!bitmap) {
     return true;
   }
 
@@ -1145,9 +1239,9 @@ void CPDF_RenderStatus::DrawTextPathWithPattern(const CPDF_TextObject* textobj,
     auto* font = charpos.fallback_font_position_ == -1
                      ? pFont->GetFont()
                      : pFont->GetFontFallback(charpos.fallback_font_position_);
-    const CFX_Path* pPath =
-        font->LoadGlyphPath(charpos.glyph_index_, charpos.font_char_width_);
-    if (!pPath) {
+    const CFX_GlyphOutline* outline = font->LoadGlyphOutline(
+        charpos.glyph_index_, charpos.font_char_width_);
+    if (!outline) {
       continue;
     }
 
@@ -1161,7 +1255,7 @@ void CPDF_RenderStatus::DrawTextPathWithPattern(const CPDF_TextObject* textobj,
     path.set_stroke(stroke);
     path.set_filltype(fill ? CFX_FillRenderOptions::FillType::kWinding
                            : CFX_FillRenderOptions::FillType::kNoFill);
-    path.path().Append(*pPath, &matrix);
+    path.path().AppendGlyphOutline(*outline, matrix);
     path.SetPathMatrix(CFX_Matrix());
     ProcessPath(&path, mtObj2Device);
   }
@@ -1408,9 +1502,10 @@ void CPDF_RenderStatus::CompositeDIBitmap(
                               false);
   }
 
-  auto new_backdrop = pdfium::MakeRetain<CFX_DIBitmap>();
-  CHECK(new_backdrop->Create(backdrop->GetWidth(), backdrop->GetHeight(),
-                             FXDIB_Format::kBgrx));
+  RetainPtr<CFX_DIBitmap> new_backdrop = context_->GetBitmapPool()->Acquire(
+      backdrop->GetWidth(), backdrop->GetHeight(), FXDIB_Format::kBgrx,
+      CFX_DIBitmapPool::Contents::kUninitialized);
+  CHECK(new_backdrop);
   new_backdrop->Clear(0xffffffff);
   new_backdrop->CompositeBitmap(0, 0, new_backdrop->GetWidth(),
                                 new_backdrop->GetHeight(), std::move(backdrop),
@@ -1418,107 +1513,135 @@ void CPDF_RenderStatus::CompositeDIBitmap(
   device_->SetDIBits(std::move(new_backdrop), bbox.left, bbox.top);
 }
 
+std::optional<CPDF_RenderStatus::SMask> CPDF_RenderStatus::ReadSMask(
+    CPDF_Dictionary* smask_dict) {
+  SMask smask;
+  smask.group = smask_dict->GetMutableStreamFor(pdfium::transparency::kG);
+  if (!smask.group) {
+    return std::nullopt;
+  }
+
+  smask.luminosity =
+      smask_dict->GetByteStringFor(pdfium::transparency::kSoftMaskSubType) !=
+      pdfium::transparency::kAlpha;
+  smask.background_color =
+      smask.luminosity ? GetBackgroundColor(smask_dict,
+                                            smask.group->GetDict().Get(),
+                                            &smask.cs_family)
+                       : 0;
+  std::unique_ptr<CPDF_Function> pFunc = LoadSMaskTransferFunc(smask_dict);
+  smask.has_transfer_func = !!pFunc;
+  smask.transfers = GetSMaskTransfers(pFunc.get());
+  return smask;
+}
+
+std::optional<FX_RECT> CPDF_RenderStatus::GetSMaskBounds(
+    const SMask& smask,
+    const CFX_Matrix& smask_matrix) {
+  std::optional<FX_RECT> group_rect =
+      GetSMaskGroupRect(smask.group->GetDict().Get(), smask_matrix);
+  if (!group_rect.has_value()) {
+    return std::nullopt;
+  }
+
+  // Outside of the group, the mask takes the value of the backdrop. Only when
+  // that is fully transparent can the group bounds limit what gets painted.
+  if (smask.GetBackdropValue() != 0) {
+    return std::nullopt;
+  }
+  return group_rect;
+}
+
 RetainPtr<CFX_DIBitmap> CPDF_RenderStatus::LoadSMask(
-    CPDF_Dictionary* smask_dict,
+    const SMask& smask,
     const FX_RECT& clip_rect,
     const CFX_Matrix& smask_matrix) {
-  RetainPtr<CPDF_Stream> pGroup =
-      smask_dict->GetMutableStreamFor(pdfium::transparency::kG);
-  if (!pGroup) {
+  // Only evaluate the mask where the group can paint. Elsewhere, it takes the
+  // transferred value of the backdrop.
+  FX_RECT group_rect = clip_rect;
+  std::optional<FX_RECT> bbox_rect =
+      GetSMaskGroupRect(smask.group->GetDict().Get(), smask_matrix);
+  if (bbox_rect.has_value()) {
+    group_rect.Intersect(bbox_rect.value());
+  }
+  const uint8_t outside_value =
+      group_rect != clip_rect ? smask.GetBackdropValue() : 0;
+  CFX_DIBitmapPool* bitmap_pool = context_->GetBitmapPool();
+  RetainPtr<CFX_DIBitmap> result_mask = bitmap_pool->Acquire(
+      clip_rect.Width(), clip_rect.Height(), FXDIB_Format::k8bppMask,
+      group_rect == clip_rect || outside_value != 0
+          ? CFX_DIBitmapPool::Contents::kUninitialized
+          : CFX_DIBitmapPool::Contents::kZeroed);
+  if (!result_mask) {
     return nullptr;
   }
-
-  std::unique_ptr<CPDF_Function> pFunc;
-  RetainPtr<const CPDF_Object> pFuncObj =
-      smask_dict->GetDirectObjectFor(pdfium::transparency::kTR);
-  if (pFuncObj && (pFuncObj->IsDictionary() || pFuncObj->IsStream())) {
-    pFunc = CPDF_Function::Load(std::move(pFuncObj));
+  if (outside_value != 0) {
+    result_mask->Clear(static_cast<uint32_t>(outside_value) << 24);
+  }
+  if (group_rect.IsEmpty()) {
+    return result_mask;
   }
 
   CFX_Matrix matrix = smask_matrix;
-  matrix.Translate(-clip_rect.left, -clip_rect.top);
+  matrix.Translate(-group_rect.left, -group_rect.top);
 
   CPDF_Form form(context_->GetDocument(), context_->GetMutablePageResources(),
-                 pGroup);
+                 smask.group);
   form.ParseContent();
 
   CFX_DefaultRenderDevice bitmap_device;
-  bool bLuminosity =
-      smask_dict->GetByteStringFor(pdfium::transparency::kSoftMaskSubType) !=
-      pdfium::transparency::kAlpha;
-  const int width = clip_rect.Width();
-  const int height = clip_rect.Height();
-  const FXDIB_Format format = GetFormatForLuminosity(bLuminosity);
-  if (!bitmap_device.Create(width, height, format)) {
+  const int width = group_rect.Width();
+  const int height = group_rect.Height();
+  RetainPtr<CFX_DIBitmap> group_bitmap = bitmap_pool->Acquire(
+      width, height, GetFormatForLuminosity(smask.luminosity),
+      CFX_DIBitmapPool::Contents::kUninitialized);
+  if (!group_bitmap || !bitmap_device.Attach(std::move(group_bitmap))) {
     return nullptr;
   }
 
-  CPDF_ColorSpace::Family nCSFamily = CPDF_ColorSpace::Family::kUnknown;
-  const FX_ARGB background_color =
-      bLuminosity
-          ? GetBackgroundColor(smask_dict, pGroup->GetDict().Get(), &nCSFamily)
-          : 0;
-  bitmap_device.Clear(background_color);
+  bitmap_device.Clear(smask.background_color);
 
   RetainPtr<const CPDF_Dictionary> pFormResource =
       form.GetDict()->GetDictFor("Resources");
   CPDF_RenderOptions options;
-  options.SetColorMode(bLuminosity ? CPDF_RenderOptions::kNormal
-                                   : CPDF_RenderOptions::kAlpha);
+  options.SetColorMode(smask.luminosity ? CPDF_RenderOptions::kNormal
+                                         : CPDF_RenderOptions::kAlpha);
   CPDF_RenderStatus status(context_, &bitmap_device);
   status.SetOptions(options);
-  status.SetGroupFamily(nCSFamily);
-  status.SetLoadMask(bLuminosity);
+  status.SetGroupFamily(smask.cs_family);
+  status.SetLoadMask(smask.luminosity);
   status.SetStdCS(true);
   status.SetFormResource(std::move(pFormResource));
   status.SetDropObjects(drop_objects_);
   status.Initialize(nullptr, nullptr);
   status.RenderObjectList(&form, matrix);
 
-  auto result_mask = pdfium::MakeRetain<CFX_DIBitmap>();
-  if (!result_mask->Create(width, height, FXDIB_Format::k8bppMask)) {
-    return nullptr;
-  }
-
-  pdfium::span<uint8_t> dest_buf = result_mask->GetWritableBuffer();
   RetainPtr<const CFX_DIBitmap> bitmap = bitmap_device.GetBitmap();
-  pdfium::span<const uint8_t> src_buf = bitmap->GetBuffer();
-  const int dest_pitch = result_mask->GetPitch();
-  const int src_pitch = bitmap->GetPitch();
-  DataVector<uint8_t> transfers(256);
-  if (pFunc) {
-    std::vector<float> results(pFunc->OutputCount());
-    for (size_t i = 0; i < transfers.size(); ++i) {
-      float input = i / 255.0f;
-      pFunc->Call(pdfium::span_from_ref(input), results);
-      transfers[i] = FXSYS_roundf(results[0] * 255);
-    }
-  } else {
-    // Fill |transfers| with 0, 1, ... N.
-    std::iota(transfers.begin(), transfers.end(), 0);
-  }
-  if (bLuminosity) {
-    const int bytes_per_pixel = bitmap->GetBPP() / 8;
-    for (int row = 0; row < height; row++) {
-      const size_t dest_offset = Fx2DSizeOrDie(row, dest_pitch);
-      const size_t src_offset = Fx2DSizeOrDie(row, src_pitch);
-      uint8_t* dest_pos = dest_buf.subspan(dest_offset).data();
-      const uint8_t* src_pos = src_buf.subspan(src_offset).data();
+  const int dest_left = group_rect.left - clip_rect.left;
+  const int dest_top = group_rect.top - clip_rect.top;
+  const int bytes_per_pixel = bitmap->GetBPP() / 8;
+  for (int row = 0; row < height; row++) {
+    pdfium::span<uint8_t> dest_scan =
+        result_mask->GetWritableScanline(dest_top + row)
+            .subspan(static_cast<size_t>(dest_left),
+                     static_cast<size_t>(width));
+    pdfium::span<const uint8_t> src_scan = bitmap->GetScanline(row);
+    if (smask.luminosity) {
+      const uint8_t* src_pos = src_scan.data();
       for (int col = 0; col < width; col++) {
         UNSAFE_TODO({
-          *dest_pos++ = transfers[FXRGB2GRAY(src_pos[2], src_pos[1], *src_pos)];
+          dest_scan[col] =
+              smask.transfers[FXRGB2GRAY(src_pos[2], src_pos[1], *src_pos)];
           src_pos += bytes_per_pixel;
         });
       }
+    } else if (smask.has_transfer_func) {
+      for (int col = 0; col < width; col++) {
+        dest_scan[col] = smask.transfers[src_scan[col]];
+      }
+    } else {
+      fxcrt::Copy(src_scan.first(static_cast<size_t>(width)), dest_scan);
     }
-  } else if (pFunc) {
-    int size = dest_pitch * height;
-    for (int i = 0; i < size; i++) {
-      dest_buf[i] = transfers[src_buf[i]];
-    }
-  } else {
-    fxcrt::Copy(src_buf.first(static_cast<size_t>(dest_pitch * height)),
-                dest_buf);
   }
   return result_mask;
 }
@@ -8,6 +8,7 @@
 #define CORE_FPDFAPI_RENDER_CPDF_RENDERSTATUS_H_
 
 #include <memory>
+#include <optional>
 #include <utility>
 #include <vector>
 
@@ -178,7 +179,16 @@ class CPDF_RenderStatus {
   RetainPtr<CFX_DIBitmap> GetBackdrop(const CPDF_PageObject* pObj,
                                       const FX_RECT& bbox,
                                       bool bBackAlphaRequired);
-  RetainPtr<CFX_DIBitmap> LoadSMask(CPDF_Dictionary* smask_dict,
+  // The parts of a soft mask dictionary that GetSMaskBounds() and LoadSMask()
+  // both need.
+  struct SMask;
+  // Returns nullopt if |smask_dict| has no group to render the mask from.
+  std::optional<SMask> ReadSMask(CPDF_Dictionary* smask_dict);
+  // Returns the device-space area outside of which |smask| is fully
+  // transparent, if the mask has such an area.
+  std::optional<FX_RECT> GetSMaskBounds(const SMask& smask,
+                                        const CFX_Matrix& smask_matrix);
+  RetainPtr<CFX_DIBitmap> LoadSMask(const SMask& smask,
                                     const FX_RECT& clip_rect,
                                     const CFX_Matrix& smask_matrix);
   // Optionally write the colorspace family value into |pCSFamily|.
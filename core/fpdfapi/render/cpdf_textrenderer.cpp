@@ -44,6 +44,10 @@ CFX_TextRenderOptions GetTextRenderOptionsHelper(
     text_options.native_text = false;
   }
 
+  if (options.GetOptions().bSubpixelText) {
+    text_options.subpixel_positioning = true;
+  }
+
   return text_options;
 }
 
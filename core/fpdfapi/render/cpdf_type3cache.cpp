@@ -8,8 +8,10 @@
 
 #include <math.h>
 
+#include <algorithm>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "core/fpdfapi/font/cpdf_type3char.h"
 #include "core/fpdfapi/font/cpdf_type3font.h"
@@ -79,45 +81,98 @@ int DetectLastScan(const RetainPtr<CFX_DIBitmap>& pBitmap) {
   return -1;
 }
 
+// The number of bits each matrix entry is quantized to, relative to the
+// largest one.
+constexpr int kSizeKeyBits = 10;
+
 }  // namespace
 
+// static
+CPDF_Type3Cache::SizeKey CPDF_Type3Cache::GetSizeKey(
+    const CFX_Matrix& matrix) {
+  const float scale = std::max({fabsf(matrix.a), fabsf(matrix.b),
+                                fabsf(matrix.c), fabsf(matrix.d)});
+  if (!isfinite(scale) || scale == 0) {
+    return {0, 0, 0, 0, 0};
+  }
+
+  int exponent;
+  frexpf(scale, &exponent);
+  auto quantize = [exponent](float value) {
+    return FXSYS_roundf(ldexpf(value, kSizeKeyBits - exponent));
+  };
+  return {exponent, quantize(matrix.a), quantize(matrix.b), quantize(matrix.c),
+          quantize(matrix.d)};
+}
+
 CPDF_Type3Cache::CPDF_Type3Cache(CPDF_Type3Font* pFont) : font_(pFont) {}
 
 CPDF_Type3Cache::~CPDF_Type3Cache() = default;
 
 const CFX_GlyphBitmap* CPDF_Type3Cache::LoadGlyph(uint32_t charcode,
                                                   const CFX_Matrix& mtMatrix) {
-  SizeKey keygen = {
-      FXSYS_roundf(mtMatrix.a * 10000),
-      FXSYS_roundf(mtMatrix.b * 10000),
-      FXSYS_roundf(mtMatrix.c * 10000),
-      FXSYS_roundf(mtMatrix.d * 10000),
-  };
-  CPDF_Type3GlyphMap* pSizeCache;
-  auto it = size_map_.find(keygen);
-  if (it == size_map_.end()) {
-    auto pNew = std::make_unique<CPDF_Type3GlyphMap>();
-    pSizeCache = pNew.get();
-    size_map_[keygen] = std::move(pNew);
-  } else {
-    pSizeCache = it->second.get();
-  }
-  const CFX_GlyphBitmap* pExisting = pSizeCache->GetBitmap(charcode);
+  std::unique_ptr<CPDF_Type3GlyphMap>& pSizeCache =
+      size_map_[GetSizeKey(mtMatrix)];
+  if (!pSizeCache) {
+    pSizeCache = std::make_unique<CPDF_Type3GlyphMap>();
+  }
+  const CFX_GlyphBitmap* pExisting =
+      pSizeCache->GetBitmap(charcode, ++use_count_);
   if (pExisting) {
     return pExisting;
   }
 
   std::unique_ptr<CFX_GlyphBitmap> pNewBitmap =
-      RenderGlyph(pSizeCache, charcode, mtMatrix);
+      RenderGlyph(pSizeCache.get(), charcode, mtMatrix);
   CFX_GlyphBitmap* pGlyphBitmap = pNewBitmap.get();
-  pSizeCache->SetBitmap(charcode, std::move(pNewBitmap));
+  glyph_bytes_ -= pSizeCache->GetBitmapBytes();
+  pSizeCache->SetBitmap(charcode, std::move(pNewBitmap), use_count_);
+  glyph_bytes_ += pSizeCache->GetBitmapBytes();
   return pGlyphBitmap;
 }
 
+void CPDF_Type3Cache::TrimGlyphs(size_t max_bytes) {
+  if (glyph_bytes_ <= max_bytes) {
+    return;
+  }
+
+  // Use counts are unique, so freeing up to the right use count frees just
+  // the least recently used bitmaps.
+  std::vector<std::pair<uint64_t, size_t>> uses;
+  for (const auto& [key, glyph_map] : size_map_) {
+    glyph_map->GetBitmapUses(&uses);
+  }
+  std::sort(uses.begin(), uses.end());
+  size_t remaining = glyph_bytes_;
+  uint64_t first_kept_use = use_count_ + 1;
+  for (const auto& [last_use, size] : uses) {
+    if (remaining <= max_bytes) {
+      first_kept_use = last_use;
+      break;
+    }
+    remaining -= size;
+  }
+
+  glyph_bytes_ = 0;
+  for (auto it = size_map_.begin(); it != size_map_.end();) {
+    it->second->RemoveBitmapsUsedBefore(first_kept_use);
+    if (it->second->IsEmpty()) {
+      it = size_map_.erase(it);
+      continue;
+    }
+    glyph_bytes_ += it->second->GetBitmapBytes();
+    ++it;
+  }
+}
+
 std::unique_ptr<CFX_GlyphBitmap> CPDF_Type3Cache::RenderGlyph(
     CPDF_Type3GlyphMap* pSize,
     uint32_t charcode,
     const CFX_Matrix& mtMatrix) {
+  if (!font_) {
+    return nullptr;
+  }
+
   CPDF_Type3Char* pChar = font_->LoadChar(charcode);
   if (!pChar) {
     return nullptr;
@@ -7,6 +7,7 @@
 #ifndef CORE_FPDFAPI_RENDER_CPDF_TYPE3CACHE_H_
 #define CORE_FPDFAPI_RENDER_CPDF_TYPE3CACHE_H_
 
+#include <stddef.h>
 #include <stdint.h>
 
 #include <map>
@@ -22,15 +23,32 @@ class CFX_Matrix;
 class CPDF_Type3Font;
 class CPDF_Type3GlyphMap;
 
+// Caches the rendered bitmaps of a Type 3 font's image glyphs. The parsed
+// glyph descriptions stay cached in the font itself.
 class CPDF_Type3Cache final : public Retainable, public Observable {
  public:
   CONSTRUCT_VIA_MAKE_RETAIN;
 
+  // Returns nullptr once the font is destroyed.
+  CPDF_Type3Font* GetFont() const { return font_.Get(); }
+
+  // Matrices that differ by less than about 1/1024 of their scale share
+  // bitmaps. The returned bitmap stays valid until TrimGlyphs() is called.
   const CFX_GlyphBitmap* LoadGlyph(uint32_t charcode,
                                    const CFX_Matrix& mtMatrix);
 
+  // Returns the size of the pixel data of all cached bitmaps.
+  size_t GetGlyphBytes() const { return glyph_bytes_; }
+
+  // Frees the least recently used bitmaps until at most `max_bytes` of pixel
+  // data remain. Must not be called while bitmaps from LoadGlyph() are in use.
+  void TrimGlyphs(size_t max_bytes);
+
  private:
-  using SizeKey = std::tuple<int, int, int, int>;
+  // The exponent of the matrix scale, then the quantized a, b, c and d.
+  using SizeKey = std::tuple<int, int, int, int, int>;
+
+  static SizeKey GetSizeKey(const CFX_Matrix& matrix);
 
   explicit CPDF_Type3Cache(CPDF_Type3Font* pFont);
   ~CPDF_Type3Cache() override;
@@ -39,8 +57,12 @@ class CPDF_Type3Cache final : public Retainable, public Observable {
                                                uint32_t charcode,
                                                const CFX_Matrix& mtMatrix);
 
-  RetainPtr<CPDF_Type3Font> const font_;
+  // Not retained, so that caches kept by CPDF_DocRenderData do not keep fonts
+  // alive.
+  ObservedPtr<CPDF_Type3Font> const font_;
   std::map<SizeKey, std::unique_ptr<CPDF_Type3GlyphMap>> size_map_;
+  size_t glyph_bytes_ = 0;
+  uint64_t use_count_ = 0;
 };
 
 #endif  // CORE_FPDFAPI_RENDER_CPDF_TYPE3CACHE_H_
@@ -13,6 +13,7 @@
 
 #include "core/fxcrt/fx_system.h"
 #include "core/fxge/cfx_glyphbitmap.h"
+#include "core/fxge/dib/cfx_dibitmap.h"
 #include "core/fxge/fx_font.h"
 
 namespace {
@@ -39,6 +40,14 @@ int AdjustBlueHelper(float pos, std::vector<int>* blues) {
   return new_pos;
 }
 
+size_t GetPixelDataSize(const CFX_GlyphBitmap* bitmap) {
+  if (!bitmap) {
+    return 0;
+  }
+  const RetainPtr<CFX_DIBitmap>& dib = bitmap->GetBitmap();
+  return static_cast<size_t>(dib->GetPitch()) * dib->GetHeight();
+}
+
 }  // namespace
 
 CPDF_Type3GlyphMap::CPDF_Type3GlyphMap() = default;
@@ -50,12 +59,41 @@ std::pair<int, int> CPDF_Type3GlyphMap::AdjustBlue(float top, float bottom) {
                         AdjustBlueHelper(bottom, &bottom_blue_));
 }
 
-const CFX_GlyphBitmap* CPDF_Type3GlyphMap::GetBitmap(uint32_t charcode) const {
+const CFX_GlyphBitmap* CPDF_Type3GlyphMap::GetBitmap(uint32_t charcode,
+                                                     uint64_t use_count) {
   auto it = glyph_map_.find(charcode);
-  return it != glyph_map_.end() ? it->second.get() : nullptr;
+  if (it == glyph_map_.end()) {
+    return nullptr;
+  }
+  it->second.last_use = use_count;
+  return it->second.bitmap.get();
 }
 
 void CPDF_Type3GlyphMap::SetBitmap(uint32_t charcode,
-                                   std::unique_ptr<CFX_GlyphBitmap> pMap) {
-  glyph_map_[charcode] = std::move(pMap);
+                                   std::unique_ptr<CFX_GlyphBitmap> pMap,
+                                   uint64_t use_count) {
+  CachedBitmap& cached = glyph_map_[charcode];
+  bitmap_bytes_ -= cached.size;
+  cached.size = GetPixelDataSize(pMap.get());
+  cached.bitmap = std::move(pMap);
+  cached.last_use = use_count;
+  bitmap_bytes_ += cached.size;
+}
+
+void CPDF_Type3GlyphMap::GetBitmapUses(
+    std::vector<std::pair<uint64_t, size_t>>* uses) const {
+  for (const auto& [charcode, cached] : glyph_map_) {
+    uses->emplace_back(cached.last_use, cached.size);
+  }
+}
+
+void CPDF_Type3GlyphMap::RemoveBitmapsUsedBefore(uint64_t use_count) {
+  for (auto it = glyph_map_.begin(); it != glyph_map_.end();) {
+    if (it->second.last_use < use_count) {
+      bitmap_bytes_ -= it->second.size;
+      it = glyph_map_.erase(it);
+    } else {
+      ++it;
+    }
+  }
 }
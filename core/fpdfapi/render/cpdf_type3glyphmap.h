@@ -7,6 +7,7 @@
 #ifndef CORE_FPDFAPI_RENDER_CPDF_TYPE3GLYPHMAP_H_
 #define CORE_FPDFAPI_RENDER_CPDF_TYPE3GLYPHMAP_H_
 
+#include <stddef.h>
 #include <stdint.h>
 
 #include <map>
@@ -24,13 +25,36 @@ class CPDF_Type3GlyphMap {
   // Returns a pair of integers (top_line, bottom_line).
   std::pair<int, int> AdjustBlue(float top, float bottom);
 
-  const CFX_GlyphBitmap* GetBitmap(uint32_t charcode) const;
-  void SetBitmap(uint32_t charcode, std::unique_ptr<CFX_GlyphBitmap> pMap);
+  // Returns the bitmap for `charcode`, or nullptr if there is none, and
+  // records it as used at `use_count`.
+  const CFX_GlyphBitmap* GetBitmap(uint32_t charcode, uint64_t use_count);
+  void SetBitmap(uint32_t charcode,
+                 std::unique_ptr<CFX_GlyphBitmap> pMap,
+                 uint64_t use_count);
+
+  // Appends the use counts at which each bitmap was last used, with the size
+  // of its pixel data, to `uses`.
+  void GetBitmapUses(std::vector<std::pair<uint64_t, size_t>>* uses) const;
+
+  // Frees the bitmaps last used before `use_count`.
+  void RemoveBitmapsUsedBefore(uint64_t use_count);
+
+  bool IsEmpty() const { return glyph_map_.empty(); }
+
+  // Returns the size of the pixel data of all bitmaps.
+  size_t GetBitmapBytes() const { return bitmap_bytes_; }
 
  private:
+  struct CachedBitmap {
+    std::unique_ptr<CFX_GlyphBitmap> bitmap;
+    size_t size = 0;
+    uint64_t last_use = 0;
+  };
+
   std::vector<int> top_blue_;
   std::vector<int> bottom_blue_;
-  std::map<uint32_t, std::unique_ptr<CFX_GlyphBitmap>> glyph_map_;
+  std::map<uint32_t, CachedBitmap> glyph_map_;
+  size_t bitmap_bytes_ = 0;
 };
 
 #endif  // CORE_FPDFAPI_RENDER_CPDF_TYPE3GLYPHMAP_H_
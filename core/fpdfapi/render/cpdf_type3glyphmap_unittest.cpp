@@ -0,0 +1,67 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fpdfapi/render/cpdf_type3glyphmap.h"
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "core/fxge/cfx_glyphbitmap.h"
+#include "core/fxge/dib/cfx_dibitmap.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+std::unique_ptr<CFX_GlyphBitmap> CreateGlyph(int width, int height) {
+  auto glyph = std::make_unique<CFX_GlyphBitmap>(0, 0);
+  EXPECT_TRUE(
+      glyph->GetBitmap()->Create(width, height, FXDIB_Format::k8bppMask));
+  return glyph;
+}
+
+}  // namespace
+
+TEST(CPDFType3GlyphMapTest, BitmapBytes) {
+  CPDF_Type3GlyphMap glyph_map;
+  EXPECT_TRUE(glyph_map.IsEmpty());
+  EXPECT_EQ(0u, glyph_map.GetBitmapBytes());
+
+  // Rows of 8bpp masks are padded to 4 bytes.
+  glyph_map.SetBitmap('a', CreateGlyph(10, 20), 1);
+  EXPECT_EQ(240u, glyph_map.GetBitmapBytes());
+  glyph_map.SetBitmap('b', CreateGlyph(4, 4), 2);
+  EXPECT_EQ(256u, glyph_map.GetBitmapBytes());
+
+  // Failed glyphs are remembered, but take no space.
+  glyph_map.SetBitmap('c', nullptr, 3);
+  EXPECT_EQ(256u, glyph_map.GetBitmapBytes());
+
+  glyph_map.SetBitmap('a', CreateGlyph(8, 8), 4);
+  EXPECT_EQ(80u, glyph_map.GetBitmapBytes());
+}
+
+TEST(CPDFType3GlyphMapTest, RemoveLeastRecentlyUsed) {
+  CPDF_Type3GlyphMap glyph_map;
+  glyph_map.SetBitmap('a', CreateGlyph(4, 1), 1);
+  glyph_map.SetBitmap('b', CreateGlyph(4, 2), 2);
+  glyph_map.SetBitmap('c', CreateGlyph(4, 3), 3);
+  ASSERT_TRUE(glyph_map.GetBitmap('a', 4));
+  EXPECT_FALSE(glyph_map.GetBitmap('d', 5));
+
+  std::vector<std::pair<uint64_t, size_t>> uses;
+  glyph_map.GetBitmapUses(&uses);
+  EXPECT_EQ((std::vector<std::pair<uint64_t, size_t>>{{4, 4}, {2, 8}, {3, 12}}),
+            uses);
+
+  glyph_map.RemoveBitmapsUsedBefore(4);
+  EXPECT_TRUE(glyph_map.GetBitmap('a', 6));
+  EXPECT_FALSE(glyph_map.GetBitmap('b', 7));
+  EXPECT_FALSE(glyph_map.GetBitmap('c', 8));
+  EXPECT_EQ(4u, glyph_map.GetBitmapBytes());
+
+  glyph_map.RemoveBitmapsUsedBefore(9);
+  EXPECT_TRUE(glyph_map.IsEmpty());
+  EXPECT_EQ(0u, glyph_map.GetBitmapBytes());
+}
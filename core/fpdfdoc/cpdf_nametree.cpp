@@ -6,6 +6,7 @@
 
 #include "core/fpdfdoc/cpdf_nametree.h"
 
+#include <algorithm>
 #include <set>
 #include <utility>
 #include <vector>
@@ -23,6 +24,8 @@
 
 namespace {
 
+using NameTreeEntry = CPDF_TreeIndexCache::NameTreeIndex::Entry;
+
 constexpr int kNameTreeMaxRecursion = 32;
 
 // The node where a new name should be inserted at `index`.
@@ -431,6 +434,57 @@ size_t CountNamesInternal(const CPDF_Dictionary* pNode,
   return nCount;
 }
 
+// Appends the names and values under `pNode` to `entries`, in tree order.
+// Returns false if the tree is not well-formed, in which case `entries` is
+// incomplete. Sanitizes the limits of the nodes like the searches do.
+bool AddNameNodeEntries(const RetainPtr<CPDF_Dictionary>& pNode,
+                        int nLevel,
+                        absl::flat_hash_set<const CPDF_Dictionary*>& seen,
+                        std::vector<NameTreeEntry>* entries) {
+  if (nLevel > kNameTreeMaxRecursion) {
+    return false;
+  }
+
+  const bool inserted = seen.insert(pNode.Get()).second;
+  if (!inserted) {
+    return false;
+  }
+
+  const size_t first_entry = entries->size();
+  RetainPtr<CPDF_Array> pNames = pNode->GetMutableArrayFor("Names");
+  RetainPtr<CPDF_Array> pKids = pNode->GetMutableArrayFor("Kids");
+  if (pNames) {
+    for (size_t i = 0; i < pNames->size() / 2; i++) {
+      WideString csName = pNames->GetUnicodeTextAt(i * 2);
+      if (!entries->empty() && csName.Compare(entries->back().key) <= 0) {
+        return false;
+      }
+      // Values resolve on lookup, so that indexing does not parse them all.
+      entries->push_back(
+          {std::move(csName), pNames->GetMutableObjectAt(i * 2 + 1)});
+    }
+  } else if (pKids) {
+    for (size_t i = 0; i < pKids->size(); i++) {
+      RetainPtr<CPDF_Dictionary> pKid = pKids->GetMutableDictAt(i);
+      if (pKid && !AddNameNodeEntries(pKid, nLevel + 1, seen, entries)) {
+        return false;
+      }
+    }
+  }
+
+  RetainPtr<CPDF_Array> pLimits = pNode->GetMutableArrayFor("Limits");
+  if (!pLimits) {
+    return true;
+  }
+
+  auto [csLeft, csRight] = GetNodeLimitsAndSanitize(pLimits.Get());
+  if (entries->size() == first_entry) {
+    return true;
+  }
+  return csLeft.Compare((*entries)[first_entry].key) <= 0 &&
+         csRight.Compare(entries->back().key) >= 0;
+}
+
 RetainPtr<const CPDF_Array> GetNamedDestFromObject(
     RetainPtr<const CPDF_Object> obj) {
   RetainPtr<const CPDF_Array> array = ToArray(obj);
@@ -456,9 +510,11 @@ RetainPtr<const CPDF_Array> LookupOldStyleNamedDest(CPDF_Document* pDoc,
 
 }  // namespace
 
-CPDF_NameTree::CPDF_NameTree(RetainPtr<CPDF_Dictionary> pRoot)
-    : root_(std::move(pRoot)) {
+CPDF_NameTree::CPDF_NameTree(RetainPtr<CPDF_Dictionary> pRoot,
+                             RetainPtr<Index> index)
+    : root_(std::move(pRoot)), index_(std::move(index)) {
   DCHECK(root_);
+  DCHECK(index_);
 }
 
 CPDF_NameTree::~CPDF_NameTree() = default;
@@ -482,8 +538,10 @@ std::unique_ptr<CPDF_NameTree> CPDF_NameTree::Create(
     return nullptr;
   }
 
-  return pdfium::WrapUnique(
-      new CPDF_NameTree(std::move(pCategory)));  // Private ctor.
+  RetainPtr<Index> index =
+      CPDF_TreeIndexCache::GetOrCreate(pDoc)->GetNameTreeIndex(pCategory);
+  return pdfium::WrapUnique(new CPDF_NameTree(
+      std::move(pCategory), std::move(index)));  // Private ctor.
 }
 
 // static
@@ -510,14 +568,18 @@ std::unique_ptr<CPDF_NameTree> CPDF_NameTree::CreateWithRootNameArray(
     pNames->SetNewFor<CPDF_Reference>(category, pDoc, pCategory->GetObjNum());
   }
 
-  return pdfium::WrapUnique(new CPDF_NameTree(pCategory));  // Private ctor.
+  RetainPtr<Index> index =
+      CPDF_TreeIndexCache::GetOrCreate(pDoc)->GetNameTreeIndex(pCategory);
+  return pdfium::WrapUnique(new CPDF_NameTree(
+      std::move(pCategory), std::move(index)));  // Private ctor.
 }
 
 // static
 std::unique_ptr<CPDF_NameTree> CPDF_NameTree::CreateForTesting(
     CPDF_Dictionary* pRoot) {
   return pdfium::WrapUnique(
-      new CPDF_NameTree(pdfium::WrapRetain(pRoot)));  // Private ctor.
+      new CPDF_NameTree(pdfium::WrapRetain(pRoot),
+                        pdfium::MakeRetain<Index>()));  // Private ctor.
 }
 
 // static
@@ -536,6 +598,11 @@ RetainPtr<const CPDF_Array> CPDF_NameTree::LookupNamedDest(
 }
 
 size_t CPDF_NameTree::GetCount() const {
+  const std::vector<Index::Entry>* entries = GetIndexEntries();
+  if (entries) {
+    return entries->size();
+  }
+
   absl::flat_hash_set<const CPDF_Dictionary*> seen;
   return CountNamesInternal(root_.Get(), 0, seen);
 }
@@ -573,6 +640,8 @@ bool CPDF_NameTree::AddValueAndName(RetainPtr<CPDF_Object> pObj,
     DCHECK(node_to_insert.names);
   }
 
+  index_->Invalidate();
+
   // Insert the name and the object into the leaf array found. Note that the
   // insertion position is right after the key-value pair returned by |index|.
   size_t nNameIndex = (node_to_insert.index + 1) * 2;
@@ -609,6 +678,8 @@ bool CPDF_NameTree::DeleteValueAndName(size_t nIndex) {
     return false;
   }
 
+  index_->Invalidate();
+
   // Remove the name and the object from the leaf array |pFind|.
   RetainPtr<CPDF_Array> pFind = result.value().container;
   pFind->RemoveAt(result.value().index + 1);
@@ -623,6 +694,23 @@ bool CPDF_NameTree::DeleteValueAndName(size_t nIndex) {
 RetainPtr<CPDF_Object> CPDF_NameTree::LookupValueAndName(
     size_t nIndex,
     WideString* csName) const {
+  const std::vector<Index::Entry>* entries = GetIndexEntries();
+  if (entries) {
+    RetainPtr<CPDF_Object> value;
+    if (nIndex < entries->size()) {
+      value = (*entries)[nIndex].value;
+    }
+    if (value) {
+      value = value->GetMutableDirect();
+    }
+    if (!value) {
+      csName->clear();
+      return nullptr;
+    }
+    *csName = (*entries)[nIndex].key;
+    return value;
+  }
+
   std::optional<IndexSearchResult> result =
       SearchNameNodeByIndex(root_.Get(), nIndex);
   if (!result) {
@@ -636,7 +724,20 @@ RetainPtr<CPDF_Object> CPDF_NameTree::LookupValueAndName(
 
 RetainPtr<const CPDF_Object> CPDF_NameTree::LookupValue(
     const WideString& csName) const {
-  return SearchNameNodeByName(root_, csName, nullptr);
+  const std::vector<Index::Entry>* entries = GetIndexEntries();
+  if (!entries) {
+    return SearchNameNodeByName(root_, csName, nullptr);
+  }
+
+  auto it = std::lower_bound(entries->begin(), entries->end(), csName,
+                             [](const Index::Entry& entry,
+                                const WideString& name) {
+                               return entry.key.Compare(name) < 0;
+                             });
+  if (it == entries->end() || it->key.Compare(csName) != 0 || !it->value) {
+    return nullptr;
+  }
+  return it->value->GetDirect();
 }
 
 RetainPtr<const CPDF_Array> CPDF_NameTree::LookupNewStyleNamedDest(
@@ -644,3 +745,17 @@ RetainPtr<const CPDF_Array> CPDF_NameTree::LookupNewStyleNamedDest(
   return GetNamedDestFromObject(
       LookupValue(PDF_DecodeText(sName.unsigned_span())));
 }
+
+const std::vector<CPDF_NameTree::Index::Entry>*
+CPDF_NameTree::GetIndexEntries() const {
+  if (!index_->IsBuilt()) {
+    std::vector<Index::Entry> entries;
+    absl::flat_hash_set<const CPDF_Dictionary*> seen;
+    if (AddNameNodeEntries(root_, 0, seen, &entries)) {
+      index_->SetEntries(std::move(entries));
+    } else {
+      index_->SetEntries(std::nullopt);
+    }
+  }
+  return index_->GetEntries();
+}
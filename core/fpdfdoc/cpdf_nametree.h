@@ -10,7 +10,9 @@
 #include <stddef.h>
 
 #include <memory>
+#include <vector>
 
+#include "core/fpdfdoc/cpdf_treeindexcache.h"
 #include "core/fxcrt/fx_string.h"
 #include "core/fxcrt/retain_ptr.h"
 
@@ -52,11 +54,18 @@ class CPDF_NameTree {
   CPDF_Dictionary* GetRootForTesting() const { return root_.Get(); }
 
  private:
-  explicit CPDF_NameTree(RetainPtr<CPDF_Dictionary> pRoot);
+  using Index = CPDF_TreeIndexCache::NameTreeIndex;
+
+  CPDF_NameTree(RetainPtr<CPDF_Dictionary> pRoot, RetainPtr<Index> index);
 
   RetainPtr<const CPDF_Array> LookupNewStyleNamedDest(const ByteString& name);
 
+  // Returns the entries of the tree sorted by name, indexing the tree on first
+  // use. Returns nullptr if the tree is not well-formed.
+  const std::vector<Index::Entry>* GetIndexEntries() const;
+
   RetainPtr<CPDF_Dictionary> const root_;
+  RetainPtr<Index> const index_;
 };
 
 #endif  // CORE_FPDFDOC_CPDF_NAMETREE_H_
@@ -384,3 +384,65 @@ TEST(CPDFNameTreeTest, DeleteFromKids) {
   EXPECT_FALSE(name_tree->LookupValueAndName(0, &csName));
   EXPECT_FALSE(name_tree->DeleteValueAndName(0));
 }
+
+TEST(CPDFNameTreeTest, LookupInLargeTree) {
+  // Set up a name tree with 10 leaves of 100 names each.
+  auto pRootDict = pdfium::MakeRetain<CPDF_Dictionary>();
+  auto pKids = pRootDict->SetNewFor<CPDF_Array>("Kids");
+  for (int i = 0; i < 10; ++i) {
+    auto pKid = pKids->AppendNew<CPDF_Dictionary>();
+    auto pNames = pKid->SetNewFor<CPDF_Array>("Names");
+    for (int j = 0; j < 100; ++j) {
+      const int value = i * 100 + j;
+      AddNameKeyValue(pNames.Get(), ByteString::Format("%04d", value).c_str(),
+                      value);
+    }
+    AddLimitsArray(pKid.Get(), ByteString::Format("%04d", i * 100).c_str(),
+                   ByteString::Format("%04d", i * 100 + 99).c_str());
+  }
+  std::unique_ptr<CPDF_NameTree> name_tree =
+      CPDF_NameTree::CreateForTesting(pRootDict.Get());
+
+  EXPECT_EQ(1000u, name_tree->GetCount());
+  for (int i = 0; i < 1000; i += 37) {
+    WideString name = WideString::Format(L"%04d", i);
+    RetainPtr<const CPDF_Object> value = name_tree->LookupValue(name);
+    ASSERT_TRUE(value);
+    EXPECT_EQ(i, value->GetInteger());
+
+    WideString stored_name;
+    RetainPtr<const CPDF_Object> indexed_value =
+        name_tree->LookupValueAndName(i, &stored_name);
+    EXPECT_EQ(value, indexed_value);
+    EXPECT_EQ(name, stored_name);
+  }
+  EXPECT_FALSE(name_tree->LookupValue(L"1000"));
+  EXPECT_FALSE(name_tree->LookupValue(L"0050.5"));
+
+  WideString stored_name = L"stale";
+  EXPECT_FALSE(name_tree->LookupValueAndName(1000, &stored_name));
+  EXPECT_TRUE(stored_name.IsEmpty());
+}
+
+TEST(CPDFNameTreeTest, LookupInUnsortedNames) {
+  // Set up a name tree with names out of order.
+  auto pRootDict = pdfium::MakeRetain<CPDF_Dictionary>();
+  auto pNames = pRootDict->SetNewFor<CPDF_Array>("Names");
+  AddNameKeyValue(pNames.Get(), "2.txt", 222);
+  AddNameKeyValue(pNames.Get(), "1.txt", 111);
+  AddNameKeyValue(pNames.Get(), "3.txt", 333);
+  std::unique_ptr<CPDF_NameTree> name_tree =
+      CPDF_NameTree::CreateForTesting(pRootDict.Get());
+
+  // Names are still found in tree order, but searching by name stops at the
+  // first name that is greater than the one looked for.
+  EXPECT_EQ(3u, name_tree->GetCount());
+  WideString stored_name;
+  ASSERT_TRUE(name_tree->LookupValueAndName(1, &stored_name));
+  EXPECT_EQ(L"1.txt", stored_name);
+  ASSERT_TRUE(name_tree->LookupValue(L"2.txt"));
+  EXPECT_EQ(222, name_tree->LookupValue(L"2.txt")->GetInteger());
+  ASSERT_TRUE(name_tree->LookupValue(L"3.txt"));
+  EXPECT_EQ(333, name_tree->LookupValue(L"3.txt")->GetInteger());
+  EXPECT_FALSE(name_tree->LookupValue(L"1.txt"));
+}
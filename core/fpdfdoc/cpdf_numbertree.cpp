@@ -6,14 +6,20 @@
 
 #include "core/fpdfdoc/cpdf_numbertree.h"
 
+#include <algorithm>
 #include <optional>
 #include <utility>
 
 #include "core/fpdfapi/parser/cpdf_array.h"
 #include "core/fpdfapi/parser/cpdf_dictionary.h"
+#include "third_party/abseil-cpp/absl/container/flat_hash_set.h"
 
 namespace {
 
+using NumberTreeEntry = CPDF_TreeIndexCache::NumberTreeIndex::Entry;
+
+constexpr int kNumberTreeMaxRecursion = 32;
+
 RetainPtr<const CPDF_Object> FindNumberNode(const CPDF_Dictionary* node_dict,
                                             int num) {
   RetainPtr<const CPDF_Array> limits_array = node_dict->GetArrayFor("Limits");
@@ -103,20 +109,119 @@ std::optional<CPDF_NumberTree::KeyValue> FindLowerBound(
   return std::nullopt;
 }
 
+// Appends the keys and values under `node_dict` to `entries`, in tree order.
+// Returns false if the tree is not well-formed, in which case `entries` is
+// incomplete. Since the searches above trust the /Limits of the nodes, the
+// limits of a well-formed tree must be exactly the node's smallest and largest
+// keys.
+bool AddNumberNodeEntries(const CPDF_Dictionary* node_dict,
+                          int level,
+                          absl::flat_hash_set<const CPDF_Dictionary*>& seen,
+                          std::vector<NumberTreeEntry>* entries) {
+  if (level > kNumberTreeMaxRecursion) {
+    return false;
+  }
+
+  const bool inserted = seen.insert(node_dict).second;
+  if (!inserted) {
+    return false;
+  }
+
+  const size_t first_entry = entries->size();
+  RetainPtr<const CPDF_Array> numbers_array = node_dict->GetArrayFor("Nums");
+  RetainPtr<const CPDF_Array> kids_array = node_dict->GetArrayFor("Kids");
+  if (numbers_array) {
+    for (size_t i = 0; i < numbers_array->size() / 2; i++) {
+      const int key = numbers_array->GetIntegerAt(i * 2);
+      if (!entries->empty() && key <= entries->back().key) {
+        return false;
+      }
+      // Values resolve on lookup, so that indexing does not parse them all.
+      entries->push_back({key, numbers_array->GetObjectAt(i * 2 + 1)});
+    }
+  } else if (kids_array) {
+    for (size_t i = 0; i < kids_array->size(); i++) {
+      RetainPtr<const CPDF_Dictionary> kid_dict = kids_array->GetDictAt(i);
+      if (kid_dict &&
+          !AddNumberNodeEntries(kid_dict.Get(), level + 1, seen, entries)) {
+        return false;
+      }
+    }
+  }
+
+  RetainPtr<const CPDF_Array> limits_array = node_dict->GetArrayFor("Limits");
+  if (!limits_array) {
+    return true;
+  }
+  return entries->size() > first_entry &&
+         limits_array->GetIntegerAt(0) == (*entries)[first_entry].key &&
+         limits_array->GetIntegerAt(1) == entries->back().key;
+}
+
+RetainPtr<const CPDF_Object> GetDirectValue(const NumberTreeEntry& entry) {
+  return entry.value ? entry.value->GetDirect() : nullptr;
+}
+
 }  // namespace
 
 CPDF_NumberTree::CPDF_NumberTree(RetainPtr<const CPDF_Dictionary> root)
     : root_(std::move(root)) {}
 
+CPDF_NumberTree::CPDF_NumberTree(CPDF_Document* doc,
+                                 RetainPtr<const CPDF_Dictionary> root)
+    : root_(std::move(root)),
+      index_(CPDF_TreeIndexCache::GetOrCreate(doc)->GetNumberTreeIndex(root_)) {
+}
+
 CPDF_NumberTree::~CPDF_NumberTree() = default;
 
 RetainPtr<const CPDF_Object> CPDF_NumberTree::LookupValue(int num) const {
-  return FindNumberNode(root_.Get(), num);
+  const std::vector<Index::Entry>* entries = GetIndexEntries();
+  if (!entries) {
+    return FindNumberNode(root_.Get(), num);
+  }
+
+  auto it = std::lower_bound(
+      entries->begin(), entries->end(), num,
+      [](const Index::Entry& entry, int key) { return entry.key < key; });
+  if (it == entries->end() || it->key != num) {
+    return nullptr;
+  }
+  return GetDirectValue(*it);
 }
 
 std::optional<CPDF_NumberTree::KeyValue> CPDF_NumberTree::GetLowerBound(
     int num) const {
-  return FindLowerBound(root_.Get(), num);
+  const std::vector<Index::Entry>* entries = GetIndexEntries();
+  if (!entries) {
+    return FindLowerBound(root_.Get(), num);
+  }
+
+  auto it = std::upper_bound(
+      entries->begin(), entries->end(), num,
+      [](int key, const Index::Entry& entry) { return key < entry.key; });
+  if (it == entries->begin()) {
+    return std::nullopt;
+  }
+  --it;
+  return KeyValue(it->key, GetDirectValue(*it));
+}
+
+const std::vector<CPDF_NumberTree::Index::Entry>*
+CPDF_NumberTree::GetIndexEntries() const {
+  if (!index_) {
+    return nullptr;
+  }
+  if (!index_->IsBuilt()) {
+    std::vector<Index::Entry> entries;
+    absl::flat_hash_set<const CPDF_Dictionary*> seen;
+    if (AddNumberNodeEntries(root_.Get(), 0, seen, &entries)) {
+      index_->SetEntries(std::move(entries));
+    } else {
+      index_->SetEntries(std::nullopt);
+    }
+  }
+  return index_->GetEntries();
 }
 
 CPDF_NumberTree::KeyValue::KeyValue(int key, RetainPtr<const CPDF_Object> value)
@@ -8,10 +8,13 @@
 #define CORE_FPDFDOC_CPDF_NUMBERTREE_H_
 
 #include <optional>
+#include <vector>
 
+#include "core/fpdfdoc/cpdf_treeindexcache.h"
 #include "core/fxcrt/retain_ptr.h"
 
 class CPDF_Dictionary;
+class CPDF_Document;
 class CPDF_Object;
 
 // Represents a number tree that allows for sub-linear lookups of tree nodes.
@@ -31,6 +34,11 @@ class CPDF_NumberTree {
   };
 
   explicit CPDF_NumberTree(RetainPtr<const CPDF_Dictionary> root);
+
+  // Same as above, but looks up values in an index of the tree, built on first
+  // use and shared with the other CPDF_NumberTree instances for `root` in
+  // `doc`. Worthwhile when the tree is searched more than a few times.
+  CPDF_NumberTree(CPDF_Document* doc, RetainPtr<const CPDF_Dictionary> root);
   ~CPDF_NumberTree();
 
   // Finds the object in the number tree whose key is `num`. Returns nullptr in
@@ -45,7 +53,14 @@ class CPDF_NumberTree {
   std::optional<KeyValue> GetLowerBound(int num) const;
 
  protected:
+  using Index = CPDF_TreeIndexCache::NumberTreeIndex;
+
+  // Returns the entries of the tree sorted by key, indexing the tree on first
+  // use. Returns nullptr if there is no index, or the tree is not well-formed.
+  const std::vector<Index::Entry>* GetIndexEntries() const;
+
   RetainPtr<const CPDF_Dictionary> const root_;
+  RetainPtr<Index> const index_;
 };
 
 #endif  // CORE_FPDFDOC_CPDF_NUMBERTREE_H_
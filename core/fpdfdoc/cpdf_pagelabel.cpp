@@ -112,7 +112,7 @@ std::optional<WideString> CPDF_PageLabel::GetLabel(int page_index) const {
     return std::nullopt;
   }
 
-  CPDF_NumberTree number_tree(std::move(labels_dict));
+  CPDF_NumberTree number_tree(doc_.get(), std::move(labels_dict));
   RetainPtr<const CPDF_Object> label_value;
   std::optional<CPDF_NumberTree::KeyValue> lower_bound =
       number_tree.GetLowerBound(page_index);
@@ -28,14 +28,12 @@ CPDF_StructElement::CPDF_StructElement(const CPDF_StructTree* pTree,
                                        RetainPtr<const CPDF_Dictionary> pDict)
     : tree_(pTree),
       dict_(std::move(pDict)),
-      type_(tree_->GetRoleMapNameFor(dict_->GetNameFor("S"))) {
-  LoadKids();
-}
+      type_(tree_->GetRoleMapNameFor(dict_->GetNameFor("S"))) {}
 
 CPDF_StructElement::~CPDF_StructElement() {
   for (auto& kid : kids_) {
     if (kid.type_ == Kid::kElement && kid.element_) {
-      kid.element_->SetParent(nullptr);
+      kid.element_->parent_element_ = nullptr;
     }
   }
 }
@@ -80,35 +78,42 @@ RetainPtr<const CPDF_Object> CPDF_StructElement::GetK() const {
   return dict_->GetObjectFor("K");
 }
 
-size_t CPDF_StructElement::CountKids() const {
+size_t CPDF_StructElement::CountKids() {
+  LoadKidsIfNeeded();
   return kids_.size();
 }
 
-CPDF_StructElement* CPDF_StructElement::GetKidIfElement(size_t index) const {
+CPDF_StructElement* CPDF_StructElement::GetKidIfElement(size_t index) {
+  LoadKidsIfNeeded();
   return kids_[index].type_ == Kid::kElement ? kids_[index].element_.Get()
                                              : nullptr;
 }
 
-int CPDF_StructElement::GetKidContentId(size_t index) const {
+int CPDF_StructElement::GetKidContentId(size_t index) {
+  LoadKidsIfNeeded();
   return kids_[index].type_ == Kid::kStreamContent ||
                  kids_[index].type_ == Kid::kPageContent
              ? kids_[index].content_id_
              : -1;
 }
 
-bool CPDF_StructElement::UpdateKidIfElement(const CPDF_Dictionary* pDict,
-                                            CPDF_StructElement* pElement) {
-  bool bSave = false;
-  for (auto& kid : kids_) {
-    if (kid.type_ == Kid::kElement && kid.dict_ == pDict) {
-      kid.element_.Reset(pElement);
-      bSave = true;
+CPDF_StructElement* CPDF_StructElement::GetParent() {
+  if (!parent_loaded_) {
+    parent_loaded_ = true;
+    CPDF_StructElement* parent = tree_->FindElement(dict_->GetDictFor("P"));
+    if (parent) {
+      parent->LoadKidsIfNeeded();
     }
   }
-  return bSave;
+  return parent_element_;
 }
 
-void CPDF_StructElement::LoadKids() {
+void CPDF_StructElement::LoadKidsIfNeeded() {
+  if (kids_loaded_) {
+    return;
+  }
+
+  kids_loaded_ = true;
   RetainPtr<const CPDF_Object> pObj = dict_->GetObjectFor("Pg");
   const CPDF_Reference* pRef = ToReference(pObj.Get());
   const uint32_t page_obj_num = pRef ? pRef->GetRefObjNum() : 0;
@@ -184,4 +189,9 @@ void CPDF_StructElement::LoadKid(uint32_t page_obj_num,
 
   kid.type_ = Kid::kElement;
   kid.dict_.Reset(pKidDict);
+  CPDF_StructElement* element = tree_->FindElement(kid.dict_);
+  if (element && element->dict_->GetDictFor("P") == dict_) {
+    kid.element_.Reset(element);
+    element->parent_element_ = this;
+  }
 }
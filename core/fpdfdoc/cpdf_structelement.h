@@ -32,16 +32,13 @@ class CPDF_StructElement final : public Retainable {
   RetainPtr<const CPDF_Object> GetA() const;
   RetainPtr<const CPDF_Object> GetK() const;
 
-  size_t CountKids() const;
-  CPDF_StructElement* GetKidIfElement(size_t index) const;
-  int GetKidContentId(size_t index) const;
-  bool UpdateKidIfElement(const CPDF_Dictionary* pDict,
-                          CPDF_StructElement* pElement);
+  // Kids load on first use. Kids that are elements are only set if the tree
+  // loaded them, and if their /P entry is this element.
+  size_t CountKids();
+  CPDF_StructElement* GetKidIfElement(size_t index);
+  int GetKidContentId(size_t index);
 
-  CPDF_StructElement* GetParent() const { return parent_element_; }
-  void SetParent(CPDF_StructElement* pParentElement) {
-    parent_element_ = pParentElement;
-  }
+  CPDF_StructElement* GetParent();
 
  private:
   struct Kid {
@@ -63,15 +60,18 @@ class CPDF_StructElement final : public Retainable {
                      RetainPtr<const CPDF_Dictionary> pDict);
   ~CPDF_StructElement() override;
 
-  void LoadKids();
+  void LoadKidsIfNeeded();
   void LoadKid(uint32_t page_obj_num,
                RetainPtr<const CPDF_Object> pKidObj,
                Kid& kid);
 
   UnownedPtr<const CPDF_StructTree> const tree_;
   RetainPtr<const CPDF_Dictionary> const dict_;
+  // Set when the parent loads its kids.
   UnownedPtr<CPDF_StructElement> parent_element_;
   const ByteString type_;
+  bool kids_loaded_ = false;
+  bool parent_loaded_ = false;
   std::vector<Kid> kids_;
 };
 
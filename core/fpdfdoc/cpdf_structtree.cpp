@@ -90,58 +90,65 @@ void CPDF_StructTree::LoadPageTree(RetainPtr<const CPDF_Dictionary> pPageDict) {
     return;
   }
 
-  RetainPtr<const CPDF_Array> pParentArray =
-      ToArray(parent_tree.LookupValue(parents_id));
-  if (!pParentArray) {
+  parent_array_ = ToArray(parent_tree.LookupValue(parents_id));
+  if (!parent_array_) {
     return;
   }
 
-  StructElementMap element_map;
-  for (size_t i = 0; i < pParentArray->size(); i++) {
-    RetainPtr<const CPDF_Dictionary> pParent = pParentArray->GetDictAt(i);
+  // Only load the elements of the page's content and their ancestors. Their
+  // kids, which may be many more, load on demand.
+  for (size_t i = 0; i < parent_array_->size(); i++) {
+    RetainPtr<const CPDF_Dictionary> pParent = parent_array_->GetDictAt(i);
     if (pParent) {
-      AddPageNode(std::move(pParent), &element_map, 0);
+      AddPageNode(std::move(pParent), 0);
     }
   }
 }
 
+CPDF_StructElement* CPDF_StructTree::GetElementForMarkedContentId(
+    int mcid) const {
+  if (!parent_array_ || mcid < 0) {
+    return nullptr;
+  }
+  return FindElement(parent_array_->GetDictAt(mcid));
+}
+
+CPDF_StructElement* CPDF_StructTree::FindElement(
+    const RetainPtr<const CPDF_Dictionary>& dict) const {
+  if (!dict) {
+    return nullptr;
+  }
+  auto it = element_map_.find(dict);
+  return it != element_map_.end() ? it->second.Get() : nullptr;
+}
+
 RetainPtr<CPDF_StructElement> CPDF_StructTree::AddPageNode(
     RetainPtr<const CPDF_Dictionary> pDict,
-    StructElementMap* map,
     int nLevel) {
   static constexpr int kStructTreeMaxRecursion = 32;
   if (nLevel > kStructTreeMaxRecursion) {
     return nullptr;
   }
 
-  auto it = map->find(pDict);
-  if (it != map->end()) {
+  auto it = element_map_.find(pDict);
+  if (it != element_map_.end()) {
     return it->second;
   }
 
   RetainPtr<const CPDF_Dictionary> key(pDict);
   auto pElement = pdfium::MakeRetain<CPDF_StructElement>(this, pDict);
-  (*map)[key] = pElement;
+  element_map_[key] = pElement;
   RetainPtr<const CPDF_Dictionary> pParent = pDict->GetDictFor("P");
   if (!pParent || pParent->GetNameFor("Type") == "StructTreeRoot") {
     if (!AddTopLevelNode(pDict, pElement)) {
-      map->erase(key);
+      element_map_.erase(key);
     }
     return pElement;
   }
 
-  RetainPtr<CPDF_StructElement> pParentElement =
-      AddPageNode(std::move(pParent), map, nLevel + 1);
-  if (!pParentElement) {
-    return pElement;
-  }
-
-  if (!pParentElement->UpdateKidIfElement(pDict, pElement.Get())) {
-    map->erase(key);
-    return pElement;
-  }
-
-  pElement->SetParent(pParentElement.Get());
+  // The parent links to `pElement` when it loads its kids, if it lists
+  // `pDict` among them.
+  AddPageNode(std::move(pParent), nLevel + 1);
   return pElement;
 }
 
@@ -16,6 +16,7 @@
 #include "core/fxcrt/bytestring.h"
 #include "core/fxcrt/retain_ptr.h"
 
+class CPDF_Array;
 class CPDF_Document;
 class CPDF_StructElement;
 
@@ -33,6 +34,15 @@ class CPDF_StructTree {
   uint32_t GetPageObjNum() const { return page_->GetObjNum(); }
   ByteString GetRoleMapNameFor(const ByteString& type) const;
 
+  // Returns the element that the page's entry in /ParentTree lists for marked
+  // content ID `mcid`, or nullptr.
+  CPDF_StructElement* GetElementForMarkedContentId(int mcid) const;
+
+  // Returns the element loaded for `dict`, or nullptr. Only the elements of
+  // the page's entry in /ParentTree, and their ancestors, get loaded.
+  CPDF_StructElement* FindElement(
+      const RetainPtr<const CPDF_Dictionary>& dict) const;
+
  private:
   using StructElementMap = std::map<RetainPtr<const CPDF_Dictionary>,
                                     RetainPtr<CPDF_StructElement>,
@@ -41,7 +51,6 @@ class CPDF_StructTree {
   void LoadPageTree(RetainPtr<const CPDF_Dictionary> pPageDict);
   RetainPtr<CPDF_StructElement> AddPageNode(
       RetainPtr<const CPDF_Dictionary> pDict,
-      StructElementMap* map,
       int nLevel);
   bool AddTopLevelNode(const CPDF_Dictionary* pDict,
                        const RetainPtr<CPDF_StructElement>& pElement);
@@ -49,7 +58,9 @@ class CPDF_StructTree {
   RetainPtr<const CPDF_Dictionary> const tree_root_;
   RetainPtr<const CPDF_Dictionary> const role_map_;
   RetainPtr<const CPDF_Dictionary> page_;
+  RetainPtr<const CPDF_Array> parent_array_;
   std::vector<RetainPtr<CPDF_StructElement>> kids_;
+  StructElementMap element_map_;
 };
 
 #endif  // CORE_FPDFDOC_CPDF_STRUCTTREE_H_
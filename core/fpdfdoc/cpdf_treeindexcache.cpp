@@ -0,0 +1,42 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fpdfdoc/cpdf_treeindexcache.h"
+
+#include <memory>
+
+#include "core/fpdfapi/parser/cpdf_dictionary.h"
+
+// static
+CPDF_TreeIndexCache* CPDF_TreeIndexCache::GetOrCreate(CPDF_Document* doc) {
+  auto* cache = static_cast<CPDF_TreeIndexCache*>(doc->GetTreeIndexCache());
+  if (!cache) {
+    auto new_cache = std::make_unique<CPDF_TreeIndexCache>();
+    cache = new_cache.get();
+    doc->SetTreeIndexCache(std::move(new_cache));
+  }
+  return cache;
+}
+
+CPDF_TreeIndexCache::CPDF_TreeIndexCache() = default;
+
+CPDF_TreeIndexCache::~CPDF_TreeIndexCache() = default;
+
+RetainPtr<CPDF_TreeIndexCache::NameTreeIndex>
+CPDF_TreeIndexCache::GetNameTreeIndex(RetainPtr<const CPDF_Dictionary> root) {
+  RetainPtr<NameTreeIndex>& index = name_tree_indices_[std::move(root)];
+  if (!index) {
+    index = pdfium::MakeRetain<NameTreeIndex>();
+  }
+  return index;
+}
+
+RetainPtr<CPDF_TreeIndexCache::NumberTreeIndex>
+CPDF_TreeIndexCache::GetNumberTreeIndex(RetainPtr<const CPDF_Dictionary> root) {
+  RetainPtr<NumberTreeIndex>& index = number_tree_indices_[std::move(root)];
+  if (!index) {
+    index = pdfium::MakeRetain<NumberTreeIndex>();
+  }
+  return index;
+}
@@ -0,0 +1,88 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FPDFDOC_CPDF_TREEINDEXCACHE_H_
+#define CORE_FPDFDOC_CPDF_TREEINDEXCACHE_H_
+
+#include <map>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "core/fpdfapi/parser/cpdf_document.h"
+#include "core/fxcrt/retain_ptr.h"
+#include "core/fxcrt/widestring.h"
+
+class CPDF_Dictionary;
+class CPDF_Object;
+
+// Holds the indices of a document's name trees and number trees, so that the
+// short-lived CPDF_NameTree and CPDF_NumberTree instances for a tree all share
+// one index.
+class CPDF_TreeIndexCache final : public CPDF_Document::TreeIndexCacheIface {
+ public:
+  // A flattened copy of a tree's entries, in tree order, built on first use.
+  // Only well-formed trees get entries: keys in strictly increasing order and
+  // within the /Limits of their nodes, and no node reached twice. Other trees
+  // have to be searched node by node.
+  template <typename Key, typename Value>
+  class Index final : public Retainable {
+   public:
+    struct Entry {
+      Key key;
+      RetainPtr<Value> value;
+    };
+
+    CONSTRUCT_VIA_MAKE_RETAIN;
+
+    bool IsBuilt() const { return built_; }
+
+    // `entries` is std::nullopt if the tree is not well-formed.
+    void SetEntries(std::optional<std::vector<Entry>> entries) {
+      entries_ = std::move(entries);
+      built_ = true;
+    }
+
+    // Returns nullptr if the index is not built, or the tree is not
+    // well-formed.
+    const std::vector<Entry>* GetEntries() const {
+      return entries_.has_value() ? &entries_.value() : nullptr;
+    }
+
+    // Drops the entries after the tree changes.
+    void Invalidate() {
+      entries_.reset();
+      built_ = false;
+    }
+
+   private:
+    Index() = default;
+    ~Index() override = default;
+
+    bool built_ = false;
+    std::optional<std::vector<Entry>> entries_;
+  };
+
+  using NameTreeIndex = Index<WideString, CPDF_Object>;
+  using NumberTreeIndex = Index<int, const CPDF_Object>;
+
+  // Returns the cache of `doc`, creating it on first use.
+  static CPDF_TreeIndexCache* GetOrCreate(CPDF_Document* doc);
+
+  CPDF_TreeIndexCache();
+  ~CPDF_TreeIndexCache() override;
+
+  RetainPtr<NameTreeIndex> GetNameTreeIndex(
+      RetainPtr<const CPDF_Dictionary> root);
+  RetainPtr<NumberTreeIndex> GetNumberTreeIndex(
+      RetainPtr<const CPDF_Dictionary> root);
+
+ private:
+  std::map<RetainPtr<const CPDF_Dictionary>, RetainPtr<NameTreeIndex>>
+      name_tree_indices_;
+  std::map<RetainPtr<const CPDF_Dictionary>, RetainPtr<NumberTreeIndex>>
+      number_tree_indices_;
+};
+
+#endif  // CORE_FPDFDOC_CPDF_TREEINDEXCACHE_H_
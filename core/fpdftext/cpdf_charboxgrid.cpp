@@ -0,0 +1,168 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fpdftext/cpdf_charboxgrid.h"
+
+#include <math.h>
+
+#include <algorithm>
+
+#include "core/fxcrt/stl_util.h"
+
+namespace {
+
+// The grid gets about this many boxes per cell.
+constexpr size_t kBoxesPerCell = 2;
+constexpr double kMaxCellsPerSide = 1024;
+// Boxes that overlap more cells go into `other_boxes_`, so that a few huge
+// boxes cannot blow up the size of the grid.
+constexpr int kMaxCellsPerBox = 16;
+
+bool IsFinite(const CFX_FloatRect& rect) {
+  return isfinite(rect.left) && isfinite(rect.bottom) && isfinite(rect.right) &&
+         isfinite(rect.top);
+}
+
+bool HasNaN(const CFX_FloatRect& rect) {
+  return isnan(rect.left) || isnan(rect.bottom) || isnan(rect.right) ||
+         isnan(rect.top);
+}
+
+int GetCell(float value, float origin, float scale, int count) {
+  const float cell = (value - origin) * scale;
+  if (cell <= 0.0f) {
+    return 0;
+  }
+  if (cell >= static_cast<float>(count)) {
+    return count - 1;
+  }
+  return static_cast<int>(cell);
+}
+
+}  // namespace
+
+CPDF_CharBoxGrid::CPDF_CharBoxGrid(const std::vector<CFX_FloatRect>& boxes)
+    : box_count_(fxcrt::CollectionSize<uint32_t>(boxes)) {
+  std::vector<CFX_FloatRect> normalized_boxes = boxes;
+  size_t finite_count = 0;
+  for (uint32_t i = 0; i < box_count_; ++i) {
+    CFX_FloatRect& box = normalized_boxes[i];
+    box.Normalize();
+    if (!IsFinite(box)) {
+      other_boxes_.push_back(i);
+      continue;
+    }
+    if (finite_count == 0) {
+      bounds_ = box;
+    } else {
+      bounds_.Union(box);
+    }
+    ++finite_count;
+  }
+  if (finite_count == 0) {
+    return;
+  }
+
+  // Shape the cells after the bounds, which are at least a unit wide and high
+  // for the sake of the scales.
+  const double cells = std::max<size_t>(finite_count / kBoxesPerCell, 1);
+  const double width = std::max(bounds_.Width(), 1.0f);
+  const double height = std::max(bounds_.Height(), 1.0f);
+  columns_ = static_cast<int>(
+      std::clamp(sqrt(cells * width / height), 1.0, kMaxCellsPerSide));
+  rows_ = static_cast<int>(std::clamp(cells / columns_, 1.0, kMaxCellsPerSide));
+  column_scale_ = static_cast<float>(columns_ / width);
+  row_scale_ = static_cast<float>(rows_ / height);
+
+  // Count the boxes of each cell, then lay the cells out back to back.
+  std::vector<bool> in_grid(box_count_);
+  cell_starts_.resize(columns_ * rows_ + 1);
+  for (uint32_t i = 0; i < box_count_; ++i) {
+    const CFX_FloatRect& box = normalized_boxes[i];
+    if (!IsFinite(box)) {
+      continue;
+    }
+    const int left = GetColumn(box.left);
+    const int right = GetColumn(box.right);
+    const int bottom = GetRow(box.bottom);
+    const int top = GetRow(box.top);
+    if ((right - left + 1) * (top - bottom + 1) > kMaxCellsPerBox) {
+      other_boxes_.push_back(i);
+      continue;
+    }
+    in_grid[i] = true;
+    for (int row = bottom; row <= top; ++row) {
+      for (int column = left; column <= right; ++column) {
+        ++cell_starts_[row * columns_ + column + 1];
+      }
+    }
+  }
+  for (size_t i = 1; i < cell_starts_.size(); ++i) {
+    cell_starts_[i] += cell_starts_[i - 1];
+  }
+
+  DataVector<uint32_t> cell_ends(cell_starts_.begin(), cell_starts_.end() - 1);
+  cell_boxes_.resize(cell_starts_.back());
+  for (uint32_t i = 0; i < box_count_; ++i) {
+    if (!in_grid[i]) {
+      continue;
+    }
+    const CFX_FloatRect& box = normalized_boxes[i];
+    const int left = GetColumn(box.left);
+    const int right = GetColumn(box.right);
+    for (int row = GetRow(box.bottom); row <= GetRow(box.top); ++row) {
+      for (int column = left; column <= right; ++column) {
+        cell_boxes_[cell_ends[row * columns_ + column]++] = i;
+      }
+    }
+  }
+  std::sort(other_boxes_.begin(), other_boxes_.end());
+}
+
+CPDF_CharBoxGrid::~CPDF_CharBoxGrid() = default;
+
+std::vector<uint32_t> CPDF_CharBoxGrid::GetCandidates(
+    const CFX_FloatRect& rect) const {
+  std::vector<uint32_t> candidates;
+  if (HasNaN(rect)) {
+    // Callers' intersection tests give NaN coordinates no consistent meaning.
+    candidates.resize(box_count_);
+    for (uint32_t i = 0; i < box_count_; ++i) {
+      candidates[i] = i;
+    }
+    return candidates;
+  }
+
+  candidates.assign(other_boxes_.begin(), other_boxes_.end());
+  if (columns_ == 0) {
+    return candidates;
+  }
+
+  // Look one cell further in each direction, so that callers computing their
+  // intersection tests with different rounding cannot miss any boxes.
+  const int left = std::max(GetColumn(rect.left) - 1, 0);
+  const int right = std::min(GetColumn(rect.right) + 1, columns_ - 1);
+  const int bottom = std::max(GetRow(rect.bottom) - 1, 0);
+  const int top = std::min(GetRow(rect.top) + 1, rows_ - 1);
+  for (int row = bottom; row <= top; ++row) {
+    const size_t row_start = row * columns_;
+    candidates.insert(candidates.end(),
+                      cell_boxes_.begin() + cell_starts_[row_start + left],
+                      cell_boxes_.begin() + cell_starts_[row_start + right + 1]);
+  }
+
+  // Boxes that span several cells are found more than once.
+  std::sort(candidates.begin(), candidates.end());
+  candidates.erase(std::unique(candidates.begin(), candidates.end()),
+                   candidates.end());
+  return candidates;
+}
+
+int CPDF_CharBoxGrid::GetColumn(float x) const {
+  return GetCell(x, bounds_.left, column_scale_, columns_);
+}
+
+int CPDF_CharBoxGrid::GetRow(float y) const {
+  return GetCell(y, bounds_.bottom, row_scale_, rows_);
+}
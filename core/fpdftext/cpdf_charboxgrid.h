@@ -0,0 +1,49 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FPDFTEXT_CPDF_CHARBOXGRID_H_
+#define CORE_FPDFTEXT_CPDF_CHARBOXGRID_H_
+
+#include <stdint.h>
+
+#include <vector>
+
+#include "core/fxcrt/data_vector.h"
+#include "core/fxcrt/fx_coordinates.h"
+
+// A uniform grid over the character boxes of a text page, to find the
+// characters near a point or a rectangle without testing every character.
+// Each grid cell lists the boxes that overlap it. Boxes that are not finite,
+// or that span many cells, are kept in a separate list instead.
+class CPDF_CharBoxGrid {
+ public:
+  // `boxes` need not be normalized.
+  explicit CPDF_CharBoxGrid(const std::vector<CFX_FloatRect>& boxes);
+  ~CPDF_CharBoxGrid();
+
+  // Returns the indices of the boxes that may intersect `rect`, in increasing
+  // order, as a superset of the boxes that do. Boxes and `rect` are treated
+  // as closed, so a box that only touches `rect` is included, and a point
+  // can be passed as an empty `rect`. `rect` must be normalized.
+  std::vector<uint32_t> GetCandidates(const CFX_FloatRect& rect) const;
+
+ private:
+  int GetColumn(float x) const;
+  int GetRow(float y) const;
+
+  const uint32_t box_count_;
+  CFX_FloatRect bounds_;
+  int columns_ = 0;
+  int rows_ = 0;
+  float column_scale_ = 0.0f;
+  float row_scale_ = 0.0f;
+  // Cell `i` lists `cell_boxes_[cell_starts_[i]]` up to, but not including,
+  // `cell_boxes_[cell_starts_[i + 1]]`.
+  DataVector<uint32_t> cell_starts_;
+  DataVector<uint32_t> cell_boxes_;
+  // Boxes that are always candidates.
+  DataVector<uint32_t> other_boxes_;
+};
+
+#endif  // CORE_FPDFTEXT_CPDF_CHARBOXGRID_H_
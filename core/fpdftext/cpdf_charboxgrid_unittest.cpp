@@ -0,0 +1,122 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fpdftext/cpdf_charboxgrid.h"
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#include "core/fxcrt/fx_coordinates.h"
+#include "testing/gmock/include/gmock/gmock.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+using ::testing::Contains;
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+using ::testing::IsSupersetOf;
+
+namespace {
+
+// Returns the boxes that `rect` intersects, counting boxes that only touch.
+std::vector<uint32_t> GetIntersectingBoxes(
+    const std::vector<CFX_FloatRect>& boxes,
+    const CFX_FloatRect& rect) {
+  std::vector<uint32_t> result;
+  for (uint32_t i = 0; i < boxes.size(); ++i) {
+    CFX_FloatRect box = boxes[i];
+    box.Normalize();
+    if (box.left <= rect.right && box.right >= rect.left &&
+        box.bottom <= rect.top && box.top >= rect.bottom) {
+      result.push_back(i);
+    }
+  }
+  return result;
+}
+
+// Lays out a page of `rows` lines of `columns` characters.
+std::vector<CFX_FloatRect> MakeLines(int rows, int columns) {
+  std::vector<CFX_FloatRect> boxes;
+  for (int row = 0; row < rows; ++row) {
+    for (int column = 0; column < columns; ++column) {
+      const float left = 50 + column * 6;
+      const float bottom = 700 - row * 12;
+      boxes.emplace_back(left, bottom, left + 5, bottom + 10);
+    }
+  }
+  return boxes;
+}
+
+}  // namespace
+
+TEST(CPDFCharBoxGridTest, Empty) {
+  CPDF_CharBoxGrid grid({});
+  EXPECT_THAT(grid.GetCandidates(CFX_FloatRect(0, 0, 100, 100)), IsEmpty());
+}
+
+TEST(CPDFCharBoxGridTest, CandidatesIncludeIntersectingBoxes) {
+  const std::vector<CFX_FloatRect> boxes = MakeLines(50, 80);
+  CPDF_CharBoxGrid grid(boxes);
+
+  const CFX_FloatRect kRects[] = {
+      CFX_FloatRect(52, 698, 52, 698),        // A point in the first line.
+      CFX_FloatRect(55, 700, 56, 710),        // Touches two boxes.
+      CFX_FloatRect(200, 300, 260, 420),      // A block of text.
+      CFX_FloatRect(0, 0, 1000, 1000),        // The whole page.
+      CFX_FloatRect(-100, -100, -50, -50),    // Outside of all boxes.
+      CFX_FloatRect(529, 112, 529, 112),      // Near the last box.
+      CFX_FloatRect(0, 705, 1000, 705),       // Across the first line.
+      CFX_FloatRect(-1e30f, 400, 1e30f, 410)  // Huge coordinates.
+  };
+  for (const CFX_FloatRect& rect : kRects) {
+    const std::vector<uint32_t> candidates = grid.GetCandidates(rect);
+    EXPECT_TRUE(std::is_sorted(candidates.begin(), candidates.end()));
+    EXPECT_EQ(candidates.end(),
+              std::adjacent_find(candidates.begin(), candidates.end()));
+    const std::vector<uint32_t> expected = GetIntersectingBoxes(boxes, rect);
+    EXPECT_TRUE(std::includes(candidates.begin(), candidates.end(),
+                              expected.begin(), expected.end()));
+  }
+
+  // A point only finds boxes near it.
+  EXPECT_LT(grid.GetCandidates(kRects[0]).size(), boxes.size() / 10);
+  EXPECT_EQ(boxes.size(), grid.GetCandidates(kRects[3]).size());
+}
+
+TEST(CPDFCharBoxGridTest, UnusualBoxes) {
+  constexpr float kInfinity = std::numeric_limits<float>::infinity();
+  std::vector<CFX_FloatRect> boxes = MakeLines(10, 10);
+  // Not normalized.
+  boxes.emplace_back(60, 650, 55, 640);
+  // Not finite.
+  boxes.emplace_back(0, 0, kInfinity, 10);
+  boxes.emplace_back(std::numeric_limits<float>::quiet_NaN(), 0, 10, 10);
+  // Covers all other boxes.
+  boxes.emplace_back(0, 0, 1000, 1000);
+  // Empty.
+  boxes.emplace_back(70, 690, 70, 690);
+  CPDF_CharBoxGrid grid(boxes);
+
+  EXPECT_THAT(grid.GetCandidates(CFX_FloatRect(57, 645, 57, 645)),
+              IsSupersetOf({100u, 101u, 102u, 103u}));
+  EXPECT_THAT(grid.GetCandidates(CFX_FloatRect(70, 690, 70, 690)),
+              Contains(104u));
+
+  // NaN coordinates return all boxes.
+  const std::vector<uint32_t> all = grid.GetCandidates(CFX_FloatRect(
+      std::numeric_limits<float>::quiet_NaN(), 0, 0, 0));
+  ASSERT_EQ(boxes.size(), all.size());
+  EXPECT_EQ(0u, all.front());
+  EXPECT_EQ(boxes.size() - 1, all.back());
+}
+
+TEST(CPDFCharBoxGridTest, SingleBox) {
+  CPDF_CharBoxGrid grid({CFX_FloatRect(10, 10, 20, 20)});
+  EXPECT_THAT(grid.GetCandidates(CFX_FloatRect(15, 15, 15, 15)),
+              ElementsAre(0u));
+  EXPECT_THAT(grid.GetCandidates(CFX_FloatRect(500, 500, 600, 600)),
+              ElementsAre(0u));
+}
@@ -17,12 +17,49 @@
 
 namespace {
 
+// Returns the ASCII lowercase form of `ch`. Only used to match ASCII text, so
+// other characters are returned as is.
+wchar_t ToLowerASCII(wchar_t ch) {
+  return FXSYS_IsUpperASCII(ch) ? ch + (L'a' - L'A') : ch;
+}
+
+// Finds `pattern`, which must be lowercase ASCII, in `str`, ignoring the case
+// of ASCII letters in `str`.
+std::optional<size_t> FindNoCase(WideStringView str, WideStringView pattern) {
+  if (str.GetLength() < pattern.GetLength()) {
+    return std::nullopt;
+  }
+  const size_t last = str.GetLength() - pattern.GetLength();
+  for (size_t pos = 0; pos <= last; ++pos) {
+    size_t i = 0;
+    while (i < pattern.GetLength() &&
+           ToLowerASCII(str[pos + i]) == pattern[i]) {
+      ++i;
+    }
+    if (i == pattern.GetLength()) {
+      return pos;
+    }
+  }
+  return std::nullopt;
+}
+
+// Finds `ch` in `str`, starting at offset `start`.
+std::optional<size_t> FindFrom(WideStringView str, wchar_t ch, size_t start) {
+  if (start >= str.GetLength()) {
+    return std::nullopt;
+  }
+  std::optional<size_t> pos = str.Substr(start).Find(ch);
+  if (!pos.has_value()) {
+    return std::nullopt;
+  }
+  return start + pos.value();
+}
+
 // Find the end of a web link starting from offset |start| and ending at offset
 // |end|. The purpose of this function is to separate url from the surrounding
-// context characters, we do not intend to fully validate the url. |str|
-// contains lower case characters only.
-size_t FindWebLinkEnding(const WideString& str, size_t start, size_t end) {
-  if (str.Contains(L'/', start)) {
+// context characters, we do not intend to fully validate the url.
+size_t FindWebLinkEnding(WideStringView str, size_t start, size_t end) {
+  if (FindFrom(str, L'/', start).has_value()) {
     // When there is a path and query after '/', most ASCII chars are allowed.
     // We don't sanitize in this case.
     return end;
@@ -33,7 +70,7 @@ size_t FindWebLinkEnding(const WideString& str, size_t start, size_t end) {
   if (str[start] == L'[') {
     // IPv6 reference.
     // Find the end of the reference.
-    auto result = str.Find(L']', start + 1);
+    auto result = FindFrom(str, L']', start + 1);
     if (result.has_value()) {
       end = result.value();
       if (end > start + 1) {  // Has content inside brackets.
@@ -41,7 +78,7 @@ size_t FindWebLinkEnding(const WideString& str, size_t start, size_t end) {
         size_t off = end + 1;
         if (off < len && str[off] == L':') {
           off++;
-          while (off < len && FXSYS_IsDecimalDigit(str[off])) {
+          while (off < len && FXSYS_IsDecimalDigit(str.CharAt(off))) {
             off++;
           }
           if (off > end + 2 &&
@@ -58,8 +95,8 @@ size_t FindWebLinkEnding(const WideString& str, size_t start, size_t end) {
   // and periods. Hyphen should not at the end though.
   // Non-ASCII chars are ignored during checking.
   while (end > start && str[end] < 0x80) {
-    if (FXSYS_IsDecimalDigit(str[end]) ||
-        (str[end] >= L'a' && str[end] <= L'z') || str[end] == L'.') {
+    if (FXSYS_IsDecimalDigit(str.CharAt(end)) ||
+        FXSYS_IsLowerASCII(ToLowerASCII(str[end])) || str[end] == L'.') {
       break;
     }
     end--;
@@ -70,7 +107,7 @@ size_t FindWebLinkEnding(const WideString& str, size_t start, size_t end) {
 // Remove characters from the end of |str|, delimited by |start| and |end|, up
 // to and including |charToFind|. No-op if |charToFind| is not present. Updates
 // |end| if characters were removed.
-void TrimBackwardsToChar(const WideString& str,
+void TrimBackwardsToChar(WideStringView str,
                          wchar_t charToFind,
                          size_t start,
                          size_t* end) {
@@ -86,7 +123,7 @@ void TrimBackwardsToChar(const WideString& str,
 // |start| and |end| in |str|. Matches a closing bracket or quote for each
 // opening character and, if present, removes everything afterwards. Returns the
 // new end position for the string.
-size_t TrimExternalBracketsFromWebLink(const WideString& str,
+size_t TrimExternalBracketsFromWebLink(WideStringView str,
                                        size_t start,
                                        size_t end) {
   for (size_t pos = 0; pos < start; pos++) {
@@ -116,14 +153,16 @@ CPDF_LinkExtract::~CPDF_LinkExtract() = default;
 
 void CPDF_LinkExtract::ExtractLinks() {
   link_array_.clear();
+  links_extracted_ = true;
   size_t start = 0;
   size_t pos = 0;
   bool bAfterHyphen = false;
   bool bLineBreak = false;
   const size_t nTotalChar = text_page_->CountChars();
   const WideString page_text = text_page_->GetAllPageText();
+  const WideStringView page_view = page_text.AsStringView();
   while (pos < nTotalChar) {
-    const CPDF_TextPage::CharInfo& char_info = text_page_->GetCharInfo(pos);
+    const CPDF_TextPage::CharView char_info = text_page_->GetCharInfo(pos);
     if (char_info.char_type() != CPDF_TextPage::CharType::kGenerated &&
         char_info.unicode() != L' ' && pos != nTotalChar - 1) {
       bAfterHyphen =
@@ -145,35 +184,44 @@ void CPDF_LinkExtract::ExtractLinks() {
       continue;
     }
 
-    WideString strBeCheck = page_text.Substr(start, nCount);
-    if (bLineBreak) {
-      strBeCheck.Remove(L'\n');
-      strBeCheck.Remove(L'\r');
-      bLineBreak = false;
+    // Words are checked in place, unless they need rewriting first.
+    WideStringView word = page_view.Substr(start, nCount);
+    WideString rewritten_word;
+    if (bLineBreak || word.Contains(L'\xfffe')) {
+      rewritten_word = WideString(word);
+      if (bLineBreak) {
+        rewritten_word.Remove(L'\n');
+        rewritten_word.Remove(L'\r');
+        bLineBreak = false;
+      }
+      // Replace the generated code with the hyphen char.
+      rewritten_word.Replace(L"\xfffe", L"-");
+      word = rewritten_word.AsStringView();
     }
-    // Replace the generated code with the hyphen char.
-    strBeCheck.Replace(L"\xfffe", L"-");
 
-    if (strBeCheck.GetLength() > 5) {
-      while (strBeCheck.GetLength() > 0) {
-        wchar_t ch = strBeCheck.Back();
+    if (word.GetLength() > 5) {
+      while (!word.IsEmpty()) {
+        wchar_t ch = word.Back();
         if (ch != L')' && ch != L',' && ch != L'>' && ch != L'.') {
           break;
         }
 
-        strBeCheck = strBeCheck.First(strBeCheck.GetLength() - 1);
+        word = word.First(word.GetLength() - 1);
         nCount--;
       }
 
       // Check for potential web URLs and email addresses.
       // Ftp address, file system links, data, blob etc. are not checked.
       if (nCount > 5) {
-        auto maybe_link = CheckWebLink(strBeCheck);
+        auto maybe_link = CheckWebLink(word);
         if (maybe_link.has_value()) {
           maybe_link.value().start_ += start;
           link_array_.push_back(maybe_link.value());
-        } else if (CheckMailLink(&strBeCheck)) {
-          link_array_.push_back(Link{{start, nCount}, strBeCheck});
+        } else {
+          std::optional<WideString> mail_url = CheckMailLink(word);
+          if (mail_url.has_value()) {
+            link_array_.push_back(Link{{start, nCount}, mail_url.value()});
+          }
         }
       }
     }
@@ -181,19 +229,22 @@ void CPDF_LinkExtract::ExtractLinks() {
   }
 }
 
+size_t CPDF_LinkExtract::CountLinks() {
+  ExtractLinksIfNeeded();
+  return link_array_.size();
+}
+
 std::optional<CPDF_LinkExtract::Link> CPDF_LinkExtract::CheckWebLink(
-    const WideString& strBeCheck) {
+    WideStringView str) {
   const WideStringView kHttpScheme = L"http";
   const WideStringView kWWWAddrStart = L"www.";
-  WideString str = strBeCheck;
-  str.MakeLower();
 
   // First, try to find the scheme.
-  auto start = str.Find(kHttpScheme);
+  auto start = FindNoCase(str, kHttpScheme);
   if (start.has_value()) {
     size_t off = start.value() + kHttpScheme.GetLength();  // move after "http".
     if (str.GetLength() > off + 4) {  // At least "://<char>" follows.
-      if (str[off] == L's') {         // "https" scheme is accepted.
+      if (ToLowerASCII(str[off]) == L's') {  // "https" scheme is accepted.
         off++;
       }
       if (str[off] == L':' && str[off + 1] == L'/' && str[off + 2] == L'/') {
@@ -205,14 +256,14 @@ std::optional<CPDF_LinkExtract::Link> CPDF_LinkExtract::CheckWebLink(
         if (end > off) {  // Non-empty host name.
           const size_t nStart = start.value();
           const size_t nCount = end - nStart + 1;
-          return Link{{nStart, nCount}, strBeCheck.Substr(nStart, nCount)};
+          return Link{{nStart, nCount}, WideString(str.Substr(nStart, nCount))};
         }
       }
     }
   }
 
   // When there is no scheme, try to find url starting with "www.".
-  start = str.Find(kWWWAddrStart);
+  start = FindNoCase(str, kWWWAddrStart);
   if (start.has_value()) {
     size_t off = start.value() + kWWWAddrStart.GetLength();
     if (str.GetLength() > off) {
@@ -224,7 +275,7 @@ std::optional<CPDF_LinkExtract::Link> CPDF_LinkExtract::CheckWebLink(
         const size_t nStart = start.value();
         const size_t nCount = end - nStart + 1;
         return Link{{nStart, nCount},
-                    L"http://" + strBeCheck.Substr(nStart, nCount)};
+                    L"http://" + WideString(str.Substr(nStart, nCount))};
       }
     }
   }
@@ -232,17 +283,19 @@ std::optional<CPDF_LinkExtract::Link> CPDF_LinkExtract::CheckWebLink(
   return std::nullopt;
 }
 
-bool CPDF_LinkExtract::CheckMailLink(WideString* str) {
-  auto aPos = str->Find(L'@');
+std::optional<WideString> CPDF_LinkExtract::CheckMailLink(
+    WideStringView str) {
+  auto aPos = str.Find(L'@');
   // Invalid when no '@' or when starts/ends with '@'.
-  if (!aPos.has_value() || aPos.value() == 0 || aPos == str->GetLength() - 1) {
-    return false;
+  if (!aPos.has_value() || aPos.value() == 0 ||
+      aPos.value() == str.GetLength() - 1) {
+    return std::nullopt;
   }
 
   // Check the local part.
   size_t pPos = aPos.value();  // Used to track the position of '@' or '.'.
   for (size_t i = aPos.value(); i > 0; i--) {
-    wchar_t ch = (*str)[i - 1];
+    wchar_t ch = str[i - 1];
     if (ch == L'_' || ch == L'-' || FXSYS_iswalnum(ch)) {
       continue;
     }
@@ -250,12 +303,13 @@ bool CPDF_LinkExtract::CheckMailLink(WideString* str) {
     if (ch != L'.' || i == pPos || i == 1) {
       if (i == aPos.value()) {
         // There is '.' or invalid char before '@'.
-        return false;
+        return std::nullopt;
       }
       // End extracting for other invalid chars, '.' at the beginning, or
       // consecutive '.'.
       size_t removed_len = i == pPos ? i + 1 : i;
-      *str = str->Last(str->GetLength() - removed_len);
+      str = str.Substr(removed_len);
+      aPos = aPos.value() - removed_len;
       break;
     }
     // Found a valid '.'.
@@ -263,25 +317,24 @@ bool CPDF_LinkExtract::CheckMailLink(WideString* str) {
   }
 
   // Check the domain name part.
-  aPos = str->Find(L'@');
-  if (!aPos.has_value() || aPos.value() == 0) {
-    return false;
+  if (aPos.value() == 0) {
+    return std::nullopt;
   }
 
-  str->TrimBack(L'.');
+  str = str.TrimmedRight(L'.');
   // At least one '.' in domain name, but not at the beginning.
   // TODO(weili): RFC5322 allows domain names to be a local name without '.'.
   // Check whether we should remove this check.
-  auto ePos = str->Find(L'.', aPos.value() + 1);
+  auto ePos = FindFrom(str, L'.', aPos.value() + 1);
   if (!ePos.has_value() || ePos.value() == aPos.value() + 1) {
-    return false;
+    return std::nullopt;
   }
 
   // Validate all other chars in domain name.
-  size_t nLen = str->GetLength();
+  size_t nLen = str.GetLength();
   pPos = 0;  // Used to track the position of '.'.
   for (size_t i = aPos.value() + 1; i < nLen; i++) {
-    wchar_t wch = (*str)[i];
+    wchar_t wch = str[i];
     if (wch == L'-' || FXSYS_iswalnum(wch)) {
       continue;
     }
@@ -291,26 +344,25 @@ bool CPDF_LinkExtract::CheckMailLink(WideString* str) {
       size_t host_end = i == pPos + 1 ? i - 2 : i - 1;
       if (pPos > 0 && host_end - aPos.value() >= 3) {
         // Trim the ending invalid chars if there is at least one '.' and name.
-        *str = str->First(host_end + 1);
+        str = str.First(host_end + 1);
         break;
       }
-      return false;
+      return std::nullopt;
     }
     pPos = i;
   }
 
-  if (!str->Contains(L"mailto:")) {
-    *str = L"mailto:" + *str;
-  }
-
-  return true;
+  // The local part cannot contain ':', so there is never a scheme yet.
+  return L"mailto:" + WideString(str);
 }
 
-WideString CPDF_LinkExtract::GetURL(size_t index) const {
+WideString CPDF_LinkExtract::GetURL(size_t index) {
+  ExtractLinksIfNeeded();
   return index < link_array_.size() ? link_array_[index].url_ : WideString();
 }
 
-std::vector<CFX_FloatRect> CPDF_LinkExtract::GetRects(size_t index) const {
+std::vector<CFX_FloatRect> CPDF_LinkExtract::GetRects(size_t index) {
+  ExtractLinksIfNeeded();
   if (index >= link_array_.size()) {
     return std::vector<CFX_FloatRect>();
   }
@@ -320,9 +372,16 @@ std::vector<CFX_FloatRect> CPDF_LinkExtract::GetRects(size_t index) const {
 }
 
 std::optional<CPDF_LinkExtract::Range> CPDF_LinkExtract::GetTextRange(
-    size_t index) const {
+    size_t index) {
+  ExtractLinksIfNeeded();
   if (index >= link_array_.size()) {
     return std::nullopt;
   }
   return link_array_[index];
 }
+
+void CPDF_LinkExtract::ExtractLinksIfNeeded() {
+  if (!links_extracted_) {
+    ExtractLinks();
+  }
+}
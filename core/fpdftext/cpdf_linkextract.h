@@ -29,22 +29,32 @@ class CPDF_LinkExtract {
   explicit CPDF_LinkExtract(const CPDF_TextPage* pTextPage);
   ~CPDF_LinkExtract();
 
+  // Finds the links of the page. Called on first use of the getters below, if
+  // not called before.
   void ExtractLinks();
-  size_t CountLinks() const { return link_array_.size(); }
-  WideString GetURL(size_t index) const;
-  std::vector<CFX_FloatRect> GetRects(size_t index) const;
-  std::optional<Range> GetTextRange(size_t index) const;
+
+  size_t CountLinks();
+  WideString GetURL(size_t index);
+  std::vector<CFX_FloatRect> GetRects(size_t index);
+  std::optional<Range> GetTextRange(size_t index);
 
  protected:
   struct Link : public Range {
     WideString url_;
   };
 
-  std::optional<Link> CheckWebLink(const WideString& str);
-  bool CheckMailLink(WideString* str);
+  // Both checks look at `str` in place, and only allocate for the URL of a
+  // link found.
+  std::optional<Link> CheckWebLink(WideStringView str);
+  // Returns the "mailto:" URL of the e-mail address in `str`, if any.
+  std::optional<WideString> CheckMailLink(WideStringView str);
 
   UnownedPtr<const CPDF_TextPage> const text_page_;
+  bool links_extracted_ = false;
   std::vector<Link> link_array_;
+
+ private:
+  void ExtractLinksIfNeeded();
 };
 
 #endif  // CORE_FPDFTEXT_CPDF_LINKEXTRACT_H_
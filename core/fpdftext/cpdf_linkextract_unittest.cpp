@@ -4,6 +4,7 @@
 
 #include "core/fpdftext/cpdf_linkextract.h"
 
+#include <optional>
 #include <utility>
 
 #include "testing/gtest/include/gtest/gtest.h"
@@ -33,8 +34,7 @@ TEST(CPDFLinkExtractTest, CheckMailLink) {
       L"fan@g..com"       // Domain name should not have consecutive '.'
   };
   for (const wchar_t* input : kInvalidStrings) {
-    WideString text_str(input);
-    EXPECT_FALSE(extractor.CheckMailLink(&text_str)) << input;
+    EXPECT_FALSE(extractor.CheckMailLink(input).has_value()) << input;
   }
 
   // A struct of {input_string, expected_extracted_email_address}.
@@ -57,11 +57,11 @@ TEST(CPDFLinkExtractTest, CheckMailLink) {
       {L"CAP.cap@Gmail.Com", L"CAP.cap@Gmail.Com"},  // Keep the original case.
   };
   for (const auto& it : kValidStrings) {
-    WideString text_str(it.input);
     WideString expected_str(L"mailto:");
     expected_str += it.expected_output;
-    EXPECT_TRUE(extractor.CheckMailLink(&text_str)) << it.input;
-    EXPECT_EQ(expected_str.c_str(), text_str);
+    std::optional<WideString> mail_url = extractor.CheckMailLink(it.input);
+    ASSERT_TRUE(mail_url.has_value()) << it.input;
+    EXPECT_EQ(expected_str, mail_url.value());
   }
 }
 
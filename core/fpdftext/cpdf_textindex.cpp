@@ -0,0 +1,333 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fpdftext/cpdf_textindex.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <limits>
+#include <optional>
+#include <tuple>
+
+#include "core/fpdftext/cpdf_textpage.h"
+#include "core/fxcrt/binary_buffer.h"
+#include "core/fxcrt/byteorder.h"
+#include "core/fxcrt/bytestring.h"
+#include "core/fxcrt/fx_extension.h"
+#include "core/fxcrt/fx_safe_types.h"
+#include "core/fxcrt/numerics/safe_conversions.h"
+#include "core/fxcrt/span_reader.h"
+#include "core/fxcrt/stl_util.h"
+
+namespace {
+
+// Identifies the serialized format, and its version.
+constexpr char kMagic[] = "PDFTXI02";
+
+struct WordRange {
+  size_t start;
+  size_t length;
+};
+
+std::vector<WordRange> SplitWords(WideStringView text) {
+  std::vector<WordRange> words;
+  size_t start = 0;
+  for (size_t i = 0; i <= text.GetLength(); ++i) {
+    if (i < text.GetLength() && FXSYS_iswalnum(text[i])) {
+      continue;
+    }
+    if (i > start) {
+      words.push_back({start, i - start});
+    }
+    start = i + 1;
+  }
+  return words;
+}
+
+WideString NormalizeWord(WideStringView word) {
+  WideString result(word);
+  result.MakeLower();
+  return result;
+}
+
+// Unions `other` into `rect`, ignoring empty rectangles.
+void UnionRect(CFX_FloatRect& rect, const CFX_FloatRect& other) {
+  if (other.IsEmpty()) {
+    return;
+  }
+  if (rect.IsEmpty()) {
+    rect = other;
+  } else {
+    rect.Union(other);
+  }
+}
+
+void AppendUint32(BinaryBuffer& buffer, uint32_t value) {
+  std::array<uint8_t, 4> bytes;
+  fxcrt::PutUInt32LSBFirst(value, bytes);
+  buffer.AppendSpan(bytes);
+}
+
+void AppendFloat(BinaryBuffer& buffer, float value) {
+  AppendUint32(buffer, std::bit_cast<uint32_t>(value));
+}
+
+// Reads a non-negative int32_t value, leaving room to count one past it.
+std::optional<int32_t> ReadIndex(SpanReader& reader) {
+  std::optional<uint32_t> value = reader.ReadUint32();
+  if (!value.has_value() ||
+      value.value() >
+          static_cast<uint32_t>(std::numeric_limits<int32_t>::max() - 1)) {
+    return std::nullopt;
+  }
+  return static_cast<int32_t>(value.value());
+}
+
+}  // namespace
+
+// static
+std::unique_ptr<CPDF_TextIndex> CPDF_TextIndex::Deserialize(
+    pdfium::span<const uint8_t> data) {
+  SpanReader reader(data);
+  const ByteStringView magic(kMagic);
+  std::optional<pdfium::span<const uint8_t>> header =
+      reader.ReadBytes(magic.GetLength());
+  if (!header.has_value() || ByteStringView(header.value()) != magic) {
+    return nullptr;
+  }
+
+  std::optional<uint32_t> page_count = reader.ReadUint32();
+  if (!page_count.has_value()) {
+    return nullptr;
+  }
+
+  auto index = std::make_unique<CPDF_TextIndex>();
+  for (uint32_t i = 0; i < page_count.value(); ++i) {
+    std::optional<int32_t> page_index = ReadIndex(reader);
+    std::optional<int32_t> page_word_count = ReadIndex(reader);
+    std::optional<int32_t> page_char_count = ReadIndex(reader);
+    if (!page_index.has_value() || !page_word_count.has_value() ||
+        !page_char_count.has_value()) {
+      return nullptr;
+    }
+    if (!index->page_counts_
+             .emplace(page_index.value(),
+                      PageCounts{page_word_count.value(),
+                                 page_char_count.value()})
+             .second) {
+      return nullptr;
+    }
+  }
+
+  std::optional<uint32_t> word_count = reader.ReadUint32();
+  if (!word_count.has_value()) {
+    return nullptr;
+  }
+
+  for (uint32_t i = 0; i < word_count.value(); ++i) {
+    std::optional<pdfium::span<const uint8_t>> utf8 = reader.ReadSizedBytes();
+    std::optional<uint32_t> posting_count = reader.ReadUint32();
+    if (!utf8.has_value() || !posting_count.has_value() ||
+        posting_count.value() == 0) {
+      return nullptr;
+    }
+    WideString word = WideString::FromUTF8(ByteStringView(utf8.value()));
+    std::vector<Posting>& postings = index->postings_[word];
+    if (word.IsEmpty() || !postings.empty()) {
+      return nullptr;
+    }
+
+    for (uint32_t j = 0; j < posting_count.value(); ++j) {
+      std::optional<int32_t> page_index = ReadIndex(reader);
+      std::optional<int32_t> word_index = ReadIndex(reader);
+      std::optional<int32_t> char_index = ReadIndex(reader);
+      std::optional<int32_t> char_count = ReadIndex(reader);
+      std::optional<float> left = reader.ReadFloat();
+      std::optional<float> bottom = reader.ReadFloat();
+      std::optional<float> right = reader.ReadFloat();
+      std::optional<float> top = reader.ReadFloat();
+      if (!page_index.has_value() || !word_index.has_value() ||
+          !char_index.has_value() || !char_count.has_value() ||
+          !left.has_value() || !bottom.has_value() || !right.has_value() ||
+          !top.has_value()) {
+        return nullptr;
+      }
+      auto page_it = index->page_counts_.find(page_index.value());
+      if (page_it == index->page_counts_.end() ||
+          word_index.value() >= page_it->second.word_count) {
+        return nullptr;
+      }
+      FX_SAFE_INT32 char_end = char_index.value();
+      char_end += char_count.value();
+      if (!char_end.IsValid() ||
+          char_end.ValueOrDie() > page_it->second.char_count) {
+        return nullptr;
+      }
+      postings.push_back({page_index.value(), word_index.value(),
+                          char_index.value(), char_count.value(),
+                          CFX_FloatRect(left.value(), bottom.value(),
+                                        right.value(), top.value())});
+    }
+    if (!std::is_sorted(postings.begin(), postings.end(), &ComesBefore)) {
+      return nullptr;
+    }
+  }
+  if (!reader.IsAtEnd()) {
+    return nullptr;
+  }
+  return index;
+}
+
+// static
+bool CPDF_TextIndex::ComesBefore(const Posting& a, const Posting& b) {
+  return std::tie(a.page_index, a.word_index) <
+         std::tie(b.page_index, b.word_index);
+}
+
+CPDF_TextIndex::CPDF_TextIndex() = default;
+
+CPDF_TextIndex::~CPDF_TextIndex() = default;
+
+void CPDF_TextIndex::AddPage(int page_index, const CPDF_TextPage& text_page) {
+  int32_t& char_count = page_counts_[page_index].char_count;
+  char_count = std::max(char_count, text_page.CountChars());
+
+  const WideString text = text_page.GetAllPageText();
+  for (const WordRange& range : SplitWords(text.AsStringView())) {
+    const int first = text_page.CharIndexFromTextIndex(range.start);
+    const int last =
+        text_page.CharIndexFromTextIndex(range.start + range.length - 1);
+    if (first < 0 || last < first) {
+      continue;
+    }
+
+    const int word_char_count = last - first + 1;
+    CFX_FloatRect rect;
+    for (const CFX_FloatRect& char_rect :
+         text_page.GetRectArray(first, word_char_count)) {
+      UnionRect(rect, char_rect);
+    }
+    AddWord(page_index, text.AsStringView().Substr(range.start, range.length),
+            first, word_char_count, rect);
+  }
+}
+
+void CPDF_TextIndex::AddWord(int page_index,
+                             WideStringView word,
+                             int char_index,
+                             int char_count,
+                             const CFX_FloatRect& rect) {
+  WideString normalized = NormalizeWord(word);
+  if (normalized.IsEmpty() || char_index < 0 || char_count < 0) {
+    return;
+  }
+
+  FX_SAFE_INT32 char_end = char_index;
+  char_end += char_count;
+  if (!char_end.IsValid()) {
+    return;
+  }
+
+  PageCounts& counts = page_counts_[page_index];
+  if (counts.word_count == std::numeric_limits<int32_t>::max()) {
+    return;
+  }
+  counts.char_count =
+      std::max<int32_t>(counts.char_count, char_end.ValueOrDie());
+  AddPosting(normalized,
+             {page_index, counts.word_count++, char_index, char_count, rect});
+}
+
+std::vector<CPDF_TextIndex::Hit> CPDF_TextIndex::Find(
+    WideStringView query) const {
+  std::vector<const std::vector<Posting>*> word_postings;
+  for (const WordRange& range : SplitWords(query)) {
+    auto it =
+        postings_.find(NormalizeWord(query.Substr(range.start, range.length)));
+    if (it == postings_.end()) {
+      return {};
+    }
+    word_postings.push_back(&it->second);
+  }
+  if (word_postings.empty()) {
+    return {};
+  }
+
+  // Postings are sorted by page and word index, and so the hits are too.
+  std::vector<Hit> hits;
+  for (const Posting& first : *word_postings.front()) {
+    Hit hit = {first.page_index, first.char_index, first.char_count,
+               first.rect};
+    bool matched = true;
+    for (size_t i = 1; i < word_postings.size(); ++i) {
+      const std::vector<Posting>& postings = *word_postings[i];
+      FX_SAFE_INT32 word_index = first.word_index;
+      word_index += i;
+      if (!word_index.IsValid()) {
+        matched = false;
+        break;
+      }
+      const Posting key = {first.page_index, word_index.ValueOrDie(), 0, 0,
+                           CFX_FloatRect()};
+      auto it = std::lower_bound(postings.begin(), postings.end(), key,
+                                 &CPDF_TextIndex::ComesBefore);
+      if (it == postings.end() || ComesBefore(key, *it)) {
+        matched = false;
+        break;
+      }
+      FX_SAFE_INT32 char_count = it->char_index;
+      char_count += it->char_count;
+      char_count -= hit.char_index;
+      if (!char_count.IsValid() || char_count.ValueOrDie() <= 0) {
+        matched = false;
+        break;
+      }
+      hit.char_count = char_count.ValueOrDie();
+      UnionRect(hit.rect, it->rect);
+    }
+    if (matched) {
+      hits.push_back(hit);
+    }
+  }
+  return hits;
+}
+
+DataVector<uint8_t> CPDF_TextIndex::Serialize() const {
+  BinaryBuffer buffer;
+  buffer.AppendSpan(ByteStringView(kMagic).unsigned_span());
+  AppendUint32(buffer, fxcrt::CollectionSize<uint32_t>(page_counts_));
+  for (const auto& [page_index, counts] : page_counts_) {
+    AppendUint32(buffer, page_index);
+    AppendUint32(buffer, counts.word_count);
+    AppendUint32(buffer, counts.char_count);
+  }
+  AppendUint32(buffer, fxcrt::CollectionSize<uint32_t>(postings_));
+  for (const auto& [word, postings] : postings_) {
+    const ByteString utf8 = word.ToUTF8();
+    AppendUint32(buffer, pdfium::checked_cast<uint32_t>(utf8.GetLength()));
+    buffer.AppendString(utf8);
+    AppendUint32(buffer, fxcrt::CollectionSize<uint32_t>(postings));
+    for (const Posting& posting : postings) {
+      AppendUint32(buffer, posting.page_index);
+      AppendUint32(buffer, posting.word_index);
+      AppendUint32(buffer, posting.char_index);
+      AppendUint32(buffer, posting.char_count);
+      AppendFloat(buffer, posting.rect.left);
+      AppendFloat(buffer, posting.rect.bottom);
+      AppendFloat(buffer, posting.rect.right);
+      AppendFloat(buffer, posting.rect.top);
+    }
+  }
+  return buffer.DetachBuffer();
+}
+
+void CPDF_TextIndex::AddPosting(const WideString& word,
+                                const Posting& posting) {
+  // Pages are usually added in order, so this mostly appends.
+  std::vector<Posting>& postings = postings_[word];
+  auto it = std::upper_bound(postings.begin(), postings.end(), posting,
+                             &ComesBefore);
+  postings.insert(it, posting);
+}
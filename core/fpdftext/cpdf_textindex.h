@@ -0,0 +1,87 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FPDFTEXT_CPDF_TEXTINDEX_H_
+#define CORE_FPDFTEXT_CPDF_TEXTINDEX_H_
+
+#include <stdint.h>
+
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "core/fxcrt/data_vector.h"
+#include "core/fxcrt/fx_coordinates.h"
+#include "core/fxcrt/span.h"
+#include "core/fxcrt/widestring.h"
+
+class CPDF_TextPage;
+
+// An inverted index of the words of a document, to find words and phrases
+// without extracting the text of any page again. Words are runs of letters and
+// digits, and match regardless of case.
+class CPDF_TextIndex {
+ public:
+  struct Hit {
+    int page_index;
+    // In terms of CPDF_TextPage character indices.
+    int char_index;
+    int char_count;
+    // The bounding box of the characters, in page space.
+    CFX_FloatRect rect;
+  };
+
+  // Returns nullptr if `data` is not an index returned by Serialize().
+  static std::unique_ptr<CPDF_TextIndex> Deserialize(
+      pdfium::span<const uint8_t> data);
+
+  CPDF_TextIndex();
+  ~CPDF_TextIndex();
+
+  // Adds the words of `text_page`, the page at `page_index`. Each page may
+  // only be added once.
+  void AddPage(int page_index, const CPDF_TextPage& text_page);
+
+  // Adds `word` as the word after the last one added for `page_index`. Words
+  // whose character range is negative or overflows are ignored.
+  void AddWord(int page_index,
+               WideStringView word,
+               int char_index,
+               int char_count,
+               const CFX_FloatRect& rect);
+
+  // Returns where the words of `query` occur one after the other, sorted by
+  // page and character index.
+  std::vector<Hit> Find(WideStringView query) const;
+
+  DataVector<uint8_t> Serialize() const;
+
+ private:
+  struct Posting {
+    int32_t page_index;
+    // The position of the word among the words of its page.
+    int32_t word_index;
+    int32_t char_index;
+    int32_t char_count;
+    CFX_FloatRect rect;
+  };
+
+  struct PageCounts {
+    int32_t word_count = 0;
+    // One past the last character index of the page.
+    int32_t char_count = 0;
+  };
+
+  // Orders postings by page, then by word index.
+  static bool ComesBefore(const Posting& a, const Posting& b);
+
+  void AddPosting(const WideString& word, const Posting& posting);
+
+  // Postings of each lowercase word, sorted by page and word index.
+  std::map<WideString, std::vector<Posting>> postings_;
+  // Every posting lies within the counts of its page.
+  std::map<int32_t, PageCounts> page_counts_;
+};
+
+#endif  // CORE_FPDFTEXT_CPDF_TEXTINDEX_H_
@@ -0,0 +1,185 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fpdftext/cpdf_textindex.h"
+
+#include <stdint.h>
+
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "core/fxcrt/byteorder.h"
+#include "core/fxcrt/data_vector.h"
+#include "core/fxcrt/fx_coordinates.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+// Adds `words` to `index` as a line of text, with a space between words and
+// 10 units of width per character.
+void AddLine(CPDF_TextIndex& index,
+             int page_index,
+             const std::vector<const wchar_t*>& words) {
+  int char_index = 0;
+  for (const wchar_t* word : words) {
+    const int length = static_cast<int>(WideStringView(word).GetLength());
+    const float left = 10.0f * char_index;
+    index.AddWord(page_index, word, char_index, length,
+                  CFX_FloatRect(left, 0, left + 10.0f * length, 10));
+    char_index += length + 1;
+  }
+}
+
+// Returns `data` with the little-endian 32-bit value at `offset` replaced.
+DataVector<uint8_t> WithUint32At(const DataVector<uint8_t>& data,
+                                 size_t offset,
+                                 uint32_t value) {
+  DataVector<uint8_t> result = data;
+  fxcrt::PutUInt32LSBFirst(value,
+                           pdfium::span(result).subspan(offset).first<4>());
+  return result;
+}
+
+}  // namespace
+
+TEST(CPDFTextIndexTest, FindWords) {
+  CPDF_TextIndex index;
+  AddLine(index, 0, {L"Hello", L"world"});
+  AddLine(index, 2, {L"Goodbye", L"WORLD", L"hello"});
+
+  std::vector<CPDF_TextIndex::Hit> hits = index.Find(L"world");
+  ASSERT_EQ(2u, hits.size());
+  EXPECT_EQ(0, hits[0].page_index);
+  EXPECT_EQ(6, hits[0].char_index);
+  EXPECT_EQ(5, hits[0].char_count);
+  EXPECT_EQ(CFX_FloatRect(60, 0, 110, 10), hits[0].rect);
+  EXPECT_EQ(2, hits[1].page_index);
+  EXPECT_EQ(8, hits[1].char_index);
+
+  EXPECT_EQ(2u, index.Find(L"HeLLo").size());
+  EXPECT_TRUE(index.Find(L"hell").empty());
+  EXPECT_TRUE(index.Find(L"").empty());
+  EXPECT_TRUE(index.Find(L" ,.").empty());
+}
+
+TEST(CPDFTextIndexTest, FindPhrases) {
+  CPDF_TextIndex index;
+  AddLine(index, 1, {L"hello", L"world", L"hello", L"there"});
+  AddLine(index, 0, {L"world", L"hello"});
+
+  std::vector<CPDF_TextIndex::Hit> hits = index.Find(L"hello, world!");
+  ASSERT_EQ(1u, hits.size());
+  EXPECT_EQ(1, hits[0].page_index);
+  EXPECT_EQ(0, hits[0].char_index);
+  EXPECT_EQ(11, hits[0].char_count);
+  EXPECT_EQ(CFX_FloatRect(0, 0, 110, 10), hits[0].rect);
+
+  // Pages were added out of order, but hits come in page order.
+  hits = index.Find(L"hello");
+  ASSERT_EQ(3u, hits.size());
+  EXPECT_EQ(0, hits[0].page_index);
+  EXPECT_EQ(1, hits[1].page_index);
+  EXPECT_EQ(0, hits[1].char_index);
+  EXPECT_EQ(1, hits[2].page_index);
+  EXPECT_EQ(12, hits[2].char_index);
+
+  // Phrases do not continue across pages.
+  EXPECT_TRUE(index.Find(L"there world").empty());
+  EXPECT_TRUE(index.Find(L"world world").empty());
+}
+
+TEST(CPDFTextIndexTest, BadCharRanges) {
+  CPDF_TextIndex index;
+  constexpr int kMax = std::numeric_limits<int>::max();
+  index.AddWord(0, L"negative", -1, 1, CFX_FloatRect());
+  index.AddWord(0, L"overflow", kMax, 1, CFX_FloatRect());
+  EXPECT_TRUE(index.Find(L"negative").empty());
+  EXPECT_TRUE(index.Find(L"overflow").empty());
+
+  // A phrase whose last word comes before its first one has no characters.
+  index.AddWord(0, L"back", kMax - 2, 1, CFX_FloatRect());
+  index.AddWord(0, L"front", 0, 1, CFX_FloatRect());
+  EXPECT_EQ(1u, index.Find(L"back").size());
+  EXPECT_TRUE(index.Find(L"back front").empty());
+
+  std::unique_ptr<CPDF_TextIndex> loaded =
+      CPDF_TextIndex::Deserialize(index.Serialize());
+  ASSERT_TRUE(loaded);
+  EXPECT_TRUE(loaded->Find(L"back front").empty());
+}
+
+TEST(CPDFTextIndexTest, SerializeRoundTrip) {
+  CPDF_TextIndex index;
+  AddLine(index, 0, {L"caf\u00e9", L"au", L"lait"});
+  AddLine(index, 3, {L"au", L"revoir"});
+
+  DataVector<uint8_t> data = index.Serialize();
+  std::unique_ptr<CPDF_TextIndex> loaded = CPDF_TextIndex::Deserialize(data);
+  ASSERT_TRUE(loaded);
+  EXPECT_EQ(data, loaded->Serialize());
+
+  std::vector<CPDF_TextIndex::Hit> hits = loaded->Find(L"CAF\u00c9 au");
+  ASSERT_EQ(1u, hits.size());
+  EXPECT_EQ(0, hits[0].page_index);
+  EXPECT_EQ(7, hits[0].char_count);
+  EXPECT_EQ(2u, loaded->Find(L"au").size());
+
+  // Words added later follow the loaded ones.
+  loaded->AddWord(3, L"Paris", 10, 5, CFX_FloatRect(100, 0, 150, 10));
+  EXPECT_EQ(1u, loaded->Find(L"revoir paris").size());
+}
+
+TEST(CPDFTextIndexTest, DeserializeBadData) {
+  CPDF_TextIndex index;
+  AddLine(index, 0, {L"hello", L"world"});
+  DataVector<uint8_t> data = index.Serialize();
+
+  // Every truncation is rejected.
+  for (size_t size = 0; size < data.size(); ++size) {
+    EXPECT_FALSE(
+        CPDF_TextIndex::Deserialize(pdfium::span(data).first(size)));
+  }
+
+  DataVector<uint8_t> extra = data;
+  extra.push_back(0);
+  EXPECT_FALSE(CPDF_TextIndex::Deserialize(extra));
+
+  DataVector<uint8_t> bad_magic = data;
+  bad_magic[0] = 'X';
+  EXPECT_FALSE(CPDF_TextIndex::Deserialize(bad_magic));
+
+  // The magic and the page count are followed by the page index, word count
+  // and character count of page 0. Then the first posting of "hello" follows
+  // the word count, the length-prefixed word and the posting count.
+  constexpr size_t kPageCharCountOffset = 8 + 4 + 4 + 4;
+  constexpr size_t kPageIndexOffset = 8 + 4 + 12 + 4 + 4 + 5 + 4;
+  constexpr size_t kWordIndexOffset = kPageIndexOffset + 4;
+  constexpr size_t kCharIndexOffset = kPageIndexOffset + 8;
+  constexpr size_t kCharCountOffset = kPageIndexOffset + 12;
+  ASSERT_TRUE(CPDF_TextIndex::Deserialize(
+      WithUint32At(data, kCharCountOffset, 11)));
+
+  // Values out of range, while all of the values after them are present.
+  EXPECT_FALSE(CPDF_TextIndex::Deserialize(
+      WithUint32At(data, kPageIndexOffset, 0xffffffff)));
+  EXPECT_FALSE(CPDF_TextIndex::Deserialize(
+      WithUint32At(data, kPageIndexOffset, 1)));
+  EXPECT_FALSE(CPDF_TextIndex::Deserialize(
+      WithUint32At(data, kWordIndexOffset, 2)));
+  EXPECT_FALSE(CPDF_TextIndex::Deserialize(
+      WithUint32At(data, kCharCountOffset, 12)));
+
+  // Characters past the end of `int32_t`, even on a page that claims to have
+  // that many.
+  constexpr uint32_t kMaxIndex = std::numeric_limits<int32_t>::max() - 1;
+  DataVector<uint8_t> overflow =
+      WithUint32At(data, kPageCharCountOffset, kMaxIndex);
+  overflow = WithUint32At(overflow, kCharIndexOffset, kMaxIndex - 5);
+  EXPECT_TRUE(CPDF_TextIndex::Deserialize(overflow));
+  overflow = WithUint32At(overflow, kCharCountOffset, kMaxIndex);
+  EXPECT_FALSE(CPDF_TextIndex::Deserialize(overflow));
+
+  EXPECT_TRUE(CPDF_TextIndex::Deserialize(CPDF_TextIndex().Serialize()));
+}
@@ -10,6 +10,7 @@
 #include <stdint.h>
 
 #include <algorithm>
+#include <map>
 #include <utility>
 #include <vector>
 
@@ -22,6 +23,7 @@
 #include "core/fpdfapi/page/cpdf_textobject.h"
 #include "core/fpdfapi/parser/cpdf_dictionary.h"
 #include "core/fpdfapi/parser/cpdf_string.h"
+#include "core/fpdftext/cpdf_charboxgrid.h"
 #include "core/fpdftext/unicodenormalizationdata.h"
 #include "core/fxcrt/check.h"
 #include "core/fxcrt/check_op.h"
@@ -130,8 +132,8 @@ float MaskPercentFilled(const std::vector<bool>& mask,
   return count / (end - start);
 }
 
-bool IsControlChar(const CPDF_TextPage::CharInfo& char_info) {
-  switch (char_info.unicode()) {
+bool IsControlChar(wchar_t unicode, CPDF_TextPage::CharType char_type) {
+  switch (unicode) {
     case 0x2:
     case 0x3:
     case 0x93:
@@ -140,7 +142,7 @@ bool IsControlChar(const CPDF_TextPage::CharInfo& char_info) {
     case 0x97:
     case 0x98:
     case 0xfffe:
-      return char_info.char_type() != CPDF_TextPage::CharType::kHyphen;
+      return char_type != CPDF_TextPage::CharType::kHyphen;
     default:
       return false;
   }
@@ -277,12 +279,18 @@ CFX_Matrix GetPageMatrix(const CPDF_Page* pPage) {
   return pPage->GetDisplayMatrix(rect, 0);
 }
 
+// Returns the id of `key` in `ids`, adding it with the next id if missing.
+template <typename T>
+int32_t GetOrAddId(std::map<const T*, int32_t>& ids, const T* key) {
+  return ids.emplace(key, fxcrt::CollectionSize<int32_t>(ids)).first->second;
+}
+
 float GetFontSize(const CPDF_TextObject* text_object) {
   bool has_font = text_object && text_object->GetFont();
   return has_font ? text_object->GetFontSize() : kDefaultFontSize;
 }
 
-CFX_FloatRect GetLooseBounds(const CPDF_TextPage::CharInfo& charinfo) {
+CFX_FloatRect GetLooseBounds(const CPDF_TextPage::CharView& charinfo) {
   if (charinfo.char_box().IsEmpty()) {
     return charinfo.char_box();
   }
@@ -359,14 +367,72 @@ CPDF_TextPage::CharInfo::CharInfo(CharType char_type,
       origin_(origin),
       char_box_(char_box),
       matrix_(matrix),
-      text_object_(text_object) {
-  loose_char_box_ = GetLooseBounds(*this);
-}
+      text_object_(text_object) {}
 
 CPDF_TextPage::CharInfo::CharInfo(const CharInfo&) = default;
 
 CPDF_TextPage::CharInfo::~CharInfo() = default;
 
+CPDF_TextPage::CharView::CharView(const CPDF_TextPage* text_page, size_t index)
+    : text_page_(text_page), index_(index) {}
+
+CPDF_TextPage::CharView::CharView(const CharView&) = default;
+
+CPDF_TextPage::CharView::~CharView() = default;
+
+CPDF_TextPage::CharType CPDF_TextPage::CharView::char_type() const {
+  return text_page_->char_list_.char_type(index_);
+}
+
+uint32_t CPDF_TextPage::CharView::char_code() const {
+  return text_page_->char_list_.char_code(index_);
+}
+
+wchar_t CPDF_TextPage::CharView::unicode() const {
+  return text_page_->char_list_.unicode(index_);
+}
+
+const CFX_PointF& CPDF_TextPage::CharView::origin() const {
+  return text_page_->char_list_.origin(index_);
+}
+
+const CFX_FloatRect& CPDF_TextPage::CharView::char_box() const {
+  return text_page_->char_list_.char_box(index_);
+}
+
+const CFX_Matrix& CPDF_TextPage::CharView::matrix() const {
+  return text_page_->char_list_.run(index_).matrix_;
+}
+
+const CPDF_TextObject* CPDF_TextPage::CharView::text_object() const {
+  return text_page_->char_list_.run(index_).text_object_;
+}
+
+CPDF_TextPage::CharList::CharList() = default;
+
+CPDF_TextPage::CharList::~CharList() = default;
+
+void CPDF_TextPage::CharList::push_back(CharInfo info) {
+  CPDF_TextObject* text_object = info.text_object();
+  if (runs_.empty() || runs_.back().text_object_ != text_object ||
+      runs_.back().matrix_ != info.matrix()) {
+    runs_.push_back({info.matrix(), UnownedPtr<CPDF_TextObject>(text_object)});
+  }
+  unicodes_.push_back(info.unicode());
+  char_codes_.push_back(info.char_code());
+  char_types_.push_back(info.char_type());
+  run_indices_.push_back(fxcrt::CollectionSize<uint32_t>(runs_) - 1);
+  origins_.push_back(info.origin());
+  char_boxes_.push_back(info.char_box());
+}
+
+CPDF_TextPage::CharInfo CPDF_TextPage::CharList::Get(size_t index) const {
+  const Run& char_run = run(index);
+  return CharInfo(char_type(index), char_code(index), unicode(index),
+                  origin(index), char_box(index), char_run.matrix_,
+                  char_run.text_object_);
+}
+
 CPDF_TextPage::CPDF_TextPage(const CPDF_Page* pPage, bool rtl)
     : page_(pPage), rtl_(rtl), display_matrix_(GetPageMatrix(pPage)) {
   Init();
@@ -385,10 +451,11 @@ void CPDF_TextPage::Init() {
 
   bool skipped = false;
   for (int i = 0; i < nCount; ++i) {
-    const CharInfo& charinfo = char_list_[i];
-    if (charinfo.char_type() == CharType::kGenerated ||
-        (charinfo.unicode() != 0 && !IsControlChar(charinfo)) ||
-        (charinfo.unicode() == 0 && charinfo.char_code() != 0)) {
+    const CharType char_type = char_list_.char_type(i);
+    const wchar_t unicode = char_list_.unicode(i);
+    if (char_type == CharType::kGenerated ||
+        (unicode != 0 && !IsControlChar(unicode, char_type)) ||
+        (unicode == 0 && char_list_.char_code(i) != 0)) {
       char_indices_.back().count++;
       skipped = true;
     } else {
@@ -452,7 +519,7 @@ std::vector<CFX_FloatRect> CPDF_TextPage::GetRectArray(int start,
   int pos = start;
   bool is_new_rect = true;
   while (count--) {
-    const CharInfo& charinfo = char_list_[pos++];
+    const CharView charinfo = GetCharInfo(pos++);
     if (charinfo.char_type() == CharType::kGenerated) {
       continue;
     }
@@ -482,18 +549,25 @@ std::vector<CFX_FloatRect> CPDF_TextPage::GetRectArray(int start,
 
 int CPDF_TextPage::GetIndexAtPos(const CFX_PointF& point,
                                  const CFX_SizeF& tolerance) const {
-  int pos;
+  const bool use_tolerance = tolerance.width > 0 || tolerance.height > 0;
+  CFX_FloatRect search_rect(point.x, point.y, point.x, point.y);
+  if (use_tolerance) {
+    // The normalized `char_rect_ext` below lies within the character box
+    // inflated this way, even when one of the tolerances is negative.
+    search_rect.Inflate(fabsf(tolerance.width) / 2,
+                        fabsf(tolerance.height) / 2);
+  }
+
   int NearPos = -1;
   double xdif = 5000;
   double ydif = 5000;
-  const int nCount = CountChars();
-  for (pos = 0; pos < nCount; ++pos) {
-    const CFX_FloatRect& orig_charrect = char_list_[pos].char_box();
+  for (uint32_t pos : GetCharBoxGrid().GetCandidates(search_rect)) {
+    const CFX_FloatRect& orig_charrect = char_list_.char_box(pos);
     if (orig_charrect.Contains(point)) {
-      break;
+      return pos;
     }
 
-    if (tolerance.width <= 0 && tolerance.height <= 0) {
+    if (!use_tolerance) {
       continue;
     }
 
@@ -517,16 +591,27 @@ int CPDF_TextPage::GetIndexAtPos(const CFX_PointF& point,
       NearPos = pos;
     }
   }
-  return pos < nCount ? pos : NearPos;
+  return NearPos;
 }
 
 WideString CPDF_TextPage::GetTextByPredicate(
-    const std::function<bool(const CharInfo&)>& predicate) const {
+    const std::function<bool(const CharView&)>& predicate,
+    size_t start,
+    size_t end) const {
   float posy = 0;
   bool IsContainPreChar = false;
+  // Before the first match, any character other than a space asks for a line
+  // feed.
   bool IsAddLineFeed = false;
+  for (size_t i = start; i > 0; --i) {
+    if (char_list_.unicode(i - 1) != L' ') {
+      IsAddLineFeed = true;
+      break;
+    }
+  }
   WideString strText;
-  for (const auto& charinfo : char_list_) {
+  for (size_t i = start; i < end; ++i) {
+    const CharView charinfo = GetCharInfo(i);
     if (predicate(charinfo)) {
       if (fabs(posy - charinfo.origin().y) > 0 && !IsContainPreChar &&
           IsAddLineFeed) {
@@ -555,36 +640,103 @@ WideString CPDF_TextPage::GetTextByPredicate(
 }
 
 WideString CPDF_TextPage::GetTextByRect(const CFX_FloatRect& rect) const {
-  return GetTextByPredicate([&rect](const CharInfo& charinfo) {
-    return IsRectIntersect(rect, charinfo.char_box());
-  });
+  CFX_FloatRect search_rect = rect;
+  search_rect.Normalize();
+  const std::vector<uint32_t> candidates =
+      GetCharBoxGrid().GetCandidates(search_rect);
+  if (candidates.empty()) {
+    return WideString();
+  }
+
+  // Past the character after the last match, no character adds any text.
+  return GetTextByPredicate(
+      [&rect](const CharView& charinfo) {
+        return IsRectIntersect(rect, charinfo.char_box());
+      },
+      candidates.front(),
+      std::min<size_t>(candidates.back() + 2, char_list_.size()));
 }
 
 WideString CPDF_TextPage::GetTextByObject(
     const CPDF_TextObject* pTextObj) const {
-  return GetTextByPredicate([pTextObj](const CharInfo& charinfo) {
-    return charinfo.text_object() == pTextObj;
-  });
+  return GetTextByPredicate(
+      [pTextObj](const CharView& charinfo) {
+        return charinfo.text_object() == pTextObj;
+      },
+      0, char_list_.size());
 }
 
-const CPDF_TextPage::CharInfo& CPDF_TextPage::GetCharInfo(size_t index) const {
+CPDF_TextPage::CharView CPDF_TextPage::GetCharInfo(size_t index) const {
   CHECK_LT(index, char_list_.size());
-  return char_list_[index];
+  return CharView(this, index);
 }
 
-CPDF_TextPage::CharInfo& CPDF_TextPage::GetCharInfo(size_t index) {
+CPDF_TextObject* CPDF_TextPage::GetCharTextObject(size_t index) {
   CHECK_LT(index, char_list_.size());
-  return char_list_[index];
+  return char_list_.run(index).text_object_;
 }
 
 float CPDF_TextPage::GetCharFontSize(size_t index) const {
   CHECK_LT(index, char_list_.size());
-  return GetFontSize(char_list_[index].text_object());
+  return GetFontSize(char_list_.run(index).text_object_);
 }
 
 CFX_FloatRect CPDF_TextPage::GetCharLooseBounds(size_t index) const {
+  return GetLooseBounds(GetCharInfo(index));
+}
+
+int CPDF_TextPage::GetCharTextObjectId(size_t index) const {
   CHECK_LT(index, char_list_.size());
-  return char_list_[index].loose_char_box();
+  BuildCharIds();
+  return char_text_object_ids_[index];
+}
+
+int CPDF_TextPage::GetCharFontId(size_t index) const {
+  CHECK_LT(index, char_list_.size());
+  BuildCharIds();
+  return char_font_ids_[index];
+}
+
+const CPDF_CharBoxGrid& CPDF_TextPage::GetCharBoxGrid() const {
+  if (!char_box_grid_) {
+    char_box_grid_ =
+        std::make_unique<CPDF_CharBoxGrid>(char_list_.char_boxes());
+  }
+  return *char_box_grid_;
+}
+
+void CPDF_TextPage::BuildCharIds() const {
+  if (char_text_object_ids_.size() == char_list_.size()) {
+    return;
+  }
+
+  std::map<const CPDF_TextObject*, int32_t> text_object_ids;
+  std::map<const CPDF_Font*, int32_t> font_ids;
+  char_text_object_ids_.resize(char_list_.size());
+  char_font_ids_.resize(char_list_.size());
+
+  // Consecutive characters mostly share a text object, so only look up the
+  // maps when it changes.
+  const CPDF_TextObject* prev_text_object = nullptr;
+  int32_t text_object_id = -1;
+  int32_t font_id = -1;
+  for (size_t i = 0; i < char_list_.size(); ++i) {
+    const CPDF_TextObject* text_object = char_list_.run(i).text_object_;
+    if (!text_object) {
+      prev_text_object = nullptr;
+      char_text_object_ids_[i] = -1;
+      char_font_ids_[i] = -1;
+      continue;
+    }
+    if (text_object != prev_text_object) {
+      prev_text_object = text_object;
+      text_object_id = GetOrAddId(text_object_ids, text_object);
+      const CPDF_Font* font = text_object->GetFont().Get();
+      font_id = font ? GetOrAddId(font_ids, font) : -1;
+    }
+    char_text_object_ids_[i] = text_object_id;
+    char_font_ids_[i] = font_id;
+  }
 }
 
 WideString CPDF_TextPage::GetPageText(int start, int count) const {
@@ -786,7 +938,7 @@ void CPDF_TextPage::ProcessFormObject(CPDF_FormObject* pFormObj,
 void CPDF_TextPage::AddCharInfoByLRDirection(wchar_t wChar,
                                              const CharInfo& info) {
   CharInfo info2 = info;
-  if (IsControlChar(info2)) {
+  if (IsControlChar(info2.unicode(), info2.char_type())) {
     char_list_.push_back(info2);
     return;
   }
@@ -810,7 +962,7 @@ void CPDF_TextPage::AddCharInfoByLRDirection(wchar_t wChar,
 void CPDF_TextPage::AddCharInfoByRLDirection(wchar_t wChar,
                                              const CharInfo& info) {
   CharInfo info2 = info;
-  if (IsControlChar(info2)) {
+  if (IsControlChar(info2.unicode(), info2.char_type())) {
     char_list_.push_back(info2);
     return;
   }
@@ -1062,7 +1214,7 @@ void CPDF_TextPage::ProcessMarkedContent(const TransformedTextObject& obj) {
 }
 
 void CPDF_TextPage::FindPreviousTextObject() {
-  const CharInfo* pPrevCharInfo = GetPrevCharInfo();
+  std::optional<CharInfo> pPrevCharInfo = GetPrevCharInfo();
   if (!pPrevCharInfo) {
     return;
   }
@@ -1198,16 +1350,19 @@ bool CPDF_TextPage::IsHyphen(wchar_t curChar) const {
     }
   }
 
-  const CharInfo* pPrevCharInfo = GetPrevCharInfo();
+  std::optional<CharInfo> pPrevCharInfo = GetPrevCharInfo();
   return pPrevCharInfo && pPrevCharInfo->char_type() == CharType::kPiece &&
          IsHyphenCode(pPrevCharInfo->unicode());
 }
 
-const CPDF_TextPage::CharInfo* CPDF_TextPage::GetPrevCharInfo() const {
+std::optional<CPDF_TextPage::CharInfo> CPDF_TextPage::GetPrevCharInfo() const {
   if (!temp_char_list_.empty()) {
-    return &temp_char_list_.back();
+    return temp_char_list_.back();
+  }
+  if (char_list_.empty()) {
+    return std::nullopt;
   }
-  return !char_list_.empty() ? &char_list_.back() : nullptr;
+  return char_list_.Get(char_list_.size() - 1);
 }
 
 CPDF_TextPage::GenerateCharacter CPDF_TextPage::ProcessInsertObject(
@@ -1499,7 +1654,7 @@ bool CPDF_TextPage::IsSameTextObject(CPDF_TextObject* pTextObj1,
     float dbXdif = fabs(rcPreObj.left - rcCurObj.left);
     size_t nCount = char_list_.size();
     if (nCount >= 2) {
-      float dbSpace = char_list_[nCount - 2].char_box().Width();
+      float dbSpace = char_list_.char_box(nCount - 2).Width();
       if (dbXdif > dbSpace) {
         return false;
       }
@@ -1570,7 +1725,7 @@ bool CPDF_TextPage::IsSameAsPreTextObject(
 std::optional<CPDF_TextPage::CharInfo> CPDF_TextPage::GenerateCharInfo(
     wchar_t unicode,
     const CFX_Matrix& form_matrix) {
-  const CharInfo* pPrevCharInfo = GetPrevCharInfo();
+  std::optional<CharInfo> pPrevCharInfo = GetPrevCharInfo();
   if (!pPrevCharInfo) {
     return std::nullopt;
   }
@@ -11,6 +11,7 @@
 
 #include <deque>
 #include <functional>
+#include <memory>
 #include <optional>
 #include <vector>
 
@@ -22,6 +23,7 @@
 #include "core/fxcrt/widestring.h"
 #include "core/fxcrt/widetext_buffer.h"
 
+class CPDF_CharBoxGrid;
 class CPDF_FormObject;
 class CPDF_Page;
 class CPDF_TextObject;
@@ -43,6 +45,7 @@ class CPDF_TextPage {
     kPiece,
   };
 
+  // A character as it is collected while processing the page.
   class CharInfo {
    public:
     CharInfo();
@@ -67,7 +70,6 @@ class CPDF_TextPage {
     const CFX_PointF& origin() const { return origin_; }
 
     const CFX_FloatRect& char_box() const { return char_box_; }
-    const CFX_FloatRect& loose_char_box() const { return loose_char_box_; }
 
     const CFX_Matrix& matrix() const { return matrix_; }
 
@@ -80,11 +82,34 @@ class CPDF_TextPage {
     uint32_t char_code_ = 0;
     CFX_PointF origin_;
     CFX_FloatRect char_box_;
-    CFX_FloatRect loose_char_box_;
     CFX_Matrix matrix_;
     UnownedPtr<CPDF_TextObject> text_object_;
   };
 
+  // A character of the text page, with the same accessors as CharInfo. It is
+  // cheap to copy, and only valid for as long as the text page is.
+  class CharView {
+   public:
+    CharView(const CharView&);
+    ~CharView();
+
+    CharType char_type() const;
+    uint32_t char_code() const;
+    wchar_t unicode() const;
+    const CFX_PointF& origin() const;
+    const CFX_FloatRect& char_box() const;
+    const CFX_Matrix& matrix() const;
+    const CPDF_TextObject* text_object() const;
+
+   private:
+    friend class CPDF_TextPage;
+
+    CharView(const CPDF_TextPage* text_page, size_t index);
+
+    UnownedPtr<const CPDF_TextPage> const text_page_;
+    const size_t index_;
+  };
+
   CPDF_TextPage(const CPDF_Page* pPage, bool rtl);
   ~CPDF_TextPage();
 
@@ -94,11 +119,18 @@ class CPDF_TextPage {
   int CountChars() const;
 
   // These methods CHECK() to make sure |index| is within bounds.
-  const CharInfo& GetCharInfo(size_t index) const;
-  CharInfo& GetCharInfo(size_t index);
+  CharView GetCharInfo(size_t index) const;
+  CPDF_TextObject* GetCharTextObject(size_t index);
   float GetCharFontSize(size_t index) const;
   CFX_FloatRect GetCharLooseBounds(size_t index) const;
 
+  // Ids number the distinct text objects, and the distinct fonts, of the
+  // characters on the page in order of first appearance, starting from 0.
+  // Characters without a text object get -1 for both. These CHECK() that
+  // |index| is within bounds.
+  int GetCharTextObjectId(size_t index) const;
+  int GetCharFontId(size_t index) const;
+
   std::vector<CFX_FloatRect> GetRectArray(int start, int count) const;
   int GetIndexAtPos(const CFX_PointF& point, const CFX_SizeF& tolerance) const;
   WideString GetTextByRect(const CFX_FloatRect& rect) const;
@@ -129,6 +161,44 @@ class CPDF_TextPage {
 
   enum class MarkedContentState { kPass = 0, kDone, kDelay };
 
+  // The characters of the page, stored column by column. Consecutive
+  // characters mostly share their text object and matrix, so each run of them
+  // stores these once.
+  class CharList {
+   public:
+    struct Run {
+      CFX_Matrix matrix_;
+      UnownedPtr<CPDF_TextObject> text_object_;
+    };
+
+    CharList();
+    ~CharList();
+
+    size_t size() const { return unicodes_.size(); }
+    bool empty() const { return unicodes_.empty(); }
+    void push_back(CharInfo info);
+    CharInfo Get(size_t index) const;
+
+    CharType char_type(size_t index) const { return char_types_[index]; }
+    uint32_t char_code(size_t index) const { return char_codes_[index]; }
+    wchar_t unicode(size_t index) const { return unicodes_[index]; }
+    const CFX_PointF& origin(size_t index) const { return origins_[index]; }
+    const CFX_FloatRect& char_box(size_t index) const {
+      return char_boxes_[index];
+    }
+    const std::vector<CFX_FloatRect>& char_boxes() const { return char_boxes_; }
+    const Run& run(size_t index) const { return runs_[run_indices_[index]]; }
+
+   private:
+    DataVector<wchar_t> unicodes_;
+    DataVector<uint32_t> char_codes_;
+    DataVector<CharType> char_types_;
+    DataVector<uint32_t> run_indices_;
+    std::vector<CFX_PointF> origins_;
+    std::vector<CFX_FloatRect> char_boxes_;
+    std::vector<Run> runs_;
+  };
+
   struct TransformedTextObject {
     TransformedTextObject();
     TransformedTextObject(const TransformedTextObject& that);
@@ -157,7 +227,7 @@ class CPDF_TextPage {
   void ProcessTextObjectItems(CPDF_TextObject* text_object,
                               const CFX_Matrix& form_matrix,
                               const CFX_Matrix& matrix);
-  const CharInfo* GetPrevCharInfo() const;
+  std::optional<CharInfo> GetPrevCharInfo() const;
   std::optional<CharInfo> GenerateCharInfo(wchar_t unicode,
                                            const CFX_Matrix& form_matrix);
   bool IsSameAsPreTextObject(CPDF_TextObject* pTextObj,
@@ -178,13 +248,24 @@ class CPDF_TextPage {
                                 const CFX_Matrix& form_matrix,
                                 bool use_temp_buffer);
   void SwapTempTextBuf(size_t iCharListStartAppend, size_t iBufStartAppend);
+  // Returns the text of the characters in [start, end) that match
+  // `predicate`. Characters before `start` must not match.
   WideString GetTextByPredicate(
-      const std::function<bool(const CharInfo&)>& predicate) const;
+      const std::function<bool(const CharView&)>& predicate,
+      size_t start,
+      size_t end) const;
+  const CPDF_CharBoxGrid& GetCharBoxGrid() const;
+  void BuildCharIds() const;
 
   UnownedPtr<const CPDF_Page> const page_;
   DataVector<TextPageCharSegment> char_indices_;
-  std::deque<CharInfo> char_list_;
+  CharList char_list_;
   std::deque<CharInfo> temp_char_list_;
+  // Built on first use by BuildCharIds(), in step with |char_list_|.
+  mutable DataVector<int32_t> char_text_object_ids_;
+  mutable DataVector<int32_t> char_font_ids_;
+  // Built on first use by GetCharBoxGrid(), over the boxes of |char_list_|.
+  mutable std::unique_ptr<CPDF_CharBoxGrid> char_box_grid_;
   WideTextBuffer text_buf_;
   WideTextBuffer temp_text_buf_;
   UnownedPtr<const CPDF_TextObject> prev_text_obj_;
@@ -7,6 +7,8 @@
 #ifndef CORE_FXCRT_FX_FOLDER_H_
 #define CORE_FXCRT_FX_FOLDER_H_
 
+#include <stdint.h>
+
 #include <memory>
 
 #include "core/fxcrt/bytestring.h"
@@ -15,10 +17,28 @@ class FX_Folder {
  public:
   static std::unique_ptr<FX_Folder> OpenFolder(const ByteString& path);
 
+  // The size and modification time of a file, which change when the file
+  // does.
+  struct FileStamp {
+    bool operator==(const FileStamp& that) const = default;
+
+    uint64_t size = 0;
+    // In 100 nanosecond units on Windows, and in nanoseconds elsewhere.
+    int64_t modified_time = 0;
+  };
+
   virtual ~FX_Folder() = default;
 
   // `filename` and `folder` are required out-parameters.
-  virtual bool GetNextFile(ByteString* filename, bool* bFolder) = 0;
+  bool GetNextFile(ByteString* filename, bool* bFolder) {
+    FileStamp stamp;
+    return GetNextFile(filename, bFolder, &stamp);
+  }
+
+  // Same as above, and `stamp` is a required out-parameter too.
+  virtual bool GetNextFile(ByteString* filename,
+                           bool* bFolder,
+                           FileStamp* stamp) = 0;
 };
 
 #endif  // CORE_FXCRT_FX_FOLDER_H_
@@ -24,7 +24,9 @@ class FX_PosixFolder : public FX_Folder {
  public:
   ~FX_PosixFolder() override;
 
-  bool GetNextFile(ByteString* filename, bool* bFolder) override;
+  bool GetNextFile(ByteString* filename,
+                   bool* bFolder,
+                   FileStamp* stamp) override;
 
  private:
   friend class FX_Folder;
@@ -51,7 +53,9 @@ FX_PosixFolder::~FX_PosixFolder() {
   closedir(dir_.ExtractAsDangling());
 }
 
-bool FX_PosixFolder::GetNextFile(ByteString* filename, bool* bFolder) {
+bool FX_PosixFolder::GetNextFile(ByteString* filename,
+                                 bool* bFolder,
+                                 FileStamp* stamp) {
   struct dirent* de = readdir(dir_);
   if (!de) {
     return false;
@@ -65,5 +69,14 @@ bool FX_PosixFolder::GetNextFile(ByteString* filename, bool* bFolder) {
 
   *filename = de->d_name;
   *bFolder = S_ISDIR(deStat.st_mode);
+  stamp->size = deStat.st_size;
+  // In nanoseconds, so that changes within the same second are noticed.
+#if BUILDFLAG(IS_APPLE)
+  const struct timespec& modified = deStat.st_mtimespec;
+#else
+  const struct timespec& modified = deStat.st_mtim;
+#endif
+  stamp->modified_time =
+      static_cast<int64_t>(modified.tv_sec) * 1000000000 + modified.tv_nsec;
   return true;
 }
@@ -0,0 +1,61 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxcrt/span_reader.h"
+
+#include <bit>
+
+#include "core/fxcrt/byteorder.h"
+
+namespace fxcrt {
+
+SpanReader::SpanReader(pdfium::span<const uint8_t> data) : data_(data) {}
+
+SpanReader::~SpanReader() = default;
+
+std::optional<pdfium::span<const uint8_t>> SpanReader::ReadBytes(size_t size) {
+  if (failed_ || size > data_.size()) {
+    failed_ = true;
+    data_ = pdfium::span<const uint8_t>();
+    return std::nullopt;
+  }
+  pdfium::span<const uint8_t> bytes = data_.first(size);
+  data_ = data_.subspan(size);
+  return bytes;
+}
+
+std::optional<pdfium::span<const uint8_t>> SpanReader::ReadSizedBytes() {
+  std::optional<uint32_t> size = ReadUint32();
+  if (!size.has_value()) {
+    return std::nullopt;
+  }
+  return ReadBytes(size.value());
+}
+
+std::optional<uint32_t> SpanReader::ReadUint32() {
+  std::optional<pdfium::span<const uint8_t>> bytes = ReadBytes(4);
+  if (!bytes.has_value()) {
+    return std::nullopt;
+  }
+  return GetUInt32LSBFirst(bytes.value().first<4u>());
+}
+
+std::optional<uint64_t> SpanReader::ReadUint64() {
+  std::optional<uint32_t> low = ReadUint32();
+  std::optional<uint32_t> high = ReadUint32();
+  if (!low.has_value() || !high.has_value()) {
+    return std::nullopt;
+  }
+  return (static_cast<uint64_t>(high.value()) << 32) | low.value();
+}
+
+std::optional<float> SpanReader::ReadFloat() {
+  std::optional<uint32_t> value = ReadUint32();
+  if (!value.has_value()) {
+    return std::nullopt;
+  }
+  return std::bit_cast<float>(value.value());
+}
+
+}  // namespace fxcrt
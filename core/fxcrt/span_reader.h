@@ -0,0 +1,48 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FXCRT_SPAN_READER_H_
+#define CORE_FXCRT_SPAN_READER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <optional>
+
+#include "core/fxcrt/span.h"
+
+namespace fxcrt {
+
+// Reads little-endian values from the front of a span of untrusted data.
+// Failures are sticky: once a read runs past the end of the data, every later
+// read fails too, so a value read after a failed one is never made up of
+// misaligned bytes.
+class SpanReader {
+ public:
+  explicit SpanReader(pdfium::span<const uint8_t> data);
+  ~SpanReader();
+
+  // Returns true when all of the data has been read, and no read failed.
+  bool IsAtEnd() const { return !failed_ && data_.empty(); }
+  bool failed() const { return failed_; }
+
+  std::optional<pdfium::span<const uint8_t>> ReadBytes(size_t size);
+
+  // Reads a uint32_t byte count, followed by that many bytes.
+  std::optional<pdfium::span<const uint8_t>> ReadSizedBytes();
+
+  std::optional<uint32_t> ReadUint32();
+  std::optional<uint64_t> ReadUint64();
+  std::optional<float> ReadFloat();
+
+ private:
+  pdfium::span<const uint8_t> data_;
+  bool failed_ = false;
+};
+
+}  // namespace fxcrt
+
+using fxcrt::SpanReader;
+
+#endif  // CORE_FXCRT_SPAN_READER_H_
@@ -0,0 +1,78 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxcrt/span_reader.h"
+
+#include <array>
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace fxcrt {
+
+TEST(SpanReader, Empty) {
+  SpanReader reader((pdfium::span<const uint8_t>()));
+  EXPECT_TRUE(reader.IsAtEnd());
+  EXPECT_FALSE(reader.failed());
+
+  std::optional<pdfium::span<const uint8_t>> bytes = reader.ReadBytes(0);
+  ASSERT_TRUE(bytes.has_value());
+  EXPECT_TRUE(bytes.value().empty());
+  EXPECT_FALSE(reader.ReadUint32().has_value());
+  EXPECT_TRUE(reader.failed());
+  EXPECT_FALSE(reader.IsAtEnd());
+}
+
+TEST(SpanReader, ReadValues) {
+  static constexpr auto kData = std::to_array<const uint8_t>({
+      0x01, 0x02, 0x03, 0x04,                          // Uint32
+      0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c,  // Uint64
+      0x00, 0x00, 0x80, 0x3f,                          // Float
+      0x02, 0x00, 0x00, 0x00, 'h',  'i',               // Sized bytes
+      0xff,                                            // Bytes
+  });
+  SpanReader reader(kData);
+  EXPECT_EQ(0x04030201u, reader.ReadUint32());
+  EXPECT_EQ(0x0c0b0a0908070605u, reader.ReadUint64());
+  EXPECT_EQ(1.0f, reader.ReadFloat());
+
+  std::optional<pdfium::span<const uint8_t>> bytes = reader.ReadSizedBytes();
+  ASSERT_TRUE(bytes.has_value());
+  ASSERT_EQ(2u, bytes.value().size());
+  EXPECT_EQ('h', bytes.value()[0]);
+  EXPECT_EQ('i', bytes.value()[1]);
+  EXPECT_FALSE(reader.IsAtEnd());
+
+  bytes = reader.ReadBytes(1);
+  ASSERT_TRUE(bytes.has_value());
+  ASSERT_EQ(1u, bytes.value().size());
+  EXPECT_EQ(0xff, bytes.value()[0]);
+  EXPECT_TRUE(reader.IsAtEnd());
+  EXPECT_FALSE(reader.failed());
+}
+
+TEST(SpanReader, FailureIsSticky) {
+  static constexpr auto kData = std::to_array<const uint8_t>({
+      0x08, 0x00, 0x00, 0x00,  // Sized bytes, longer than the data left.
+      0x01, 0x02, 0x03, 0x04,
+  });
+  SpanReader reader(kData);
+  EXPECT_FALSE(reader.ReadSizedBytes().has_value());
+  EXPECT_TRUE(reader.failed());
+
+  // There are enough bytes left for these, but they must still fail.
+  EXPECT_FALSE(reader.ReadUint32().has_value());
+  EXPECT_FALSE(reader.ReadBytes(0).has_value());
+  EXPECT_FALSE(reader.IsAtEnd());
+}
+
+TEST(SpanReader, ReadUint64Truncated) {
+  static constexpr auto kData = std::to_array<const uint8_t>({
+      0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+  });
+  SpanReader reader(kData);
+  EXPECT_FALSE(reader.ReadUint64().has_value());
+  EXPECT_TRUE(reader.failed());
+}
+
+}  // namespace fxcrt
@@ -10,7 +10,10 @@
 #include <stdint.h>
 
 #include <algorithm>
+#include <array>
+#include <optional>
 #include <utility>
+#include <vector>
 
 #include "build/build_config.h"
 #include "core/fxcrt/check.h"
@@ -272,12 +275,15 @@ void RgbByteOrderTransferBitmap(RetainPtr<CFX_DIBitmap> pBitmap,
   }
 }
 
-void RasterizeStroke(agg::rasterizer_scanline_aa* rasterizer,
-                     agg::path_storage* path_data,
-                     const CFX_Matrix* pObject2Device,
-                     const CFX_GraphStateData* pGraphState,
-                     float scale,
-                     bool bTextMode) {
+// Builds the outline of the stroke of `path_data` and passes it to
+// `add_outline` as an AGG vertex source. The outline still has to be
+// transformed by `pObject2Device`.
+template <class AddOutline>
+void StrokePath(agg::path_storage* path_data,
+                const CFX_Matrix* pObject2Device,
+                const CFX_GraphStateData* pGraphState,
+                float scale,
+                AddOutline add_outline) {
   agg::line_cap_e cap;
   switch (pGraphState->line_cap()) {
     case CFX_GraphStateData::LineCap::kRound:
@@ -329,7 +335,7 @@ void RasterizeStroke(agg::rasterizer_scanline_aa* rasterizer,
     stroke.line_cap(cap);
     stroke.miter_limit(pGraphState->miter_limit());
     stroke.width(width);
-    rasterizer->add_path_transformed(stroke, pObject2Device);
+    add_outline(stroke);
     return;
   }
   agg::conv_stroke<agg::path_storage> stroke(*path_data);
@@ -337,7 +343,19 @@ void RasterizeStroke(agg::rasterizer_scanline_aa* rasterizer,
   stroke.line_cap(cap);
   stroke.miter_limit(pGraphState->miter_limit());
   stroke.width(width);
-  rasterizer->add_path_transformed(stroke, pObject2Device);
+  add_outline(stroke);
+}
+
+void RasterizeStroke(agg::rasterizer_scanline_aa* rasterizer,
+                     agg::path_storage* path_data,
+                     const CFX_Matrix* pObject2Device,
+                     const CFX_GraphStateData* pGraphState,
+                     float scale,
+                     bool bTextMode) {
+  StrokePath(path_data, pObject2Device, pGraphState, scale,
+             [rasterizer, pObject2Device](auto& outline) {
+               rasterizer->add_path_transformed(outline, pObject2Device);
+             });
 }
 
 agg::filling_rule_e GetAlternateOrWindingFillType(
@@ -374,6 +392,15 @@ class CFX_AggRenderer {
   template <class Scanline>
   void render(const Scanline& sl);
 
+  // Whether FillOpaqueSpan() can be used: fully covered pixels then simply
+  // get set to the color.
+  bool CanFillOpaqueSpans() const {
+    return alpha_ == 255 && !clip_mask_ && !backdrop_device_;
+  }
+
+  // Same as render() for a span of `len` fully covered pixels at `x`, `y`.
+  void FillOpaqueSpan(int y, int x, int len);
+
  private:
   using CompositeSpanFunc = void (CFX_AggRenderer::*)(uint8_t*,
                                                       int,
@@ -847,6 +874,45 @@ void CFX_AggRenderer::render(const Scanline& sl) {
   });
 }
 
+void CFX_AggRenderer::FillOpaqueSpan(int y, int x, int len) {
+  DCHECK(CanFillOpaqueSpans());
+  if (y < clip_box_.top || y >= clip_box_.bottom) {
+    return;
+  }
+
+  const int col_start = GetColStart(x, clip_box_.left);
+  const int col_end = GetColEnd(x, len, clip_box_.right);
+  if (col_start >= col_end) {
+    return;
+  }
+
+  const size_t start = static_cast<size_t>(x + col_start);
+  const size_t count = static_cast<size_t>(col_end - col_start);
+  const int bytes_per_pixel = device_->GetBPP() / 8;
+  if (bytes_per_pixel == 1) {
+    std::ranges::fill(device_->GetWritableScanline(y).subspan(start, count),
+                      GetGray());
+    return;
+  }
+  if (bytes_per_pixel == 4) {
+    std::ranges::fill(
+        device_->GetWritableScanlineAs<uint32_t>(y).subspan(start, count),
+        color_);
+    return;
+  }
+  CHECK_EQ(bytes_per_pixel, 3);
+  const auto& bgr = GetBGR();
+  const uint8_t first = rgb_byte_order_ ? bgr.red : bgr.blue;
+  const uint8_t last = rgb_byte_order_ ? bgr.blue : bgr.red;
+  pdfium::span<uint8_t> dest_scan =
+      device_->GetWritableScanline(y).subspan(start * 3, count * 3);
+  for (size_t i = 0; i < dest_scan.size(); i += 3) {
+    dest_scan[i] = first;
+    dest_scan[i + 1] = bgr.green;
+    dest_scan[i + 2] = last;
+  }
+}
+
 template <class BaseRenderer>
 class RendererScanLineAaOffset {
  public:
@@ -934,6 +1000,695 @@ agg::path_storage BuildAggPath(const CFX_Path& path,
   return agg_path;
 }
 
+// An axis-aligned rectangle in the subpixel coordinates that
+// agg::rasterizer_scanline_aa works in.
+struct SubpixelRect {
+  int left;
+  int top;
+  int right;
+  int bottom;
+
+  // Whether the left edge of the outline runs down. The rasterizer rounds
+  // partial coverage down for such outlines, and up for the others.
+  bool left_edge_down;
+};
+
+// Returns the rectangle outlined by `points`, a closed subpath in subpixel
+// coordinates, if there is one.
+std::optional<SubpixelRect> GetSubpixelRect(
+    pdfium::span<const CFX_Point> points) {
+  if (points.size() != 4) {
+    return std::nullopt;
+  }
+  // The vertical edges, either 0->1 and 2->3, or 1->2 and 3->0.
+  size_t first_vertical;
+  if (points[0].x == points[1].x && points[1].y == points[2].y &&
+      points[2].x == points[3].x && points[3].y == points[0].y) {
+    first_vertical = 0;
+  } else if (points[0].y == points[1].y && points[1].x == points[2].x &&
+             points[2].y == points[3].y && points[3].x == points[0].x) {
+    first_vertical = 1;
+  } else {
+    return std::nullopt;
+  }
+  const CFX_Point& edge_start = points[first_vertical];
+  const CFX_Point& edge_end = points[first_vertical + 1];
+  const CFX_Point& opposite = points[first_vertical + 2];
+  const bool edge_down = edge_end.y > edge_start.y;
+  SubpixelRect rect;
+  rect.left = std::min(edge_start.x, opposite.x);
+  rect.right = std::max(edge_start.x, opposite.x);
+  rect.top = std::min(edge_start.y, edge_end.y);
+  rect.bottom = std::max(edge_start.y, edge_end.y);
+  rect.left_edge_down = edge_start.x == rect.left ? edge_down : !edge_down;
+  return rect;
+}
+
+int GetFirstPixel(int subpixel) {
+  return subpixel >> agg::poly_base_shift;
+}
+
+int GetLastPixel(int subpixel_end) {
+  return (subpixel_end - 1) >> agg::poly_base_shift;
+}
+
+// Returns whether some pixel is touched by more than one of `rects`. Sweeps
+// along the longer side of their bounds, so that rectangles lined up in a
+// row or a column, such as the dashes of a line, only get compared with
+// their neighbors. Reorders `rects`.
+bool RectsSharePixels(std::vector<SubpixelRect>& rects) {
+  int left = rects.front().left;
+  int top = rects.front().top;
+  int right = rects.front().right;
+  int bottom = rects.front().bottom;
+  for (const SubpixelRect& rect : rects) {
+    left = std::min(left, rect.left);
+    top = std::min(top, rect.top);
+    right = std::max(right, rect.right);
+    bottom = std::max(bottom, rect.bottom);
+  }
+  const bool sweep_columns = right - left >= bottom - top;
+
+  // The first and last pixel of `rect` along the sweep, and across it.
+  auto get_along = [sweep_columns](const SubpixelRect& rect) {
+    return sweep_columns ? std::make_pair(GetFirstPixel(rect.left),
+                                          GetLastPixel(rect.right))
+                         : std::make_pair(GetFirstPixel(rect.top),
+                                          GetLastPixel(rect.bottom));
+  };
+  auto get_across = [sweep_columns](const SubpixelRect& rect) {
+    return sweep_columns ? std::make_pair(GetFirstPixel(rect.top),
+                                          GetLastPixel(rect.bottom))
+                         : std::make_pair(GetFirstPixel(rect.left),
+                                          GetLastPixel(rect.right));
+  };
+  std::sort(rects.begin(), rects.end(),
+            [&get_along](const SubpixelRect& a, const SubpixelRect& b) {
+              return get_along(a).first < get_along(b).first;
+            });
+  // Rectangles that may still overlap the ones that follow along the sweep.
+  std::vector<const SubpixelRect*> active;
+  for (const SubpixelRect& rect : rects) {
+    const auto [start, end] = get_along(rect);
+    std::erase_if(active, [&get_along, start](const SubpixelRect* other) {
+      return get_along(*other).second < start;
+    });
+    const auto [first, last] = get_across(rect);
+    for (const SubpixelRect* other : active) {
+      const auto [other_first, other_last] = get_across(*other);
+      if (first <= other_last && other_first <= last) {
+        return true;
+      }
+    }
+    active.push_back(&rect);
+  }
+  return false;
+}
+
+// The outline the stroker gives a closed axis-aligned rectangle with mitered
+// corners: `outer`, and an inner contour. The inner contour runs along
+// `inner`, but overshoots each of its corners and cuts back with a diagonal
+// edge, which leaves a small triangle ("ear") at every corner. The rasterizer
+// fills `outer` minus `inner`, and counts the ears once more.
+struct SubpixelRing {
+  SubpixelRect outer;
+  SubpixelRect inner;
+
+  // Each ear as the corner of `inner` it belongs to, followed by its other
+  // two points in the order the inner contour visits them.
+  std::array<std::array<CFX_Point, 3>, 4> ears;
+};
+
+// Returns the ring that `outer` forms with `inner_points`, the inner contour
+// of a stroked rectangle in subpixel coordinates, if they form one. The inner
+// contour has to lie within both `outer` and the device, which `outer` still
+// needs clipping to.
+std::optional<SubpixelRing> GetSubpixelRing(
+    const SubpixelRect& outer,
+    pdfium::span<const CFX_Point> inner_points,
+    int clip_right,
+    int clip_bottom) {
+  if (inner_points.size() != 8) {
+    return std::nullopt;
+  }
+  for (const CFX_Point& point : inner_points) {
+    if (point.x < std::max(outer.left, 0) ||
+        point.x > std::min(outer.right, clip_right) ||
+        point.y < std::max(outer.top, 0) ||
+        point.y > std::min(outer.bottom, clip_bottom)) {
+      return std::nullopt;
+    }
+  }
+  auto get_point = [inner_points](size_t index) -> const CFX_Point& {
+    return inner_points[index % inner_points.size()];
+  };
+  // The edges along `inner` alternate between vertical and horizontal, and
+  // start either at the even or at the odd points. Splitting them at the
+  // corners of `inner` leaves the outline of `inner` plus one closed triangle
+  // per corner, whose cells the rasterizer simply adds up.
+  for (size_t first = 0; first < 2; ++first) {
+    const bool first_vertical = get_point(first).x == get_point(first + 1).x;
+    bool found = true;
+    for (size_t edge = 0; edge < 4 && found; ++edge) {
+      const CFX_Point& start = get_point(first + 2 * edge);
+      const CFX_Point& end = get_point(first + 2 * edge + 1);
+      const bool vertical = (edge % 2 == 0) == first_vertical;
+      found = vertical ? start.x == end.x : start.y == end.y;
+    }
+    if (!found) {
+      continue;
+    }
+    SubpixelRing ring;
+    ring.outer = outer;
+    std::array<CFX_Point, 4> corners;
+    for (size_t edge = 0; edge < 4; ++edge) {
+      const CFX_Point& end = get_point(first + 2 * edge + 1);
+      const CFX_Point& next_start = get_point(first + 2 * edge + 2);
+      const bool vertical = (edge % 2 == 0) == first_vertical;
+      corners[edge] = vertical ? CFX_Point(end.x, next_start.y)
+                               : CFX_Point(next_start.x, end.y);
+      ring.ears[edge] = {corners[edge], end, next_start};
+    }
+    // The corners always outline a rectangle, if possibly an empty one.
+    ring.inner = GetSubpixelRect(corners).value();
+    return ring;
+  }
+  return std::nullopt;
+}
+
+// The shapes an outline consists of.
+struct SubpixelShapes {
+  std::vector<SubpixelRect> rects;
+  std::vector<SubpixelRing> rings;
+};
+
+// Reads the outline in `vertex_source` the way
+// agg::rasterizer_scanline_aa::add_path_transformed() does, and returns the
+// rectangles it consists of, clipped to the device. If `allow_rings` is set,
+// it may consist of rings as well, which only fill as described when using
+// the nonzero filling rule. Returns nullopt unless the outline only consists
+// of such shapes that do not share pixels, which the rasterizer would fill
+// independently of each other.
+template <class VertexSource>
+std::optional<SubpixelShapes> GetDisjointSubpixelShapes(
+    VertexSource& vertex_source,
+    const CFX_Matrix* pObject2Device,
+    int device_width,
+    int device_height,
+    bool allow_rings) {
+  const int clip_right = agg::poly_coord(static_cast<float>(device_width));
+  const int clip_bottom = agg::poly_coord(static_cast<float>(device_height));
+  SubpixelShapes shapes;
+  auto add_rect = [&](SubpixelRect rect) {
+    rect.left = std::clamp(rect.left, 0, clip_right);
+    rect.right = std::clamp(rect.right, 0, clip_right);
+    rect.top = std::clamp(rect.top, 0, clip_bottom);
+    rect.bottom = std::clamp(rect.bottom, 0, clip_bottom);
+    if (rect.left < rect.right && rect.top < rect.bottom) {
+      shapes.rects.push_back(rect);
+    }
+  };
+  auto add_ring = [&](const SubpixelRect& outer,
+                      pdfium::span<const CFX_Point> inner_points) {
+    std::optional<SubpixelRing> ring =
+        GetSubpixelRing(outer, inner_points, clip_right, clip_bottom);
+    if (!ring.has_value()) {
+      return false;
+    }
+    SubpixelRect& clipped = ring->outer;
+    clipped.left = std::max(clipped.left, 0);
+    clipped.right = std::min(clipped.right, clip_right);
+    clipped.top = std::max(clipped.top, 0);
+    clipped.bottom = std::min(clipped.bottom, clip_bottom);
+    if (clipped.left >= clipped.right || clipped.top >= clipped.bottom) {
+      return false;
+    }
+    shapes.rings.push_back(ring.value());
+    return true;
+  };
+
+  // The stroker emits the inner contour of a ring right before or right after
+  // its outer rectangle. So a rectangle is held back until the next subpath
+  // shows whether it is part of a ring, and an inner contour until the
+  // rectangle it belongs to follows.
+  std::optional<SubpixelRect> pending_rect;
+  std::vector<CFX_Point> pending_inner;
+  std::vector<CFX_Point> subpath;
+  auto add_subpath = [&]() {
+    // Repeated points add no edges.
+    subpath.erase(std::unique(subpath.begin(), subpath.end()), subpath.end());
+    if (subpath.size() > 1 && subpath.front() == subpath.back()) {
+      subpath.pop_back();
+    }
+    if (subpath.size() <= 1) {
+      subpath.clear();
+      return true;
+    }
+    std::optional<SubpixelRect> rect = GetSubpixelRect(subpath);
+    if (rect.has_value()) {
+      subpath.clear();
+      if (!pending_inner.empty()) {
+        const bool added = add_ring(rect.value(), pending_inner);
+        pending_inner.clear();
+        return added;
+      }
+      if (pending_rect.has_value()) {
+        add_rect(pending_rect.value());
+      }
+      pending_rect = rect;
+      return true;
+    }
+    if (!allow_rings || subpath.size() != 8 || !pending_inner.empty()) {
+      return false;
+    }
+    if (pending_rect.has_value() && add_ring(pending_rect.value(), subpath)) {
+      subpath.clear();
+    } else {
+      if (pending_rect.has_value()) {
+        add_rect(pending_rect.value());
+      }
+      pending_inner.swap(subpath);
+    }
+    pending_rect.reset();
+    return true;
+  };
+
+  // Room for the points of an inner contour, or of a rectangle, and for a
+  // repeated first point.
+  const size_t max_subpath_size = allow_rings ? 9 : 5;
+  float x;
+  float y;
+  unsigned cmd;
+  vertex_source.rewind(0);
+  while (!agg::is_stop(cmd = vertex_source.vertex(&x, &y))) {
+    if (agg::is_close(cmd)) {
+      if (!add_subpath()) {
+        return std::nullopt;
+      }
+      continue;
+    }
+    const bool move_to = agg::is_move_to(cmd);
+    if (!move_to && !agg::is_vertex(cmd)) {
+      continue;
+    }
+    if (move_to) {
+      if (!add_subpath()) {
+        return std::nullopt;
+      }
+    } else if (subpath.empty()) {
+      // Edges that continue from a closed subpath, or that have no start.
+      return std::nullopt;
+    }
+    if (subpath.size() >= max_subpath_size) {
+      return std::nullopt;
+    }
+    CFX_PointF pos(x, y);
+    if (pObject2Device) {
+      pos = pObject2Device->Transform(pos);
+    }
+    subpath.emplace_back(agg::poly_coord(pos.x), agg::poly_coord(pos.y));
+  }
+  if (!add_subpath() || !pending_inner.empty()) {
+    return std::nullopt;
+  }
+  if (pending_rect.has_value()) {
+    add_rect(pending_rect.value());
+  }
+
+  std::vector<SubpixelRect>* bounds = &shapes.rects;
+  std::vector<SubpixelRect> ring_bounds;
+  if (!shapes.rings.empty()) {
+    ring_bounds = shapes.rects;
+    for (const SubpixelRing& ring : shapes.rings) {
+      ring_bounds.push_back(ring.outer);
+    }
+    bounds = &ring_bounds;
+  }
+  if (bounds->size() > 1 && RectsSharePixels(*bounds)) {
+    return std::nullopt;
+  }
+  return shapes;
+}
+
+// A vertex of an outline, as an AGG vertex source gives it.
+struct OutlineVertex {
+  float x;
+  float y;
+  unsigned cmd;
+};
+
+// Returns the vertices of the outline in `vertex_source`.
+template <class VertexSource>
+std::vector<OutlineVertex> RecordOutline(VertexSource& vertex_source) {
+  std::vector<OutlineVertex> vertices;
+  vertex_source.rewind(0);
+  while (true) {
+    OutlineVertex vertex = {0.0f, 0.0f, agg::path_cmd_stop};
+    vertex.cmd = vertex_source.vertex(&vertex.x, &vertex.y);
+    if (agg::is_stop(vertex.cmd)) {
+      return vertices;
+    }
+    vertices.push_back(vertex);
+  }
+}
+
+// An AGG vertex source that plays back the vertices RecordOutline() returned.
+class RecordedOutline {
+ public:
+  explicit RecordedOutline(pdfium::span<const OutlineVertex> vertices)
+      : vertices_(vertices) {}
+
+  void rewind(unsigned) { index_ = 0; }
+
+  unsigned vertex(float* x, float* y) {
+    if (index_ == vertices_.size()) {
+      return agg::path_cmd_stop;
+    }
+    const OutlineVertex& vertex = vertices_[index_++];
+    *x = vertex.x;
+    *y = vertex.y;
+    return vertex.cmd;
+  }
+
+ private:
+  const pdfium::span<const OutlineVertex> vertices_;
+  size_t index_ = 0;
+};
+
+// Returns whether the stroke of `path_data` may consist of rectangles and
+// rings, so that its outline is worth recording and checking. Transformed by
+// `pObject2Device`, each subpath has to be an open axis-aligned line segment,
+// or a closed axis-aligned rectangle with mitered corners. The stroker adds
+// vertices for round caps, for other joins, and for any other subpath.
+bool StrokeMayBeRects(const agg::path_storage& path_data,
+                      const CFX_Matrix* pObject2Device,
+                      const CFX_GraphStateData& graph_state) {
+  if (graph_state.line_cap() == CFX_GraphStateData::LineCap::kRound) {
+    return false;
+  }
+  const bool miter_joins =
+      graph_state.line_join() == CFX_GraphStateData::LineJoin::kMiter;
+  const unsigned total_vertices = path_data.total_vertices();
+  unsigned index = 0;
+  while (index < total_vertices) {
+    if (!agg::is_move_to(path_data.command(index))) {
+      return false;
+    }
+    std::array<CFX_Point, 5> points;
+    size_t num_points = 0;
+    do {
+      if (num_points == points.size()) {
+        return false;
+      }
+      float x;
+      float y;
+      path_data.vertex(index++, &x, &y);
+      CFX_PointF pos(x, y);
+      if (pObject2Device) {
+        pos = pObject2Device->Transform(pos);
+      }
+      points[num_points++] =
+          CFX_Point(agg::poly_coord(pos.x), agg::poly_coord(pos.y));
+    } while (index < total_vertices &&
+             agg::is_line_to(path_data.command(index)));
+    const bool closed =
+        index < total_vertices && agg::is_close(path_data.command(index));
+    if (!closed) {
+      if (num_points != 2 ||
+          (points[0].x != points[1].x && points[0].y != points[1].y)) {
+        return false;
+      }
+      continue;
+    }
+    ++index;
+    if (num_points == 5 && points[4] == points[0]) {
+      --num_points;
+    }
+    if (!miter_joins ||
+        !GetSubpixelRect(pdfium::span(points).first(num_points))
+             .has_value()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Returns the coverage agg::rasterizer_scanline_aa::calculate_alpha() gives a
+// pixel with `area`, the difference of its accumulated cover and its cell
+// area.
+unsigned CalculateAlpha(int area, bool no_smooth) {
+  constexpr int kShift = agg::poly_base_shift * 2 + 1 - 8;
+  int cover = area >> kShift;
+  if (cover < 0) {
+    cover = -cover;
+  }
+  constexpr int kMask = agg::rasterizer_scanline_aa::aa_mask;
+  if (no_smooth) {
+    cover = cover > kMask / 2 ? kMask : 0;
+  }
+  return std::min(cover, kMask);
+}
+
+// Returns the coverage agg::rasterizer_scanline_aa::calculate_alpha() gives a
+// pixel that `rect` covers `width` by `height` subpixels of.
+unsigned GetRectCoverage(const SubpixelRect& rect,
+                         int width,
+                         int height,
+                         bool no_smooth) {
+  const int area = 2 * width * height;
+  return CalculateAlpha(rect.left_edge_down ? area : -area, no_smooth);
+}
+
+// Adds the pixels of `rect` in a row that it covers `height` subpixels of to
+// `scanline`. Only the edge pixels need their coverage worked out. If
+// `skip_full_cover` is set and the pixels between the edges are fully
+// covered, they are left out, and the number of them is returned instead.
+int AddRectRow(const SubpixelRect& rect,
+               int height,
+               bool no_smooth,
+               bool skip_full_cover,
+               agg::scanline_u8& scanline) {
+  const int left_col = GetFirstPixel(rect.left);
+  const int right_col = GetLastPixel(rect.right);
+  if (left_col == right_col) {
+    unsigned cover =
+        GetRectCoverage(rect, rect.right - rect.left, height, no_smooth);
+    if (cover) {
+      scanline.add_cell(left_col, cover);
+    }
+    return 0;
+  }
+  int skipped = 0;
+  unsigned cover = GetRectCoverage(
+      rect, ((left_col + 1) << agg::poly_base_shift) - rect.left, height,
+      no_smooth);
+  if (cover) {
+    scanline.add_cell(left_col, cover);
+  }
+  if (right_col - left_col > 1) {
+    cover = GetRectCoverage(rect, agg::poly_base_size, height, no_smooth);
+    if (skip_full_cover && cover == agg::rasterizer_scanline_aa::aa_mask) {
+      skipped = right_col - left_col - 1;
+    } else if (cover) {
+      scanline.add_span(left_col + 1, right_col - left_col - 1, cover);
+    }
+  }
+  cover = GetRectCoverage(
+      rect, rect.right - (right_col << agg::poly_base_shift), height,
+      no_smooth);
+  if (cover) {
+    scanline.add_cell(right_col, cover);
+  }
+  return skipped;
+}
+
+// Renders `rects` with the same coverage agg::render_scanlines() would give
+// them. The rows inside a rectangle all share one scanline, and their fully
+// covered pixels get filled directly where `renderer` allows it.
+void RenderSubpixelRects(pdfium::span<const SubpixelRect> rects,
+                         bool no_smooth,
+                         CFX_AggRenderer& renderer) {
+  const bool fill_opaque = renderer.CanFillOpaqueSpans();
+  agg::scanline_u8 scanline;
+  for (const SubpixelRect& rect : rects) {
+    const int first_col = GetFirstPixel(rect.left);
+    scanline.reset(first_col, GetLastPixel(rect.right));
+    const int last_row = GetLastPixel(rect.bottom);
+    int row = GetFirstPixel(rect.top);
+    while (row <= last_row) {
+      const int row_top = std::max(rect.top, row << agg::poly_base_shift);
+      const int row_bottom =
+          std::min(rect.bottom, (row + 1) << agg::poly_base_shift);
+      const int height = row_bottom - row_top;
+      const int end_row = height == agg::poly_base_size
+                              ? GetFirstPixel(rect.bottom)
+                              : row + 1;
+      scanline.reset_spans();
+      const int filled =
+          AddRectRow(rect, height, no_smooth, fill_opaque, scanline);
+      const bool has_spans = scanline.num_spans() != 0;
+      for (; row < end_row; ++row) {
+        if (has_spans) {
+          scanline.finalize(row);
+          renderer.render(scanline);
+        }
+        if (filled) {
+          renderer.FillOpaqueSpan(row, first_col + 1, filled);
+        }
+      }
+    }
+  }
+}
+
+// Returns the number of subpixels of pixel row `row` that `rect` covers.
+int GetRowHeight(const SubpixelRect& rect, int row) {
+  const int top = std::max(rect.top, row << agg::poly_base_shift);
+  const int bottom = std::min(rect.bottom, (row + 1) << agg::poly_base_shift);
+  return std::max(bottom - top, 0);
+}
+
+// Returns the area agg::rasterizer_scanline_aa::calculate_alpha() gets for
+// the part of pixel `col` that `rect` covers, in a row that it covers
+// `height` subpixels of.
+int GetRectArea(const SubpixelRect& rect, int col, int height) {
+  const int left = std::max(rect.left, col << agg::poly_base_shift);
+  const int right = std::min(rect.right, (col + 1) << agg::poly_base_shift);
+  if (left >= right) {
+    return 0;
+  }
+  const int area = 2 * (right - left) * height;
+  return rect.left_edge_down ? area : -area;
+}
+
+// Adds the pixels of `ring` in pixel row `row` to `scanline`, given the cells
+// its ears have in the row, sorted by column. Only the columns with edges of
+// the rectangles or with ear cells need their coverage worked out, and `cols`
+// gets filled with those. If `skip_full_cover` is set, fully covered runs of
+// pixels between them are added to `full_cover_spans` as (column, length)
+// pairs instead.
+void AddRingRow(const SubpixelRing& ring,
+                int row,
+                pdfium::span<const agg::cell_aa* const> ear_cells,
+                bool no_smooth,
+                bool skip_full_cover,
+                std::vector<int>& cols,
+                agg::scanline_u8& scanline,
+                std::vector<std::pair<int, int>>& full_cover_spans) {
+  const int outer_height = GetRowHeight(ring.outer, row);
+  const int inner_height = GetRowHeight(ring.inner, row);
+  auto get_rects_area = [&](int col) {
+    return GetRectArea(ring.outer, col, outer_height) +
+           GetRectArea(ring.inner, col, inner_height);
+  };
+  const int first_col = GetFirstPixel(ring.outer.left);
+  const int last_col = GetLastPixel(ring.outer.right);
+  cols.assign({first_col, last_col});
+  if (inner_height && ring.inner.left < ring.inner.right) {
+    cols.push_back(GetFirstPixel(ring.inner.left));
+    cols.push_back(GetLastPixel(ring.inner.right));
+  }
+  for (const agg::cell_aa* cell : ear_cells) {
+    cols.push_back(cell->x);
+  }
+  std::sort(cols.begin(), cols.end());
+  cols.erase(std::unique(cols.begin(), cols.end()), cols.end());
+
+  // Like the sweep in agg::rasterizer_scanline_aa::sweep_scanline(), carry
+  // the cover of the cells to the left along the row.
+  constexpr int kFullCoverArea = 2 * agg::poly_base_size;
+  int ear_cover = 0;
+  size_t cell_index = 0;
+  int next_col = first_col;
+  for (int col : cols) {
+    const int run_end = std::min(col, last_col + 1);
+    if (next_col < run_end) {
+      const unsigned cover = CalculateAlpha(
+          get_rects_area(next_col) + ear_cover * kFullCoverArea, no_smooth);
+      if (skip_full_cover && cover == agg::rasterizer_scanline_aa::aa_mask) {
+        full_cover_spans.emplace_back(next_col, run_end - next_col);
+      } else if (cover) {
+        scanline.add_span(next_col, run_end - next_col, cover);
+      }
+    }
+    int ear_area = 0;
+    for (; cell_index < ear_cells.size() && ear_cells[cell_index]->x == col;
+         ++cell_index) {
+      ear_cover += ear_cells[cell_index]->cover;
+      ear_area += ear_cells[cell_index]->area;
+    }
+    if (col >= first_col && col <= last_col) {
+      const unsigned cover = CalculateAlpha(
+          get_rects_area(col) + ear_cover * kFullCoverArea - ear_area,
+          no_smooth);
+      if (cover) {
+        scanline.add_cell(col, cover);
+      }
+    }
+    next_col = std::max(next_col, col + 1);
+  }
+}
+
+// Renders `ring` with the same coverage agg::render_scanlines() would give
+// it. Only the ears get rasterized, and rows they do not reach share one
+// scanline as long as the rectangles cover the same part of them.
+void RenderSubpixelRing(const SubpixelRing& ring,
+                        bool no_smooth,
+                        CFX_AggRenderer& renderer) {
+  agg::outline_aa ears;
+  for (const auto& ear : ring.ears) {
+    ears.move_to(ear[0].x, ear[0].y);
+    ears.line_to(ear[1].x, ear[1].y);
+    ears.line_to(ear[2].x, ear[2].y);
+    ears.line_to(ear[0].x, ear[0].y);
+  }
+  ears.sort_cells();
+  auto get_ear_cells =
+      [&ears](int row) -> pdfium::span<const agg::cell_aa* const> {
+    if (ears.total_cells() == 0 || row < ears.min_y() || row > ears.max_y()) {
+      return {};
+    }
+    // SAFETY: the outline has scanline_num_cells() cells for each of its rows.
+    return UNSAFE_BUFFERS(
+        pdfium::span(ears.scanline_cells(row), ears.scanline_num_cells(row)));
+  };
+
+  const bool fill_opaque = renderer.CanFillOpaqueSpans();
+  agg::scanline_u8 scanline;
+  scanline.reset(GetFirstPixel(ring.outer.left),
+                 GetLastPixel(ring.outer.right));
+  std::vector<int> cols;
+  std::vector<std::pair<int, int>> full_cover_spans;
+  const int last_row = GetLastPixel(ring.outer.bottom);
+  int row = GetFirstPixel(ring.outer.top);
+  while (row <= last_row) {
+    pdfium::span<const agg::cell_aa* const> ear_cells = get_ear_cells(row);
+    const int outer_height = GetRowHeight(ring.outer, row);
+    const int inner_height = GetRowHeight(ring.inner, row);
+    int end_row = row + 1;
+    if (ear_cells.empty()) {
+      while (end_row <= last_row && get_ear_cells(end_row).empty() &&
+             GetRowHeight(ring.outer, end_row) == outer_height &&
+             GetRowHeight(ring.inner, end_row) == inner_height) {
+        ++end_row;
+      }
+    }
+    scanline.reset_spans();
+    full_cover_spans.clear();
+    AddRingRow(ring, row, ear_cells, no_smooth, fill_opaque, cols, scanline,
+               full_cover_spans);
+    const bool has_spans = scanline.num_spans() != 0;
+    for (; row < end_row; ++row) {
+      if (has_spans) {
+        scanline.finalize(row);
+        renderer.render(scanline);
+      }
+      for (const auto& [col, len] : full_cover_spans) {
+        renderer.FillOpaqueSpan(row, col, len);
+      }
+    }
+  }
+}
+
 }  // namespace
 
 CFX_AggDeviceDriver::CFX_AggDeviceDriver(
@@ -1134,6 +1889,64 @@ void CFX_AggDeviceDriver::RenderRasterizer(
                         fill_options_.aliased_path);
 }
 
+template <class VertexSource>
+bool CFX_AggDeviceDriver::RenderAlignedRects(VertexSource& outline,
+                                             const CFX_Matrix* pObject2Device,
+                                             uint32_t color,
+                                             bool bFullCover,
+                                             bool bGroupKnockout,
+                                             bool allow_rings) {
+  std::optional<SubpixelShapes> shapes = GetDisjointSubpixelShapes(
+      outline, pObject2Device, GetDeviceCaps(FXDC_PIXEL_WIDTH),
+      GetDeviceCaps(FXDC_PIXEL_HEIGHT), allow_rings);
+  if (!shapes.has_value()) {
+    return false;
+  }
+
+  RetainPtr<CFX_DIBitmap> pt = bGroupKnockout ? backdrop_bitmap_ : nullptr;
+  CFX_AggRenderer render(bitmap_, pt, clip_rgn_.get(), color, bFullCover,
+                         rgb_byte_order_);
+  RenderSubpixelRects(shapes->rects, fill_options_.aliased_path, render);
+  for (const SubpixelRing& ring : shapes->rings) {
+    RenderSubpixelRing(ring, fill_options_.aliased_path, render);
+  }
+  return true;
+}
+
+void CFX_AggDeviceDriver::RenderStroke(
+    agg::path_storage* path_data,
+    const CFX_Matrix* pObject2Device,
+    const CFX_GraphStateData* pGraphState,
+    float scale,
+    uint32_t color,
+    const CFX_FillRenderOptions& fill_options) {
+  agg::rasterizer_scanline_aa rasterizer;
+  rasterizer.clip_box(0.0f, 0.0f,
+                      static_cast<float>(GetDeviceCaps(FXDC_PIXEL_WIDTH)),
+                      static_cast<float>(GetDeviceCaps(FXDC_PIXEL_HEIGHT)));
+  if (StrokeMayBeRects(*path_data, pObject2Device, *pGraphState)) {
+    // Build the outline once, and only rasterize it if it turns out not to
+    // consist of shapes that RenderAlignedRects() can render.
+    std::vector<OutlineVertex> vertices;
+    StrokePath(path_data, pObject2Device, pGraphState, scale,
+               [&vertices](auto& outline) {
+                 vertices = RecordOutline(outline);
+               });
+    RecordedOutline outline(vertices);
+    if (RenderAlignedRects(outline, pObject2Device, color,
+                           fill_options.full_cover, group_knockout_,
+                           /*allow_rings=*/true)) {
+      return;
+    }
+    rasterizer.add_path_transformed(outline, pObject2Device);
+  } else {
+    RasterizeStroke(&rasterizer, path_data, pObject2Device, pGraphState, scale,
+                    fill_options.stroke_text_mode);
+  }
+  RenderRasterizer(rasterizer, color, fill_options.full_cover,
+                   group_knockout_);
+}
+
 bool CFX_AggDeviceDriver::DrawPath(const CFX_Path& path,
                                    const CFX_Matrix* pObject2Device,
                                    const CFX_GraphStateData* pGraphState,
@@ -1148,14 +1961,19 @@ bool CFX_AggDeviceDriver::DrawPath(const CFX_Path& path,
   if (fill_options.fill_type != CFX_FillRenderOptions::FillType::kNoFill &&
       fill_color) {
     agg::path_storage path_data = BuildAggPath(path, pObject2Device);
-    agg::rasterizer_scanline_aa rasterizer;
-    rasterizer.clip_box(0.0f, 0.0f,
-                        static_cast<float>(GetDeviceCaps(FXDC_PIXEL_WIDTH)),
-                        static_cast<float>(GetDeviceCaps(FXDC_PIXEL_HEIGHT)));
-    rasterizer.add_path(path_data);
-    rasterizer.filling_rule(GetAlternateOrWindingFillType(fill_options));
-    RenderRasterizer(rasterizer, fill_color, fill_options.full_cover,
-                     /*bGroupKnockout=*/false);
+    if (!RenderAlignedRects(path_data, nullptr, fill_color,
+                            fill_options.full_cover,
+                            /*bGroupKnockout=*/false,
+                            /*allow_rings=*/false)) {
+      agg::rasterizer_scanline_aa rasterizer;
+      rasterizer.clip_box(
+          0.0f, 0.0f, static_cast<float>(GetDeviceCaps(FXDC_PIXEL_WIDTH)),
+          static_cast<float>(GetDeviceCaps(FXDC_PIXEL_HEIGHT)));
+      rasterizer.add_path(path_data);
+      rasterizer.filling_rule(GetAlternateOrWindingFillType(fill_options));
+      RenderRasterizer(rasterizer, fill_color, fill_options.full_cover,
+                       /*bGroupKnockout=*/false);
+    }
   }
   int stroke_alpha = FXARGB_A(stroke_color);
   if (!pGraphState || !stroke_alpha) {
@@ -1164,14 +1982,8 @@ bool CFX_AggDeviceDriver::DrawPath(const CFX_Path& path,
 
   if (fill_options.zero_area) {
     agg::path_storage path_data = BuildAggPath(path, pObject2Device);
-    agg::rasterizer_scanline_aa rasterizer;
-    rasterizer.clip_box(0.0f, 0.0f,
-                        static_cast<float>(GetDeviceCaps(FXDC_PIXEL_WIDTH)),
-                        static_cast<float>(GetDeviceCaps(FXDC_PIXEL_HEIGHT)));
-    RasterizeStroke(&rasterizer, &path_data, nullptr, pGraphState, 1,
-                    fill_options.stroke_text_mode);
-    RenderRasterizer(rasterizer, stroke_color, fill_options.full_cover,
-                     group_knockout_);
+    RenderStroke(&path_data, nullptr, pGraphState, 1, stroke_color,
+                 fill_options);
     return true;
   }
   CFX_Matrix matrix1;
@@ -1187,14 +1999,8 @@ bool CFX_AggDeviceDriver::DrawPath(const CFX_Path& path,
   }
 
   agg::path_storage path_data = BuildAggPath(path, &matrix1);
-  agg::rasterizer_scanline_aa rasterizer;
-  rasterizer.clip_box(0.0f, 0.0f,
-                      static_cast<float>(GetDeviceCaps(FXDC_PIXEL_WIDTH)),
-                      static_cast<float>(GetDeviceCaps(FXDC_PIXEL_HEIGHT)));
-  RasterizeStroke(&rasterizer, &path_data, &matrix2, pGraphState, matrix1.a,
-                  fill_options.stroke_text_mode);
-  RenderRasterizer(rasterizer, stroke_color, fill_options.full_cover,
-                   group_knockout_);
+  RenderStroke(&path_data, &matrix2, pGraphState, matrix1.a, stroke_color,
+               fill_options);
   return true;
 }
 
@@ -27,6 +27,7 @@ class CFX_Path;
 namespace pdfium {
 
 namespace agg {
+class path_storage;
 class rasterizer_scanline_aa;
 }  // namespace agg
 
@@ -107,6 +108,28 @@ class CFX_AggDeviceDriver final : public RenderDeviceDriverIface {
 
   void SetClipMask(pdfium::agg::rasterizer_scanline_aa& rasterizer);
 
+  // Renders `outline` without rasterizing it, if it only consists of
+  // axis-aligned rectangles, or with `allow_rings` also of the outlines of
+  // stroked ones, that do not share pixels. The result is the same as
+  // RenderRasterizer() would give with the nonzero filling rule. Returns
+  // false, without rendering anything, for any other outline.
+  template <class VertexSource>
+  bool RenderAlignedRects(VertexSource& outline,
+                          const CFX_Matrix* pObject2Device,
+                          uint32_t color,
+                          bool bFullCover,
+                          bool bGroupKnockout,
+                          bool allow_rings);
+
+  // Renders the stroke of `path_data`, through RenderAlignedRects() where
+  // it can be. Builds the outline of the stroke only once either way.
+  void RenderStroke(pdfium::agg::path_storage* path_data,
+                    const CFX_Matrix* pObject2Device,
+                    const CFX_GraphStateData* pGraphState,
+                    float scale,
+                    uint32_t color,
+                    const CFX_FillRenderOptions& fill_options);
+
   RetainPtr<CFX_DIBitmap> const bitmap_;
   std::unique_ptr<CFX_AggClipRgn> clip_rgn_;
   std::vector<std::unique_ptr<CFX_AggClipRgn>> state_stack_;
@@ -163,6 +163,7 @@ CApplePlatform::CreateDefaultSystemFontInfo() {
     pInfo->AddPath("/Library/Fonts");
     pInfo->AddPath("/System/Library/Fonts");
   }
+  pInfo->SetCatalogPath(CFX_GEModule::Get()->GetFontCatalogPath());
   return pInfo;
 }
 
@@ -4,13 +4,24 @@
 
 #include "core/fxge/cfx_defaultrenderdevice.h"
 
+#include <stdint.h>
+
+#include <iterator>
+#include <limits>
+#include <vector>
+
 #include "core/fxcrt/fx_coordinates.h"
 #include "core/fxcrt/retain_ptr.h"
+#include "core/fxcrt/span.h"
 #include "core/fxge/cfx_fillrenderoptions.h"
+#include "core/fxge/cfx_font.h"
+#include "core/fxge/cfx_fontmgr.h"
 #include "core/fxge/cfx_graphstatedata.h"
 #include "core/fxge/cfx_path.h"
+#include "core/fxge/cfx_textrenderoptions.h"
 #include "core/fxge/dib/cfx_dibitmap.h"
 #include "core/fxge/dib/fx_dib.h"
+#include "core/fxge/text_char_pos.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
 TEST(CFXDefaultRenderDeviceTest, GetClipBoxDefault) {
@@ -73,3 +84,300 @@ TEST(CFXDefaultRenderDeviceTest, GetClipBoxEmpty) {
 
   EXPECT_TRUE(device.GetClipBox().IsEmpty());
 }
+
+namespace {
+
+// Returns all pixels of `device`, row by row.
+std::vector<uint32_t> GetPixels(CFX_DefaultRenderDevice& device) {
+  RetainPtr<CFX_DIBitmap> bitmap = device.GetBitmap();
+  std::vector<uint32_t> pixels;
+  for (int row = 0; row < bitmap->GetHeight(); ++row) {
+    pdfium::span<const uint32_t> scanline =
+        bitmap->GetScanlineAs<uint32_t>(row);
+    pixels.insert(pixels.end(), scanline.begin(), scanline.end());
+  }
+  return pixels;
+}
+
+CFX_Path MakePolygon(const std::vector<CFX_PointF>& points) {
+  CFX_Path path;
+  path.AppendPoint(points.front(), CFX_Path::Point::Type::kMove);
+  for (size_t i = 1; i < points.size(); ++i) {
+    path.AppendPoint(points[i], CFX_Path::Point::Type::kLine);
+  }
+  path.ClosePath();
+  return path;
+}
+
+std::vector<uint32_t> FillPath(const CFX_Path& path,
+                               const CFX_FillRenderOptions& fill_options) {
+  CFX_DefaultRenderDevice device;
+  EXPECT_TRUE(device.Create(/*width=*/16, /*height=*/16, FXDIB_Format::kBgra));
+  device.GetBitmap()->Clear(0x40ffffff);
+  device.DrawPath(path, nullptr, nullptr, 0xc0204080, 0, fill_options);
+  return GetPixels(device);
+}
+
+std::vector<uint32_t> StrokePath(const CFX_Path& path,
+                                 const CFX_Matrix* matrix,
+                                 const CFX_GraphStateData& graph_state,
+                                 uint32_t color,
+                                 const CFX_FillRenderOptions& fill_options) {
+  CFX_DefaultRenderDevice device;
+  EXPECT_TRUE(device.Create(/*width=*/16, /*height=*/16, FXDIB_Format::kBgra));
+  device.GetBitmap()->Clear(0x40ffffff);
+  device.DrawPath(path, matrix, &graph_state, 0, color, fill_options);
+  return GetPixels(device);
+}
+
+// Returns `path` with a diagonal line far outside the device added to it. The
+// line leaves no pixels, but it keeps the AGG renderer from treating the
+// stroke of the path as made of rectangles.
+CFX_Path WithLineOutsideDevice(const CFX_Path& path) {
+  CFX_Path result = path;
+  result.AppendPoint({-40, -40}, CFX_Path::Point::Type::kMove);
+  result.AppendPoint({-30, -31}, CFX_Path::Point::Type::kLine);
+  return result;
+}
+
+}  // namespace
+
+TEST(CFXDefaultRenderDeviceTest, FillAlignedRectsAntiAliased) {
+  // Each rectangle is also drawn with an extra point on its left edge, which
+  // keeps the AGG renderer from treating the path as an aligned rectangle.
+  // The anti-aliased coverage should not depend on that.
+  const CFX_FloatRect kRects[] = {
+      {1.5f, 2.25f, 9.75f, 11.5f},     {-3.2f, 0.3f, 4.6f, 4.7f},
+      {3.1f, 3.2f, 3.9f, 3.8f},        {10.25f, 12.6f, 18.0f, 17.3f},
+      {0.0f, 0.0f, 16.0f, 16.0f},      {5.01f, 6.0f, 5.02f, 7.0f},
+      {2.125f, 14.9f, 13.875f, 15.1f},
+  };
+  CFX_FillRenderOptions fill_options = CFX_FillRenderOptions::WindingOptions();
+  fill_options.rect_aa = true;
+  for (const CFX_FloatRect& rect : kRects) {
+    const CFX_PointF bottom_left(rect.left, rect.bottom);
+    const CFX_PointF top_left(rect.left, rect.top);
+    const CFX_PointF top_right(rect.right, rect.top);
+    const CFX_PointF bottom_right(rect.right, rect.bottom);
+    const CFX_PointF mid_left(rect.left, (rect.bottom + rect.top) / 2);
+    // Both orientations, as the rasterizer rounds partial coverage
+    // differently for each.
+    const std::vector<CFX_PointF> kOutlines[] = {
+        {bottom_left, top_left, top_right, bottom_right},
+        {bottom_left, bottom_right, top_right, top_left},
+    };
+    const std::vector<CFX_PointF> kGeneralOutlines[] = {
+        {bottom_left, mid_left, top_left, top_right, bottom_right},
+        {bottom_left, bottom_right, top_right, top_left, mid_left},
+    };
+    for (size_t i = 0; i < std::size(kOutlines); ++i) {
+      EXPECT_EQ(FillPath(MakePolygon(kGeneralOutlines[i]), fill_options),
+                FillPath(MakePolygon(kOutlines[i]), fill_options))
+          << rect.left << ", " << rect.bottom << ", " << rect.right << ", "
+          << rect.top << " outline " << i;
+    }
+  }
+}
+
+TEST(CFXDefaultRenderDeviceTest, FillAlignedRectsBatch) {
+  CFX_FillRenderOptions fill_options = CFX_FillRenderOptions::WindingOptions();
+  fill_options.rect_aa = true;
+
+  // Cells of a table, separated by fractional gaps.
+  CFX_Path cells;
+  CFX_Path reference;
+  for (int row = 0; row < 3; ++row) {
+    for (int col = 0; col < 3; ++col) {
+      const float left = col * 5.3f + 0.4f;
+      const float top = row * 5.1f + 0.2f;
+      cells.AppendRect(left, top, left + 4.6f, top + 4.2f);
+
+      // The same cell with an extra point, which makes the AGG renderer
+      // rasterize the whole path.
+      reference.Append(MakePolygon({{left, top},
+                                    {left, top + 2.1f},
+                                    {left, top + 4.2f},
+                                    {left + 4.6f, top + 4.2f},
+                                    {left + 4.6f, top}}),
+                       nullptr);
+    }
+  }
+  EXPECT_EQ(FillPath(reference, fill_options), FillPath(cells, fill_options));
+}
+
+TEST(CFXDefaultRenderDeviceTest, FillAlignedRectsLinedUp) {
+  CFX_FillRenderOptions fill_options = CFX_FillRenderOptions::WindingOptions();
+  fill_options.rect_aa = true;
+
+  // Rows and columns of bars. With the smaller gap, neighboring bars share
+  // pixels and the path has to be rasterized.
+  for (bool vertical : {false, true}) {
+    for (float gap : {1.3f, 0.3f}) {
+      CFX_Path bars;
+      CFX_Path reference;
+      for (int i = 0; i < 6; ++i) {
+        const float start = i * (1.2f + gap) + 0.1f;
+        const float end = start + 1.2f;
+        const CFX_FloatRect bar = vertical
+                                      ? CFX_FloatRect(3.4f, start, 9.7f, end)
+                                      : CFX_FloatRect(start, 3.4f, end, 9.7f);
+        bars.AppendRect(bar.left, bar.bottom, bar.right, bar.top);
+        reference.Append(MakePolygon({{bar.left, bar.bottom},
+                                      {bar.left, bar.top},
+                                      {bar.right, bar.top},
+                                      {bar.right, bar.bottom},
+                                      {bar.left + 0.5f, bar.bottom}}),
+                         nullptr);
+      }
+      EXPECT_EQ(FillPath(reference, fill_options), FillPath(bars, fill_options))
+          << "vertical " << vertical << " gap " << gap;
+    }
+  }
+}
+
+TEST(CFXDefaultRenderDeviceTest, StrokeAlignedRects) {
+  const CFX_FloatRect kRects[] = {
+      {2.3f, 3.6f, 12.2f, 11.7f}, {1.0f, 2.0f, 14.0f, 9.0f},
+      {4.5f, 4.5f, 11.5f, 11.5f}, {-3.2f, 5.3f, 6.6f, 20.4f},
+      {6.1f, 6.2f, 7.3f, 7.9f},
+  };
+  const float kWidths[] = {0.3f, 1.0f, 1.7f, 3.4f};
+  const uint32_t kColors[] = {0xc0204080, 0xff204080};
+  CFX_GraphStateData graph_state;
+  graph_state.set_line_join(CFX_GraphStateData::LineJoin::kMiter);
+  for (const CFX_FloatRect& rect : kRects) {
+    const CFX_PointF bottom_left(rect.left, rect.bottom);
+    const CFX_PointF top_left(rect.left, rect.top);
+    const CFX_PointF top_right(rect.right, rect.top);
+    const CFX_PointF bottom_right(rect.right, rect.bottom);
+    // Both orientations, as they give inner contours that start at different
+    // points.
+    const CFX_Path kPaths[] = {
+        MakePolygon({bottom_left, top_left, top_right, bottom_right}),
+        MakePolygon({bottom_left, bottom_right, top_right, top_left}),
+    };
+    for (float width : kWidths) {
+      graph_state.set_line_width(width);
+      for (bool aliased : {false, true}) {
+        CFX_FillRenderOptions fill_options;
+        fill_options.aliased_path = aliased;
+        for (uint32_t color : kColors) {
+          for (size_t i = 0; i < std::size(kPaths); ++i) {
+            EXPECT_EQ(StrokePath(WithLineOutsideDevice(kPaths[i]), nullptr,
+                                 graph_state, color, fill_options),
+                      StrokePath(kPaths[i], nullptr, graph_state, color,
+                                 fill_options))
+                << rect.left << ", " << rect.bottom << ", " << rect.right
+                << ", " << rect.top << " width " << width << " aliased "
+                << aliased << " color " << color << " outline " << i;
+          }
+        }
+      }
+    }
+  }
+}
+
+TEST(CFXDefaultRenderDeviceTest, StrokeAlignedRectsBatch) {
+  CFX_GraphStateData graph_state;
+  graph_state.set_line_join(CFX_GraphStateData::LineJoin::kMiter);
+  graph_state.set_line_width(0.5f);
+  // Flips the page upside down, like the usual page to device matrix.
+  const CFX_Matrix matrix(1, 0, 0, -1, 0.25f, 15.75f);
+
+  // Cells of a table, with their own borders. With the smaller gap, the
+  // borders of neighboring cells share pixels and the stroke has to be
+  // rasterized. The table also has an underline and a divider.
+  for (float gap : {2.0f, 0.25f}) {
+    CFX_Path cells;
+    for (int row = 0; row < 3; ++row) {
+      for (int col = 0; col < 2; ++col) {
+        const float left = col * (4.125f + gap) + 0.75f;
+        const float bottom = row * (2.625f + gap) + 0.625f;
+        cells.AppendRect(left, bottom, left + 4.125f, bottom + 2.625f);
+      }
+    }
+    cells.AppendPoint({0.5f, 14.25f}, CFX_Path::Point::Type::kMove);
+    cells.AppendPoint({12.0f, 14.25f}, CFX_Path::Point::Type::kLine);
+    cells.AppendPoint({13.375f, 0.5f}, CFX_Path::Point::Type::kMove);
+    cells.AppendPoint({13.375f, 12.0f}, CFX_Path::Point::Type::kLine);
+    for (uint32_t color : {0xc0204080u, 0xff204080u}) {
+      EXPECT_EQ(StrokePath(WithLineOutsideDevice(cells), &matrix, graph_state,
+                           color, CFX_FillRenderOptions()),
+                StrokePath(cells, &matrix, graph_state, color,
+                           CFX_FillRenderOptions()))
+          << "gap " << gap << " color " << color;
+    }
+  }
+}
+
+TEST(CFXDefaultRenderDeviceTest, DrawHairlines) {
+  CFX_DefaultRenderDevice device;
+  ASSERT_TRUE(device.Create(/*width=*/16, /*height=*/16, FXDIB_Format::kBgrx));
+  device.GetBitmap()->Clear(0xffffffff);
+
+  // A zero line width gives lines that are one device pixel wide.
+  CFX_GraphStateData graph_state;
+  graph_state.set_line_width(0.0f);
+  CFX_Path path;
+  path.AppendPoint({2, 5.5f}, CFX_Path::Point::Type::kMove);
+  path.AppendPoint({12, 5.5f}, CFX_Path::Point::Type::kLine);
+  path.AppendPoint({8.5f, 7}, CFX_Path::Point::Type::kMove);
+  path.AppendPoint({8.5f, 14}, CFX_Path::Point::Type::kLine);
+  device.DrawPath(path, nullptr, &graph_state, 0, 0xff000000,
+                  CFX_FillRenderOptions());
+
+  RetainPtr<CFX_DIBitmap> bitmap = device.GetBitmap();
+  for (int row = 0; row < 16; ++row) {
+    for (int col = 0; col < 16; ++col) {
+      const bool on_line = (row == 5 && col >= 2 && col < 12) ||
+                           (col == 8 && row >= 7 && row < 14);
+      EXPECT_EQ(on_line ? 0u : 0xffffffu,
+                bitmap->GetScanlineAs<uint32_t>(row)[col] & 0xffffff)
+          << col << ", " << row;
+    }
+  }
+}
+
+TEST(CFXDefaultRenderDeviceTest, DrawSubpixelTextOutOfRange) {
+  CFX_Font font;
+  ASSERT_TRUE(font.LoadEmbedded(CFX_FontMgr::GetStandardFont(0),
+                                /*force_vertical=*/false, /*object_tag=*/0));
+  TextCharPos char_pos;
+  char_pos.glyph_index_ = font.GetFace()->GetCharIndex('H');
+  CFX_TextRenderOptions options(CFX_TextRenderOptions::kAntiAliasing);
+  options.subpixel_positioning = true;
+
+  // 8 bits per pixel devices render anti-aliased text without LCD
+  // optimization, which is what subpixel positioning applies to.
+  CFX_DefaultRenderDevice device;
+  ASSERT_TRUE(
+      device.Create(/*width=*/16, /*height=*/16, FXDIB_Format::k8bppMask));
+  RetainPtr<CFX_DIBitmap> bitmap = device.GetBitmap();
+
+  // Origins that do not fit in an int are clamped, and draw nothing here.
+  for (float x : {std::numeric_limits<float>::infinity(),
+                  -std::numeric_limits<float>::infinity(), 1e20f, -1e20f}) {
+    char_pos.origin_ = CFX_PointF(x, 12);
+    EXPECT_TRUE(device.DrawNormalText(pdfium::span_from_ref(char_pos), &font,
+                                      /*font_size=*/12, CFX_Matrix(),
+                                      0xff000000, options));
+    for (int row = 0; row < 16; ++row) {
+      for (uint8_t value : bitmap->GetScanline(row)) {
+        ASSERT_EQ(0, value) << x;
+      }
+    }
+  }
+
+  // Within range, the glyph is drawn.
+  char_pos.origin_ = CFX_PointF(2.3f, 12);
+  EXPECT_TRUE(device.DrawNormalText(pdfium::span_from_ref(char_pos), &font,
+                                    /*font_size=*/12, CFX_Matrix(), 0xff000000,
+                                    options));
+  bool drawn = false;
+  for (int row = 0; row < 16; ++row) {
+    for (uint8_t value : bitmap->GetScanline(row)) {
+      drawn |= value != 0;
+    }
+  }
+  EXPECT_TRUE(drawn);
+}
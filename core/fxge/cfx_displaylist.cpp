@@ -0,0 +1,171 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxge/cfx_displaylist.h"
+
+#include <utility>
+
+#include "core/fxge/cfx_renderdevice.h"
+#include "core/fxge/dib/cfx_dibbase.h"
+
+namespace {
+
+std::optional<CFX_Matrix> CopyMatrix(const CFX_Matrix* matrix) {
+  if (!matrix) {
+    return std::nullopt;
+  }
+  return *matrix;
+}
+
+CFX_Matrix GetReplayMatrix(const std::optional<CFX_Matrix>& recorded,
+                           const CFX_Matrix& matrix) {
+  return recorded.has_value() ? recorded.value() * matrix : matrix;
+}
+
+}  // namespace
+
+CFX_DisplayList::CFX_DisplayList(int width, int height)
+    : width_(width), height_(height) {}
+
+CFX_DisplayList::~CFX_DisplayList() = default;
+
+void CFX_DisplayList::SaveState() {
+  ops_.emplace_back(SaveStateOp());
+}
+
+void CFX_DisplayList::RestoreState(bool keep_saved) {
+  ops_.emplace_back(RestoreStateOp{keep_saved});
+}
+
+void CFX_DisplayList::ClipPathFill(const CFX_Path& path,
+                                   const CFX_Matrix* object_to_device,
+                                   const CFX_FillRenderOptions& fill_options) {
+  ops_.emplace_back(
+      ClipPathFillOp{path, CopyMatrix(object_to_device), fill_options});
+}
+
+void CFX_DisplayList::ClipPathStroke(const CFX_Path& path,
+                                     const CFX_Matrix* object_to_device,
+                                     const CFX_GraphStateData* graph_state) {
+  ops_.emplace_back(ClipPathStrokeOp{
+      path, CopyMatrix(object_to_device),
+      graph_state ? *graph_state : CFX_GraphStateData()});
+}
+
+void CFX_DisplayList::DrawPath(const CFX_Path& path,
+                               const CFX_Matrix* object_to_device,
+                               const CFX_GraphStateData* graph_state,
+                               uint32_t fill_color,
+                               uint32_t stroke_color,
+                               const CFX_FillRenderOptions& fill_options) {
+  std::optional<CFX_GraphStateData> graph_state_copy;
+  if (graph_state) {
+    graph_state_copy = *graph_state;
+  }
+  ops_.emplace_back(PathOp{path, CopyMatrix(object_to_device),
+                           std::move(graph_state_copy), fill_color,
+                           stroke_color, fill_options});
+}
+
+void CFX_DisplayList::DrawBitmap(RetainPtr<const CFX_DIBBase> bitmap,
+                                 float alpha,
+                                 uint32_t color,
+                                 const CFX_Matrix& image_matrix,
+                                 const FX_RECT* clip_rect,
+                                 const FXDIB_ResampleOptions& options,
+                                 BlendMode blend_mode) {
+  std::optional<FX_RECT> clip_rect_copy;
+  if (clip_rect) {
+    clip_rect_copy = *clip_rect;
+  }
+  ops_.emplace_back(BitmapOp{std::move(bitmap), alpha, color, image_matrix,
+                             clip_rect_copy, options, blend_mode});
+}
+
+void CFX_DisplayList::DrawText(pdfium::span<const TextCharPos> char_pos,
+                               CFX_Font* font,
+                               const CFX_Matrix& text_to_device,
+                               float font_size,
+                               uint32_t color,
+                               const CFX_TextRenderOptions& options) {
+  ops_.emplace_back(TextOp{
+      std::vector<TextCharPos>(char_pos.begin(), char_pos.end()),
+      UnownedPtr<CFX_Font>(font), text_to_device, font_size, color, options});
+}
+
+void CFX_DisplayList::Replay(CFX_RenderDevice* device,
+                             const CFX_Matrix& matrix) const {
+  CFX_RenderDevice::StateRestorer restorer(device);
+
+  // Only pop states pushed by the recording, so that an unbalanced recording
+  // cannot disturb the state `device` had before the replay.
+  size_t depth = 0;
+  for (const Op& op : ops_) {
+    if (std::holds_alternative<SaveStateOp>(op)) {
+      device->SaveState();
+      ++depth;
+      continue;
+    }
+    if (const auto* restore = std::get_if<RestoreStateOp>(&op)) {
+      if (depth == 0) {
+        continue;
+      }
+      device->RestoreState(restore->keep_saved);
+      if (!restore->keep_saved) {
+        --depth;
+      }
+      continue;
+    }
+    if (const auto* clip = std::get_if<ClipPathFillOp>(&op)) {
+      const CFX_Matrix clip_matrix = GetReplayMatrix(clip->matrix, matrix);
+      device->SetClip_PathFill(clip->path, &clip_matrix, clip->fill_options);
+      continue;
+    }
+    if (const auto* clip = std::get_if<ClipPathStrokeOp>(&op)) {
+      const CFX_Matrix clip_matrix = GetReplayMatrix(clip->matrix, matrix);
+      device->SetClip_PathStroke(clip->path, &clip_matrix, &clip->graph_state);
+      continue;
+    }
+    if (const auto* path = std::get_if<PathOp>(&op)) {
+      const CFX_Matrix path_matrix = GetReplayMatrix(path->matrix, matrix);
+      device->DrawPath(
+          path->path, &path_matrix,
+          path->graph_state.has_value() ? &path->graph_state.value() : nullptr,
+          path->fill_color, path->stroke_color, path->fill_options);
+      continue;
+    }
+    if (const auto* bitmap = std::get_if<BitmapOp>(&op)) {
+      if (bitmap->clip_rect.has_value()) {
+        device->SaveState();
+        CFX_Path clip_path;
+        clip_path.AppendFloatRect(CFX_FloatRect(bitmap->clip_rect.value()));
+        device->SetClip_PathFill(clip_path, &matrix,
+                                 CFX_FillRenderOptions::WindingOptions());
+      }
+      RenderDeviceDriverIface::StartResult result =
+          device->StartDIBitsWithBlend(bitmap->bitmap, bitmap->alpha,
+                                       bitmap->color,
+                                       bitmap->image_matrix * matrix,
+                                       bitmap->options, bitmap->blend_mode);
+      if (result.result == RenderDeviceDriverIface::Result::kSuccess &&
+          result.agg_image_renderer) {
+        while (device->ContinueDIBits(result.agg_image_renderer.get(),
+                                      /*pPause=*/nullptr)) {
+        }
+      }
+      if (bitmap->clip_rect.has_value()) {
+        device->RestoreState(/*bKeepSaved=*/false);
+      }
+      continue;
+    }
+    const auto& text = std::get<TextOp>(op);
+    device->DrawNormalText(text.char_pos, text.font.get(), text.font_size,
+                           text.text_to_device * matrix, text.color,
+                           text.options);
+  }
+  while (depth > 0) {
+    device->RestoreState(/*bKeepSaved=*/false);
+    --depth;
+  }
+}
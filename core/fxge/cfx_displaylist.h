@@ -0,0 +1,152 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FXGE_CFX_DISPLAYLIST_H_
+#define CORE_FXGE_CFX_DISPLAYLIST_H_
+
+#include <stdint.h>
+
+#include <optional>
+#include <variant>
+#include <vector>
+
+#include "core/fxcrt/fx_coordinates.h"
+#include "core/fxcrt/retain_ptr.h"
+#include "core/fxcrt/span.h"
+#include "core/fxcrt/unowned_ptr.h"
+#include "core/fxge/cfx_fillrenderoptions.h"
+#include "core/fxge/cfx_graphstatedata.h"
+#include "core/fxge/cfx_path.h"
+#include "core/fxge/cfx_textrenderoptions.h"
+#include "core/fxge/dib/fx_dib.h"
+#include "core/fxge/text_char_pos.h"
+
+class CFX_DIBBase;
+class CFX_Font;
+class CFX_RenderDevice;
+
+// A recorded sequence of device-level drawing operations, usually produced by
+// CFX_RecordingRenderDevice. Replay() draws the operations onto any other
+// device with an extra transform applied to the recorded device coordinates,
+// so one recording can be drawn again at a different scale or offset without
+// re-interpreting the content that produced it.
+//
+// Paths, clips and text runs are kept as geometry and stay sharp at any scale.
+// Bitmaps are kept at the resolution they were recorded at.
+//
+// The list does not own the fonts used by text runs. Callers must keep them
+// alive for as long as the list may be replayed.
+class CFX_DisplayList {
+ public:
+  CFX_DisplayList(int width, int height);
+  CFX_DisplayList(const CFX_DisplayList&) = delete;
+  CFX_DisplayList& operator=(const CFX_DisplayList&) = delete;
+  ~CFX_DisplayList();
+
+  // Size of the device the operations were recorded against.
+  int GetWidth() const { return width_; }
+  int GetHeight() const { return height_; }
+
+  size_t GetOpCount() const { return ops_.size(); }
+
+  void SaveState();
+  void RestoreState(bool keep_saved);
+  void ClipPathFill(const CFX_Path& path,
+                    const CFX_Matrix* object_to_device,
+                    const CFX_FillRenderOptions& fill_options);
+  void ClipPathStroke(const CFX_Path& path,
+                      const CFX_Matrix* object_to_device,
+                      const CFX_GraphStateData* graph_state);
+  void DrawPath(const CFX_Path& path,
+                const CFX_Matrix* object_to_device,
+                const CFX_GraphStateData* graph_state,
+                uint32_t fill_color,
+                uint32_t stroke_color,
+                const CFX_FillRenderOptions& fill_options);
+
+  // Records `bitmap` mapped onto the device through `image_matrix`, which
+  // maps the unit square to the device the same way image object matrices
+  // do. If `clip_rect` is set, drawing is restricted to it. If `bitmap` is a
+  // mask, `color` is the color to fill it with.
+  void DrawBitmap(RetainPtr<const CFX_DIBBase> bitmap,
+                  float alpha,
+                  uint32_t color,
+                  const CFX_Matrix& image_matrix,
+                  const FX_RECT* clip_rect,
+                  const FXDIB_ResampleOptions& options,
+                  BlendMode blend_mode);
+
+  void DrawText(pdfium::span<const TextCharPos> char_pos,
+                CFX_Font* font,
+                const CFX_Matrix& text_to_device,
+                float font_size,
+                uint32_t color,
+                const CFX_TextRenderOptions& options);
+
+  // Draws the recorded operations onto `device`, with `matrix` mapping the
+  // recorded device space onto the space of `device`. The state of `device`
+  // is the same after the call as before it.
+  void Replay(CFX_RenderDevice* device, const CFX_Matrix& matrix) const;
+
+ private:
+  struct SaveStateOp {};
+
+  struct RestoreStateOp {
+    bool keep_saved;
+  };
+
+  struct ClipPathFillOp {
+    CFX_Path path;
+    std::optional<CFX_Matrix> matrix;
+    CFX_FillRenderOptions fill_options;
+  };
+
+  struct ClipPathStrokeOp {
+    CFX_Path path;
+    std::optional<CFX_Matrix> matrix;
+    CFX_GraphStateData graph_state;
+  };
+
+  struct PathOp {
+    CFX_Path path;
+    std::optional<CFX_Matrix> matrix;
+    std::optional<CFX_GraphStateData> graph_state;
+    uint32_t fill_color;
+    uint32_t stroke_color;
+    CFX_FillRenderOptions fill_options;
+  };
+
+  struct BitmapOp {
+    RetainPtr<const CFX_DIBBase> bitmap;
+    float alpha;
+    uint32_t color;
+    CFX_Matrix image_matrix;
+    std::optional<FX_RECT> clip_rect;
+    FXDIB_ResampleOptions options;
+    BlendMode blend_mode;
+  };
+
+  struct TextOp {
+    std::vector<TextCharPos> char_pos;
+    UnownedPtr<CFX_Font> font;
+    CFX_Matrix text_to_device;
+    float font_size;
+    uint32_t color;
+    CFX_TextRenderOptions options;
+  };
+
+  using Op = std::variant<SaveStateOp,
+                          RestoreStateOp,
+                          ClipPathFillOp,
+                          ClipPathStrokeOp,
+                          PathOp,
+                          BitmapOp,
+                          TextOp>;
+
+  const int width_;
+  const int height_;
+  std::vector<Op> ops_;
+};
+
+#endif  // CORE_FXGE_CFX_DISPLAYLIST_H_
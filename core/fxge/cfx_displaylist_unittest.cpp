@@ -0,0 +1,178 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxge/cfx_displaylist.h"
+
+#include <memory>
+
+#include "core/fxcrt/fx_coordinates.h"
+#include "core/fxcrt/retain_ptr.h"
+#include "core/fxge/cfx_defaultrenderdevice.h"
+#include "core/fxge/cfx_fillrenderoptions.h"
+#include "core/fxge/cfx_graphstatedata.h"
+#include "core/fxge/cfx_path.h"
+#include "core/fxge/cfx_recordingrenderdevice.h"
+#include "core/fxge/dib/cfx_dibitmap.h"
+#include "core/fxge/dib/fx_dib.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+constexpr FX_ARGB kRed = 0xffff0000;
+constexpr FX_ARGB kBlue = 0xff0000ff;
+constexpr FX_ARGB kWhite = 0xffffffff;
+constexpr uint32_t kRgbRed = 0xff0000;
+constexpr uint32_t kRgbWhite = 0xffffff;
+
+// Draws a filled triangle and a stroked line through `device`, with
+// `matrix` applied.
+void DrawShapes(CFX_RenderDevice* device, const CFX_Matrix& matrix) {
+  CFX_Path triangle;
+  triangle.AppendPoint({2, 2}, CFX_Path::Point::Type::kMove);
+  triangle.AppendPoint({14, 3}, CFX_Path::Point::Type::kLine);
+  triangle.AppendPoint({7, 13}, CFX_Path::Point::Type::kLine);
+  triangle.ClosePath();
+  device->DrawPath(triangle, &matrix, nullptr, kRed, 0,
+                   CFX_FillRenderOptions::WindingOptions());
+
+  CFX_Path line;
+  line.AppendPoint({1, 14}, CFX_Path::Point::Type::kMove);
+  line.AppendPoint({15, 9}, CFX_Path::Point::Type::kLine);
+  line.AppendPoint({3, 5}, CFX_Path::Point::Type::kLine);
+  CFX_GraphStateData graph_state;
+  graph_state.set_line_width(1.5f);
+  device->DrawPath(line, &matrix, &graph_state, 0, kBlue,
+                   CFX_FillRenderOptions());
+}
+
+RetainPtr<CFX_DIBitmap> CreateWhiteDevice(CFX_DefaultRenderDevice& device,
+                                          int size) {
+  EXPECT_TRUE(device.Create(size, size, FXDIB_Format::kBgrx));
+  RetainPtr<CFX_DIBitmap> bitmap = device.GetBitmap();
+  bitmap->Clear(kWhite);
+  return bitmap;
+}
+
+// Returns the RGB value of a pixel in a `FXDIB_Format::kBgrx` bitmap.
+uint32_t GetRgb(const RetainPtr<CFX_DIBitmap>& bitmap, int col, int row) {
+  return bitmap->GetScanlineAs<uint32_t>(row)[col] & 0x00ffffff;
+}
+
+void ExpectSameBitmaps(const RetainPtr<CFX_DIBitmap>& expected,
+                       const RetainPtr<CFX_DIBitmap>& actual) {
+  ASSERT_EQ(expected->GetWidth(), actual->GetWidth());
+  ASSERT_EQ(expected->GetHeight(), actual->GetHeight());
+  for (int row = 0; row < expected->GetHeight(); ++row) {
+    for (int col = 0; col < expected->GetWidth(); ++col) {
+      EXPECT_EQ(GetRgb(expected, col, row), GetRgb(actual, col, row))
+          << "at " << col << ", " << row;
+    }
+  }
+}
+
+}  // namespace
+
+TEST(CFXDisplayListTest, RecordingDeviceRecordsOperations) {
+  CFX_RecordingRenderDevice recorder(16, 16);
+  EXPECT_EQ(16, recorder.GetWidth());
+  EXPECT_EQ(16, recorder.GetHeight());
+  EXPECT_FALSE(recorder.GetRenderCaps() & FXRC_GET_BITS);
+
+  recorder.SaveState();
+  EXPECT_TRUE(recorder.SetClip_Rect(FX_RECT(2, 3, 10, 12)));
+  EXPECT_EQ(FX_RECT(2, 3, 10, 12), recorder.GetClipBox());
+  DrawShapes(&recorder, CFX_Matrix());
+  recorder.RestoreState(false);
+  EXPECT_EQ(FX_RECT(0, 0, 16, 16), recorder.GetClipBox());
+
+  std::unique_ptr<CFX_DisplayList> display_list = recorder.TakeDisplayList();
+  ASSERT_TRUE(display_list);
+  EXPECT_EQ(16, display_list->GetWidth());
+  EXPECT_EQ(16, display_list->GetHeight());
+  EXPECT_EQ(5u, display_list->GetOpCount());
+
+  // Recording continues into a fresh list.
+  EXPECT_EQ(0u, recorder.TakeDisplayList()->GetOpCount());
+}
+
+TEST(CFXDisplayListTest, ReplayPathsAtNewScale) {
+  CFX_RecordingRenderDevice recorder(16, 16);
+  DrawShapes(&recorder, CFX_Matrix());
+  std::unique_ptr<CFX_DisplayList> display_list = recorder.TakeDisplayList();
+
+  const CFX_Matrix zoom(3, 0, 0, 3, 1, 2);
+  CFX_DefaultRenderDevice expected_device;
+  RetainPtr<CFX_DIBitmap> expected = CreateWhiteDevice(expected_device, 48);
+  DrawShapes(&expected_device, zoom);
+
+  CFX_DefaultRenderDevice replay_device;
+  RetainPtr<CFX_DIBitmap> actual = CreateWhiteDevice(replay_device, 48);
+  display_list->Replay(&replay_device, zoom);
+
+  ExpectSameBitmaps(expected, actual);
+}
+
+TEST(CFXDisplayListTest, ReplayBitmapsAtNewScale) {
+  auto source = pdfium::MakeRetain<CFX_DIBitmap>();
+  ASSERT_TRUE(source->Create(4, 4, FXDIB_Format::kBgrx));
+  source->Clear(kRed);
+
+  CFX_RecordingRenderDevice recorder(16, 16);
+  EXPECT_TRUE(recorder.SetDIBits(source, 2, 3));
+  std::unique_ptr<CFX_DisplayList> display_list = recorder.TakeDisplayList();
+  ASSERT_EQ(1u, display_list->GetOpCount());
+
+  CFX_DefaultRenderDevice replay_device;
+  RetainPtr<CFX_DIBitmap> actual = CreateWhiteDevice(replay_device, 32);
+  display_list->Replay(&replay_device, CFX_Matrix(2, 0, 0, 2, 0, 0));
+
+  for (int row = 0; row < 32; ++row) {
+    for (int col = 0; col < 32; ++col) {
+      const bool inside = col >= 4 && col < 12 && row >= 6 && row < 14;
+      EXPECT_EQ(inside ? kRgbRed : kRgbWhite, GetRgb(actual, col, row))
+          << "at " << col << ", " << row;
+    }
+  }
+}
+
+TEST(CFXDisplayListTest, ReplayClips) {
+  CFX_RecordingRenderDevice recorder(16, 16);
+  recorder.SaveState();
+  EXPECT_TRUE(recorder.SetClip_Rect(FX_RECT(0, 0, 8, 16)));
+  DrawShapes(&recorder, CFX_Matrix());
+  recorder.RestoreState(false);
+  std::unique_ptr<CFX_DisplayList> display_list = recorder.TakeDisplayList();
+
+  const CFX_Matrix zoom(2, 0, 0, 2, 0, 0);
+  CFX_DefaultRenderDevice expected_device;
+  RetainPtr<CFX_DIBitmap> expected = CreateWhiteDevice(expected_device, 32);
+  expected_device.SaveState();
+  EXPECT_TRUE(expected_device.SetClip_Rect(FX_RECT(0, 0, 16, 32)));
+  DrawShapes(&expected_device, zoom);
+  expected_device.RestoreState(false);
+
+  CFX_DefaultRenderDevice replay_device;
+  RetainPtr<CFX_DIBitmap> actual = CreateWhiteDevice(replay_device, 32);
+  display_list->Replay(&replay_device, zoom);
+
+  ExpectSameBitmaps(expected, actual);
+}
+
+TEST(CFXDisplayListTest, ReplayLeavesDeviceStateUnchanged) {
+  // An unbalanced recording: the clip is never restored.
+  CFX_RecordingRenderDevice recorder(16, 16);
+  recorder.RestoreState(false);
+  recorder.SaveState();
+  EXPECT_TRUE(recorder.SetClip_Rect(FX_RECT(4, 4, 8, 8)));
+  std::unique_ptr<CFX_DisplayList> display_list = recorder.TakeDisplayList();
+
+  CFX_DefaultRenderDevice replay_device;
+  CreateWhiteDevice(replay_device, 16);
+  replay_device.SaveState();
+  EXPECT_TRUE(replay_device.SetClip_Rect(FX_RECT(1, 1, 15, 15)));
+  display_list->Replay(&replay_device, CFX_Matrix());
+  EXPECT_EQ(FX_RECT(1, 1, 15, 15), replay_device.GetClipBox());
+  replay_device.RestoreState(false);
+  EXPECT_EQ(FX_RECT(0, 0, 16, 16), replay_device.GetClipBox());
+}
@@ -20,8 +20,6 @@
 #include "core/fxcrt/numerics/safe_math.h"
 #include "core/fxcrt/span.h"
 #include "core/fxge/cfx_font.h"
-#include "core/fxge/cfx_fontmgr.h"
-#include "core/fxge/cfx_gemodule.h"
 #include "core/fxge/cfx_glyphbitmap.h"
 #include "core/fxge/cfx_path.h"
 #include "core/fxge/cfx_substfont.h"
@@ -436,7 +434,8 @@ std::unique_ptr<CFX_GlyphBitmap> CFX_Face::RenderGlyph(const CFX_Font* pFont,
                                                        bool bFontStyle,
                                                        const CFX_Matrix& matrix,
                                                        int dest_width,
-                                                       int anti_alias) {
+                                                       int anti_alias,
+                                                       int x_offset) {
   FT_Matrix ft_matrix;
   ft_matrix.xx = matrix.a / 64 * 65536;
   ft_matrix.xy = matrix.c / 64 * 65536;
@@ -466,7 +465,9 @@ std::unique_ptr<CFX_GlyphBitmap> CFX_Face::RenderGlyph(const CFX_Font* pFont,
     }
   }
 
-  ScopedFontTransform scoped_transform(pdfium::WrapRetain(this), &ft_matrix);
+  FT_Vector delta = {x_offset, 0};
+  ScopedFontTransform scoped_transform(pdfium::WrapRetain(this), &ft_matrix,
+                                       x_offset ? &delta : nullptr);
   int load_flags = FT_LOAD_NO_BITMAP | FT_LOAD_PEDANTIC;
   if (!IsTtOt()) {
     load_flags |= FT_LOAD_NO_HINTING;
@@ -508,8 +509,6 @@ std::unique_ptr<CFX_GlyphBitmap> CFX_Face::RenderGlyph(const CFX_Font* pFont,
             36655;
     FT_Outline_Embolden(&glyph->outline, level.ValueOrDefault(0));
   }
-  FT_Library_SetLcdFilter(CFX_GEModule::Get()->GetFontMgr()->GetFTLibrary(),
-                          FT_LCD_FILTER_DEFAULT);
   error = FT_Render_Glyph(glyph, static_cast<FT_Render_Mode>(anti_alias));
   if (error) {
     return nullptr;
@@ -563,7 +562,7 @@ std::unique_ptr<CFX_Path> CFX_Face::LoadGlyphPath(
     bool is_vertical,
     const CFX_SubstFont* subst_font) {
   FXFT_FaceRec* rec = GetRec();
-  FT_Set_Pixel_Sizes(rec, 0, 64);
+  SetPixelSize(0, 64);
   FT_Matrix ft_matrix = {65536, 0, 0, 65536};
   if (subst_font) {
     if (subst_font->italic_angle_) {
@@ -578,7 +577,8 @@ std::unique_ptr<CFX_Path> CFX_Face::LoadGlyphPath(
       AdjustVariationParams(glyph_index, dest_width, subst_font->weight_);
     }
   }
-  ScopedFontTransform scoped_transform(pdfium::WrapRetain(this), &ft_matrix);
+  ScopedFontTransform scoped_transform(pdfium::WrapRetain(this), &ft_matrix,
+                                       /*delta=*/nullptr);
   int load_flags = FT_LOAD_NO_BITMAP;
   if (!IsTtOt() || !IsTricky()) {
     load_flags |= FT_LOAD_NO_HINTING;
@@ -788,8 +788,37 @@ bool CFX_Face::SelectCharMap(fxge::FontEncoding encoding) {
 }
 
 bool CFX_Face::SetPixelSize(uint32_t width, uint32_t height) {
-  FT_Error error = FT_Set_Pixel_Sizes(GetRec(), width, height);
-  return !error;
+  // FreeType treats a zero dimension as equal to the other one.
+  if (!width) {
+    width = height;
+  } else if (!height) {
+    height = width;
+  }
+
+  FXFT_FaceRec* rec = GetRec();
+  const std::pair<uint32_t, uint32_t> key(width, height);
+  auto it = pixel_sizes_.find(key);
+  if (it != pixel_sizes_.end()) {
+    return rec->size == it->second || !FT_Activate_Size(it->second);
+  }
+
+  // The first size uses the size object the face comes with.
+  FT_Size old_size = rec->size;
+  FT_Size size = old_size;
+  if (!pixel_sizes_.empty()) {
+    if (FT_New_Size(rec, &size) || FT_Activate_Size(size)) {
+      return false;
+    }
+  }
+  if (FT_Set_Pixel_Sizes(rec, width, height)) {
+    if (size != old_size) {
+      FT_Activate_Size(old_size);
+      FT_Done_Size(size);
+    }
+    return false;
+  }
+  pixel_sizes_[key] = size;
+  return true;
 }
 
 #if BUILDFLAG(IS_WIN)
@@ -8,8 +8,10 @@
 #include <stdint.h>
 
 #include <array>
+#include <map>
 #include <memory>
 #include <optional>
+#include <utility>
 #include <vector>
 
 #include "build/build_config.h"
@@ -81,12 +83,14 @@ class CFX_Face final : public Retainable, public Observable {
   int GetGlyphCount() const;
   // TODO(crbug.com/pdfium/2037): Can this method be private?
   FX_RECT GetGlyphBBox() const;
+  // `x_offset` shifts the glyph right, in 1/64 pixels.
   std::unique_ptr<CFX_GlyphBitmap> RenderGlyph(const CFX_Font* pFont,
                                                uint32_t glyph_index,
                                                bool bFontStyle,
                                                const CFX_Matrix& matrix,
                                                int dest_width,
-                                               int anti_alias);
+                                               int anti_alias,
+                                               int x_offset);
   std::unique_ptr<CFX_Path> LoadGlyphPath(uint32_t glyph_index,
                                           int dest_width,
                                           bool is_vertical,
@@ -114,6 +118,8 @@ class CFX_Face final : public Retainable, public Observable {
   void SetCharMapByIndex(size_t index);
   bool SelectCharMap(fxge::FontEncoding encoding);
 
+  // Each pixel size has its own FreeType size object, so that switching back
+  // to a size does not scale the face, or set up its hinting, again.
   bool SetPixelSize(uint32_t width, uint32_t height);
 
 #if BUILDFLAG(IS_WIN)
@@ -131,6 +137,8 @@ class CFX_Face final : public Retainable, public Observable {
 
   ScopedFXFTFaceRec const rec_;
   RetainPtr<Retainable> const desc_;
+  // Size objects by pixel width and height. FT_Done_Face() frees them.
+  std::map<std::pair<uint32_t, uint32_t>, FT_Size> pixel_sizes_;
 };
 
 #endif  // CORE_FXGE_CFX_FACE_H_
@@ -0,0 +1,40 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxge/cfx_face.h"
+
+#include "core/fxcrt/retain_ptr.h"
+#include "core/fxge/cfx_fontmgr.h"
+#include "core/fxge/cfx_gemodule.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+TEST(CFXFaceTest, PixelSizes) {
+  RetainPtr<CFX_Face> face =
+      CFX_Face::New(CFX_GEModule::Get()->GetFontMgr()->GetFTLibrary(),
+                    /*pDesc=*/nullptr, CFX_FontMgr::GetStandardFont(0),
+                    /*face_index=*/0);
+  ASSERT_TRUE(face);
+  FXFT_FaceRec* rec = face->GetRec();
+
+  ASSERT_TRUE(face->SetPixelSize(0, 64));
+  const FT_Size size_64 = rec->size;
+  EXPECT_EQ(64, rec->size->metrics.x_ppem);
+  EXPECT_EQ(64, rec->size->metrics.y_ppem);
+
+  ASSERT_TRUE(face->SetPixelSize(0, 1000));
+  const FT_Size size_1000 = rec->size;
+  EXPECT_NE(size_64, size_1000);
+  EXPECT_EQ(1000, rec->size->metrics.x_ppem);
+
+  // Switching back reuses the size object, whichever way the size is given.
+  ASSERT_TRUE(face->SetPixelSize(64, 64));
+  EXPECT_EQ(size_64, rec->size);
+  EXPECT_EQ(64, rec->size->metrics.x_ppem);
+  ASSERT_TRUE(face->SetPixelSize(1000, 0));
+  EXPECT_EQ(size_1000, rec->size);
+
+  ASSERT_TRUE(face->SetPixelSize(20, 10));
+  EXPECT_EQ(20, rec->size->metrics.x_ppem);
+  EXPECT_EQ(10, rec->size->metrics.y_ppem);
+}
@@ -13,6 +13,7 @@
 #include <utility>
 
 #include "build/build_config.h"
+#include "core/fxcrt/binary_buffer.h"
 #include "core/fxcrt/byteorder.h"
 #include "core/fxcrt/check_op.h"
 #include "core/fxcrt/compiler_specific.h"
@@ -22,8 +23,12 @@
 #include "core/fxcrt/fx_codepage.h"
 #include "core/fxcrt/fx_extension.h"
 #include "core/fxcrt/fx_folder.h"
+#include "core/fxcrt/fx_random.h"
 #include "core/fxcrt/fx_safe_types.h"
 #include "core/fxcrt/fx_system.h"
+#include "core/fxcrt/numerics/safe_conversions.h"
+#include "core/fxcrt/span_reader.h"
+#include "core/fxcrt/stl_util.h"
 #include "core/fxge/cfx_fontmapper.h"
 #include "core/fxge/fx_font.h"
 
@@ -49,6 +54,24 @@ constexpr auto kBase14Substs = std::to_array<const FontSubst>({
     {"Times-Italic", "Times New Roman Italic"},
 });
 
+// Identifies the serialized catalog format, and its version.
+constexpr char kCatalogMagic[] = "PDFFNC02";
+
+// The charsets that ReportFace() adds faces for, in order.
+struct CharsetFlag {
+  uint32_t flag;
+  FX_Charset charset;
+};
+
+constexpr auto kCharsetFlags = std::to_array<const CharsetFlag>({
+    {CHARSET_FLAG_SHIFTJIS, FX_Charset::kShiftJIS},
+    {CHARSET_FLAG_GB, FX_Charset::kChineseSimplified},
+    {CHARSET_FLAG_BIG5, FX_Charset::kChineseTraditional},
+    {CHARSET_FLAG_KOREAN, FX_Charset::kHangul},
+    {CHARSET_FLAG_SYMBOL, FX_Charset::kSymbol},
+    {CHARSET_FLAG_ANSI, FX_Charset::kANSI},
+});
+
 // Used with std::unique_ptr to automatically call fclose().
 struct FxFileCloser {
   inline void operator()(FILE* h) const {
@@ -137,6 +160,22 @@ uint32_t GetCharset(FX_Charset charset) {
   return 0;
 }
 
+void AppendUint32(BinaryBuffer& buffer, uint32_t value) {
+  std::array<uint8_t, 4> bytes;
+  fxcrt::PutUInt32LSBFirst(value, bytes);
+  buffer.AppendSpan(bytes);
+}
+
+void AppendUint64(BinaryBuffer& buffer, uint64_t value) {
+  AppendUint32(buffer, static_cast<uint32_t>(value));
+  AppendUint32(buffer, static_cast<uint32_t>(value >> 32));
+}
+
+void AppendString(BinaryBuffer& buffer, const ByteString& str) {
+  AppendUint32(buffer, pdfium::checked_cast<uint32_t>(str.GetLength()));
+  buffer.AppendString(str);
+}
+
 }  // namespace
 
 CFX_FolderFontInfo::CFX_FolderFontInfo() = default;
@@ -147,11 +186,154 @@ void CFX_FolderFontInfo::AddPath(const ByteString& path) {
   path_list_.push_back(path);
 }
 
+void CFX_FolderFontInfo::SetCatalogPath(const ByteString& path) {
+  catalog_path_ = path;
+}
+
+bool CFX_FolderFontInfo::LoadCatalog(pdfium::span<const uint8_t> data) {
+  SpanReader reader(data);
+  const ByteStringView magic(kCatalogMagic);
+  std::optional<pdfium::span<const uint8_t>> header =
+      reader.ReadBytes(magic.GetLength());
+  if (!header.has_value() || ByteStringView(header.value()) != magic) {
+    return false;
+  }
+
+  std::optional<uint32_t> file_count = reader.ReadUint32();
+  if (!file_count.has_value()) {
+    return false;
+  }
+
+  std::map<ByteString, CatalogEntry> catalog;
+  for (uint32_t i = 0; i < file_count.value(); ++i) {
+    std::optional<pdfium::span<const uint8_t>> path = reader.ReadSizedBytes();
+    std::optional<uint64_t> size = reader.ReadUint64();
+    std::optional<uint64_t> modified_time = reader.ReadUint64();
+    std::optional<uint32_t> face_count = reader.ReadUint32();
+    if (!path.has_value() || !size.has_value() ||
+        !modified_time.has_value() || !face_count.has_value()) {
+      return false;
+    }
+    const ByteString path_str(ByteStringView(path.value()));
+    if (pdfium::Contains(catalog, path_str)) {
+      return false;
+    }
+
+    CatalogEntry& entry = catalog[path_str];
+    entry.stamp.size = size.value();
+    entry.stamp.modified_time = static_cast<int64_t>(modified_time.value());
+    for (uint32_t j = 0; j < face_count.value(); ++j) {
+      std::optional<pdfium::span<const uint8_t>> face_name =
+          reader.ReadSizedBytes();
+      std::optional<pdfium::span<const uint8_t>> font_tables =
+          reader.ReadSizedBytes();
+      std::optional<uint32_t> font_offset = reader.ReadUint32();
+      std::optional<uint32_t> file_size = reader.ReadUint32();
+      std::optional<uint32_t> styles = reader.ReadUint32();
+      std::optional<uint32_t> charsets = reader.ReadUint32();
+      if (!face_name.has_value() || !font_tables.has_value() ||
+          !font_offset.has_value() || !file_size.has_value() ||
+          !styles.has_value() || !charsets.has_value() ||
+          face_name.value().empty()) {
+        return false;
+      }
+      entry.faces.push_back({ByteString(ByteStringView(face_name.value())),
+                             ByteString(ByteStringView(font_tables.value())),
+                             font_offset.value(), file_size.value(),
+                             styles.value(), charsets.value()});
+    }
+  }
+  if (!reader.IsAtEnd()) {
+    return false;
+  }
+  catalog_ = std::move(catalog);
+  return true;
+}
+
+DataVector<uint8_t> CFX_FolderFontInfo::SerializeCatalog() const {
+  BinaryBuffer buffer;
+  buffer.AppendSpan(ByteStringView(kCatalogMagic).unsigned_span());
+  AppendUint32(buffer, fxcrt::CollectionSize<uint32_t>(catalog_));
+  for (const auto& [path, entry] : catalog_) {
+    AppendString(buffer, path);
+    AppendUint64(buffer, entry.stamp.size);
+    AppendUint64(buffer, static_cast<uint64_t>(entry.stamp.modified_time));
+    AppendUint32(buffer, fxcrt::CollectionSize<uint32_t>(entry.faces));
+    for (const FaceRecord& face : entry.faces) {
+      AppendString(buffer, face.face_name);
+      AppendString(buffer, face.font_tables);
+      AppendUint32(buffer, face.font_offset);
+      AppendUint32(buffer, face.file_size);
+      AppendUint32(buffer, face.styles);
+      AppendUint32(buffer, face.charsets);
+    }
+  }
+  return buffer.DetachBuffer();
+}
+
 void CFX_FolderFontInfo::EnumFontList(CFX_FontMapper* pMapper) {
   mapper_ = pMapper;
+  if (!catalog_path_.IsEmpty()) {
+    ReadCatalogFile();
+  }
+
+  scanned_files_.clear();
+  catalog_changed_ = false;
   for (const auto& path : path_list_) {
     ScanPath(path);
   }
+
+  // Every file found in the catalog is in `scanned_files_`, so the catalog
+  // lost files if it is larger.
+  catalog_changed_ |= scanned_files_.size() != catalog_.size();
+  catalog_ = std::move(scanned_files_);
+  scanned_files_.clear();
+  if (!catalog_path_.IsEmpty() && catalog_changed_) {
+    WriteCatalogFile();
+  }
+}
+
+void CFX_FolderFontInfo::ReadCatalogFile() {
+  std::unique_ptr<FILE, FxFileCloser> pFile(fopen(catalog_path_.c_str(), "rb"));
+  if (!pFile || fseek(pFile.get(), 0, SEEK_END) < 0) {
+    return;
+  }
+
+  long size = ftell(pFile.get());
+  if (size <= 0 || fseek(pFile.get(), 0, SEEK_SET) < 0) {
+    return;
+  }
+
+  DataVector<uint8_t> data(static_cast<size_t>(size));
+  if (UNSAFE_TODO(fread(data.data(), data.size(), 1, pFile.get())) != 1) {
+    return;
+  }
+  LoadCatalog(data);
+}
+
+void CFX_FolderFontInfo::WriteCatalogFile() const {
+  // Write to a temporary file first, so that a reader never sees a partial
+  // catalog. Other processes may be writing the catalog at the same time, so
+  // the name is random, and the file must not exist yet.
+  std::array<uint32_t, 2> suffix;
+  FX_Random_GenerateMT(suffix);
+  const ByteString temp_path =
+      catalog_path_ + ByteString::Format(".%08x%08x.tmp", suffix[0], suffix[1]);
+  const DataVector<uint8_t> data = SerializeCatalog();
+  std::unique_ptr<FILE, FxFileCloser> pFile(fopen(temp_path.c_str(), "wbx"));
+  if (!pFile) {
+    return;
+  }
+  const bool written =
+      UNSAFE_TODO(fwrite(data.data(), data.size(), 1, pFile.get())) == 1;
+  // Closing flushes the data, which can fail too.
+  if (fclose(pFile.release()) != 0 || !written) {
+    remove(temp_path.c_str());
+    return;
+  }
+  if (rename(temp_path.c_str(), catalog_path_.c_str()) != 0) {
+    remove(temp_path.c_str());
+  }
 }
 
 void CFX_FolderFontInfo::ScanPath(const ByteString& path) {
@@ -162,7 +344,8 @@ void CFX_FolderFontInfo::ScanPath(const ByteString& path) {
 
   ByteString filename;
   bool bFolder;
-  while (handle->GetNextFile(&filename, &bFolder)) {
+  FX_Folder::FileStamp stamp;
+  while (handle->GetNextFile(&filename, &bFolder, &stamp)) {
     if (bFolder) {
       if (filename == "." || filename == "..") {
         continue;
@@ -183,14 +366,37 @@ void CFX_FolderFontInfo::ScanPath(const ByteString& path) {
 #endif
 
     fullpath += filename;
-    bFolder ? ScanPath(fullpath) : ScanFile(fullpath);
+    bFolder ? ScanPath(fullpath) : ScanFile(fullpath, stamp);
   }
 }
 
-void CFX_FolderFontInfo::ScanFile(const ByteString& path) {
+void CFX_FolderFontInfo::ScanFile(const ByteString& path,
+                                  const FX_Folder::FileStamp& stamp) {
+  if (pdfium::Contains(scanned_files_, path)) {
+    return;
+  }
+
+  CatalogEntry& entry = scanned_files_[path];
+  entry.stamp = stamp;
+  auto it = catalog_.find(path);
+  if (it != catalog_.end() && it->second.stamp == stamp) {
+    entry.faces = std::move(it->second.faces);
+  } else {
+    entry.faces = ReadFaces(path);
+    catalog_changed_ = true;
+  }
+  for (const FaceRecord& face : entry.faces) {
+    ReportFace(path, face);
+  }
+}
+
+// static
+std::vector<CFX_FolderFontInfo::FaceRecord> CFX_FolderFontInfo::ReadFaces(
+    const ByteString& path) {
+  std::vector<FaceRecord> faces;
   std::unique_ptr<FILE, FxFileCloser> pFile(fopen(path.c_str(), "rb"));
   if (!pFile) {
-    return;
+    return faces;
   }
 
   fseek(pFile.get(), 0, SEEK_END);
@@ -203,12 +409,15 @@ void CFX_FolderFontInfo::ScanFile(const ByteString& path) {
   size_t items_read =
       UNSAFE_BUFFERS(fread(buffer, /*size=*/12, /*nmemb=*/1, pFile.get()));
   if (items_read != 1) {
-    return;
+    return faces;
   }
   uint32_t magic = fxcrt::GetUInt32MSBFirst(pdfium::span(buffer).first<4u>());
   if (magic != kTableTTCF) {
-    ReportFace(path, pFile.get(), filesize, 0);
-    return;
+    std::optional<FaceRecord> face = ReadFace(pFile.get(), filesize, 0);
+    if (face.has_value()) {
+      faces.push_back(std::move(face.value()));
+    }
+    return faces;
   }
 
   uint32_t nFaces =
@@ -216,7 +425,7 @@ void CFX_FolderFontInfo::ScanFile(const ByteString& path) {
   FX_SAFE_SIZE_T safe_face_bytes = nFaces;
   safe_face_bytes *= 4;
   if (!safe_face_bytes.IsValid()) {
-    return;
+    return faces;
   }
 
   auto offsets =
@@ -225,34 +434,39 @@ void CFX_FolderFontInfo::ScanFile(const ByteString& path) {
   items_read = UNSAFE_TODO(fread(offsets_span.data(), /*size=*/1,
                                  /*nmemb=*/offsets_span.size(), pFile.get()));
   if (items_read != offsets_span.size()) {
-    return;
+    return faces;
   }
 
   for (uint32_t i = 0; i < nFaces; i++) {
-    ReportFace(
-        path, pFile.get(), filesize,
+    std::optional<FaceRecord> face = ReadFace(
+        pFile.get(), filesize,
         fxcrt::GetUInt32MSBFirst(offsets_span.subspan(i * 4).first<4u>()));
+    if (face.has_value()) {
+      faces.push_back(std::move(face.value()));
+    }
   }
+  return faces;
 }
 
-void CFX_FolderFontInfo::ReportFace(const ByteString& path,
-                                    FILE* pFile,
-                                    FX_FILESIZE filesize,
-                                    uint32_t offset) {
+// static
+std::optional<CFX_FolderFontInfo::FaceRecord> CFX_FolderFontInfo::ReadFace(
+    FILE* pFile,
+    FX_FILESIZE filesize,
+    uint32_t offset) {
   char buffer[16];
   if (fseek(pFile, offset, SEEK_SET) < 0) {
-    return;
+    return std::nullopt;
   }
   // SAFTEY: 12 byt read fits in 16 byte buffer.
   if (UNSAFE_BUFFERS(!fread(buffer, 12, 1, pFile))) {
-    return;
+    return std::nullopt;
   }
 
   uint32_t nTables =
       fxcrt::GetUInt16MSBFirst(pdfium::as_byte_span(buffer).subspan<4, 2>());
   ByteString tables = ReadStringFromFile(pFile, nTables * 16);
   if (tables.IsEmpty()) {
-    return;
+    return std::nullopt;
   }
 
   static constexpr uint32_t kNameTag =
@@ -260,12 +474,12 @@ void CFX_FolderFontInfo::ReportFace(const ByteString& path,
   ByteString names = LoadTableFromTT(pFile, tables.unsigned_str(), nTables,
                                      kNameTag, filesize);
   if (names.IsEmpty()) {
-    return;
+    return std::nullopt;
   }
 
   ByteString facename = GetNameFromTT(names.unsigned_span(), 1);
   if (facename.IsEmpty()) {
-    return;
+    return std::nullopt;
   }
 
   ByteString style = GetNameFromTT(names.unsigned_span(), 2);
@@ -273,12 +487,8 @@ void CFX_FolderFontInfo::ReportFace(const ByteString& path,
     facename += " " + style;
   }
 
-  if (pdfium::Contains(font_list_, facename)) {
-    return;
-  }
-
-  auto pInfo =
-      std::make_unique<FontFaceInfo>(path, facename, tables, offset, filesize);
+  FaceRecord face = {facename, tables, offset,
+                     static_cast<uint32_t>(filesize), 0, 0};
   static constexpr uint32_t kOs2Tag =
       CFX_FontMapper::MakeTag('O', 'S', '/', '2');
   ByteString os2 =
@@ -287,40 +497,51 @@ void CFX_FolderFontInfo::ReportFace(const ByteString& path,
     pdfium::span<const uint8_t> p = os2.unsigned_span().subspan(78u);
     uint32_t codepages = fxcrt::GetUInt32MSBFirst(p.first<4u>());
     if (codepages & (1U << 17)) {
-      mapper_->AddInstalledFont(facename, FX_Charset::kShiftJIS);
-      pInfo->charsets_ |= CHARSET_FLAG_SHIFTJIS;
+      face.charsets |= CHARSET_FLAG_SHIFTJIS;
     }
     if (codepages & (1U << 18)) {
-      mapper_->AddInstalledFont(facename, FX_Charset::kChineseSimplified);
-      pInfo->charsets_ |= CHARSET_FLAG_GB;
+      face.charsets |= CHARSET_FLAG_GB;
     }
     if (codepages & (1U << 20)) {
-      mapper_->AddInstalledFont(facename, FX_Charset::kChineseTraditional);
-      pInfo->charsets_ |= CHARSET_FLAG_BIG5;
+      face.charsets |= CHARSET_FLAG_BIG5;
     }
     if ((codepages & (1U << 19)) || (codepages & (1U << 21))) {
-      mapper_->AddInstalledFont(facename, FX_Charset::kHangul);
-      pInfo->charsets_ |= CHARSET_FLAG_KOREAN;
+      face.charsets |= CHARSET_FLAG_KOREAN;
     }
     if (codepages & (1U << 31)) {
-      mapper_->AddInstalledFont(facename, FX_Charset::kSymbol);
-      pInfo->charsets_ |= CHARSET_FLAG_SYMBOL;
+      face.charsets |= CHARSET_FLAG_SYMBOL;
     }
   }
-  mapper_->AddInstalledFont(facename, FX_Charset::kANSI);
-  pInfo->charsets_ |= CHARSET_FLAG_ANSI;
-  pInfo->styles_ = 0;
+  face.charsets |= CHARSET_FLAG_ANSI;
   if (style.Contains("Bold")) {
-    pInfo->styles_ |= pdfium::kFontStyleForceBold;
+    face.styles |= pdfium::kFontStyleForceBold;
   }
   if (style.Contains("Italic") || style.Contains("Oblique")) {
-    pInfo->styles_ |= pdfium::kFontStyleItalic;
+    face.styles |= pdfium::kFontStyleItalic;
   }
   if (facename.Contains("Serif")) {
-    pInfo->styles_ |= pdfium::kFontStyleSerif;
+    face.styles |= pdfium::kFontStyleSerif;
+  }
+  return face;
+}
+
+void CFX_FolderFontInfo::ReportFace(const ByteString& path,
+                                    const FaceRecord& face) {
+  if (pdfium::Contains(font_list_, face.face_name)) {
+    return;
   }
 
-  font_list_[facename] = std::move(pInfo);
+  auto pInfo = std::make_unique<FontFaceInfo>(path, face.face_name,
+                                              face.font_tables,
+                                              face.font_offset, face.file_size);
+  for (const CharsetFlag& charset_flag : kCharsetFlags) {
+    if (face.charsets & charset_flag.flag) {
+      mapper_->AddInstalledFont(face.face_name, charset_flag.charset);
+    }
+  }
+  pInfo->charsets_ = face.charsets;
+  pInfo->styles_ = face.styles;
+  font_list_[face.face_name] = std::move(pInfo);
 }
 
 void* CFX_FolderFontInfo::GetSubstFont(const ByteString& face) {
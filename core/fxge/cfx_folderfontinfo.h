@@ -9,9 +9,12 @@
 
 #include <map>
 #include <memory>
+#include <optional>
 #include <vector>
 
+#include "core/fxcrt/data_vector.h"
 #include "core/fxcrt/fx_codepage_forward.h"
+#include "core/fxcrt/fx_folder.h"
 #include "core/fxcrt/unowned_ptr.h"
 #include "core/fxge/cfx_fontmapper.h"
 #include "core/fxge/systemfontinfo_iface.h"
@@ -30,6 +33,20 @@ class CFX_FolderFontInfo : public SystemFontInfoIface {
 
   void AddPath(const ByteString& path);
 
+  // Makes EnumFontList() start from the catalog in the file at `path`, and
+  // write the catalog back to it when any font file was added, changed or
+  // removed.
+  void SetCatalogPath(const ByteString& path);
+
+  // Loads a catalog returned by SerializeCatalog(). EnumFontList() then takes
+  // the faces of each font file from the catalog, and only parses the files
+  // that are not in it, or that changed since. Returns false, and loads
+  // nothing, if `data` is not a catalog.
+  bool LoadCatalog(pdfium::span<const uint8_t> data);
+
+  // Returns the catalog of the font files found by the last EnumFontList().
+  DataVector<uint8_t> SerializeCatalog() const;
+
   // SystemFontInfoIface:
   void EnumFontList(CFX_FontMapper* pMapper) override;
   void* MapFont(int weight,
@@ -73,12 +90,31 @@ class CFX_FolderFontInfo : public SystemFontInfoIface {
     uint32_t charsets_ = 0;
   };
 
+  // What EnumFontList() needs from a face in a font file.
+  struct FaceRecord {
+    ByteString face_name;
+    ByteString font_tables;
+    uint32_t font_offset;
+    uint32_t file_size;
+    uint32_t styles;
+    uint32_t charsets;
+  };
+
+  struct CatalogEntry {
+    FX_Folder::FileStamp stamp;
+    std::vector<FaceRecord> faces;
+  };
+
+  static std::vector<FaceRecord> ReadFaces(const ByteString& path);
+  static std::optional<FaceRecord> ReadFace(FILE* pFile,
+                                            FX_FILESIZE filesize,
+                                            uint32_t offset);
+
+  void ReadCatalogFile();
+  void WriteCatalogFile() const;
   void ScanPath(const ByteString& path);
-  void ScanFile(const ByteString& path);
-  void ReportFace(const ByteString& path,
-                  FILE* pFile,
-                  FX_FILESIZE filesize,
-                  uint32_t offset);
+  void ScanFile(const ByteString& path, const FX_Folder::FileStamp& stamp);
+  void ReportFace(const ByteString& path, const FaceRecord& face);
   void* GetSubstFont(const ByteString& face);
   void* FindFont(int weight,
                  bool bItalic,
@@ -90,6 +126,11 @@ class CFX_FolderFontInfo : public SystemFontInfoIface {
   std::map<ByteString, std::unique_ptr<FontFaceInfo>> font_list_;
   std::vector<ByteString> path_list_;
   UnownedPtr<CFX_FontMapper> mapper_;
+  ByteString catalog_path_;
+  // Keyed by file path.
+  std::map<ByteString, CatalogEntry> catalog_;
+  std::map<ByteString, CatalogEntry> scanned_files_;
+  bool catalog_changed_ = false;
 };
 
 #endif  // CORE_FXGE_CFX_FOLDERFONTINFO_H_
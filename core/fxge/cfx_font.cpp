@@ -288,11 +288,12 @@ bool CFX_Font::LoadEmbedded(pdfium::span<const uint8_t> src_span,
                             uint64_t object_tag) {
   vertical_ = force_vertical;
   object_tag_ = object_tag;
-  font_data_allocation_ = DataVector<uint8_t>(src_span.begin(), src_span.end());
-  face_ = CFX_GEModule::Get()->GetFontMgr()->NewFixedFace(
-      nullptr, font_data_allocation_, 0);
-  font_data_ = font_data_allocation_;
-  return !!face_;
+  face_ = CFX_GEModule::Get()->GetFontCache()->GetEmbeddedFace(src_span);
+  if (!face_) {
+    return false;
+  }
+  font_data_ = face_->GetData();
+  return true;
 }
 
 bool CFX_Font::IsTTFont() const {
@@ -319,13 +320,13 @@ std::optional<FX_RECT> CFX_Font::GetGlyphBBox(uint32_t glyph_index) {
   }
 
   if (face_->IsTricky()) {
-    int error = FT_Set_Char_Size(face_->GetRec(), 0, 1000 * 64, 72, 72);
-    if (error) {
+    // 1000 points at 72 DPI.
+    if (!face_->SetPixelSize(0, 1000)) {
       return std::nullopt;
     }
 
-    error = FT_Load_Glyph(face_->GetRec(), glyph_index,
-                          FT_LOAD_IGNORE_GLOBAL_ADVANCE_WIDTH);
+    int error = FT_Load_Glyph(face_->GetRec(), glyph_index,
+                              FT_LOAD_IGNORE_GLOBAL_ADVANCE_WIDTH);
     if (error) {
       return std::nullopt;
     }
@@ -495,10 +496,11 @@ const CFX_GlyphBitmap* CFX_Font::LoadGlyphBitmap(
     const CFX_Matrix& matrix,
     int dest_width,
     int anti_alias,
+    int subpixel_x,
     CFX_TextRenderOptions* text_options) const {
-  return GetOrCreateGlyphCache()->LoadGlyphBitmap(this, glyph_index, bFontStyle,
-                                                  matrix, dest_width,
-                                                  anti_alias, text_options);
+  return GetOrCreateGlyphCache()->LoadGlyphBitmap(
+      this, glyph_index, bFontStyle, matrix, dest_width, anti_alias, subpixel_x,
+      text_options);
 }
 
 const CFX_Path* CFX_Font::LoadGlyphPath(uint32_t glyph_index,
@@ -506,6 +508,12 @@ const CFX_Path* CFX_Font::LoadGlyphPath(uint32_t glyph_index,
   return GetOrCreateGlyphCache()->LoadGlyphPath(this, glyph_index, dest_width);
 }
 
+const CFX_GlyphOutline* CFX_Font::LoadGlyphOutline(uint32_t glyph_index,
+                                                   int dest_width) const {
+  return GetOrCreateGlyphCache()->LoadGlyphOutline(this, glyph_index,
+                                                   dest_width);
+}
+
 #if defined(PDF_USE_SKIA)
 CFX_TypeFace* CFX_Font::GetDeviceCache() const {
   return GetOrCreateGlyphCache()->GetDeviceCache(this);
@@ -30,6 +30,7 @@
 
 class CFX_GlyphBitmap;
 class CFX_GlyphCache;
+class CFX_GlyphOutline;
 class CFX_Path;
 class CFX_SubstFont;
 class IFX_SeekableReadStream;
@@ -93,8 +94,12 @@ class CFX_Font {
       const CFX_Matrix& matrix,
       int dest_width,
       int anti_alias,
+      int subpixel_x,
       CFX_TextRenderOptions* text_options) const;
   const CFX_Path* LoadGlyphPath(uint32_t glyph_index, int dest_width) const;
+  // Only valid until the next call. Used to draw glyphs as paths.
+  const CFX_GlyphOutline* LoadGlyphOutline(uint32_t glyph_index,
+                                           int dest_width) const;
   int GetGlyphWidth(uint32_t glyph_index) const;
   int GetGlyphWidth(uint32_t glyph_index, int dest_width, int weight) const;
   int GetAscent() const;
@@ -150,7 +155,6 @@ class CFX_Font {
   mutable RetainPtr<CFX_Face> face_;
   mutable RetainPtr<CFX_GlyphCache> glyph_cache_;
   std::unique_ptr<CFX_SubstFont> subst_font_;
-  DataVector<uint8_t> font_data_allocation_;
   pdfium::raw_span<uint8_t> font_data_;
   FontType font_type_ = FontType::kUnknown;
   uint64_t object_tag_ = 0;
@@ -6,11 +6,22 @@
 
 #include "core/fxge/cfx_fontcache.h"
 
+#include <algorithm>
+#include <utility>
+
+#include "core/fxcrt/bytestring.h"
+#include "core/fxcrt/fixed_size_data_vector.h"
+#include "core/fxcrt/stl_util.h"
 #include "core/fxge/cfx_font.h"
+#include "core/fxge/cfx_gemodule.h"
 #include "core/fxge/cfx_glyphcache.h"
 #include "core/fxge/fx_font.h"
 
-CFX_FontCache::CFX_FontCache() = default;
+CFX_FontCache::CFX_FontCache()
+    : CFX_FontCache(kDefaultMaxEmbeddedFontBytes) {}
+
+CFX_FontCache::CFX_FontCache(size_t max_embedded_font_bytes)
+    : max_embedded_font_bytes_(max_embedded_font_bytes) {}
 
 CFX_FontCache::~CFX_FontCache() = default;
 
@@ -33,3 +44,160 @@ CFX_TypeFace* CFX_FontCache::GetDeviceCache(const CFX_Font* pFont) {
   return GetGlyphCache(pFont)->GetDeviceCache(pFont);
 }
 #endif
+
+RetainPtr<CFX_Face> CFX_FontCache::GetEmbeddedFace(
+    pdfium::span<const uint8_t> data) {
+  ++embedded_font_use_count_;
+  const EmbeddedFontKey key(data.size(),
+                            FX_HashCode_GetA(ByteStringView(data)));
+  auto it = embedded_fonts_.find(key);
+  if (it != embedded_fonts_.end()) {
+    for (EmbeddedFont& font : it->second) {
+      if (!std::ranges::equal(font.desc->FontData(), data)) {
+        continue;
+      }
+
+      ++embedded_font_stats_.programs_shared;
+      font.last_use = embedded_font_use_count_;
+      for (SharedFace& shared_face : font.faces) {
+        if (!IsIdle(shared_face)) {
+          continue;
+        }
+        // Undo what the last font did to the face.
+        shared_face.face->SetCharMap(shared_face.initial_charmap);
+        shared_face.face->SetPixelSize(64, 64);
+        ++embedded_font_stats_.faces_reused;
+        return pdfium::WrapRetain(shared_face.face.get());
+      }
+      return NewSharedFace(font);
+    }
+  }
+
+  ++embedded_font_stats_.programs_loaded;
+  auto font_data = FixedSizeDataVector<uint8_t>::Uninit(data.size());
+  fxcrt::Copy(data, font_data.span());
+  auto desc = pdfium::MakeRetain<CFX_FontMgr::FontDesc>(std::move(font_data));
+  if (data.size() <= max_embedded_font_bytes_) {
+    TrimEmbeddedFontsTo(max_embedded_font_bytes_ - data.size());
+  }
+  if (GetEmbeddedFontBytes() + data.size() > max_embedded_font_bytes_) {
+    // Too large to keep, so the face is not shared.
+    pdfium::span<const uint8_t> desc_data = desc->FontData();
+    return CFX_GEModule::Get()->GetFontMgr()->NewFixedFace(std::move(desc),
+                                                           desc_data, 0);
+  }
+
+  std::vector<EmbeddedFont>& fonts = embedded_fonts_[key];
+  fonts.push_back({std::move(desc), {}, embedded_font_use_count_});
+  RetainPtr<CFX_Face> face = NewSharedFace(fonts.back());
+  if (!face) {
+    fonts.pop_back();
+    if (fonts.empty()) {
+      embedded_fonts_.erase(key);
+    }
+    return nullptr;
+  }
+  embedded_program_bytes_ += data.size();
+  return face;
+}
+
+void CFX_FontCache::TrimEmbeddedFonts() {
+  TrimEmbeddedFontsTo(max_embedded_font_bytes_);
+}
+
+void CFX_FontCache::ReleaseUnusedEmbeddedFonts() {
+  TrimEmbeddedFontsTo(0);
+}
+
+size_t CFX_FontCache::GetEmbeddedFontBytes() const {
+  size_t bytes = embedded_program_bytes_;
+  for (const auto& [key, fonts] : embedded_fonts_) {
+    for (const EmbeddedFont& font : fonts) {
+      bytes += GetGlyphCacheBytes(font);
+    }
+  }
+  return bytes;
+}
+
+void CFX_FontCache::TrimEmbeddedFontsTo(size_t target_bytes) {
+  // Keep one idle face of each program, unless the whole program goes.
+  for (auto& [key, fonts] : embedded_fonts_) {
+    for (EmbeddedFont& font : fonts) {
+      bool kept_idle_face = false;
+      std::erase_if(font.faces, [&kept_idle_face](const SharedFace& face) {
+        if (!IsIdle(face)) {
+          return false;
+        }
+        const bool erase = kept_idle_face;
+        kept_idle_face = true;
+        return erase;
+      });
+    }
+  }
+
+  // Release idle programs, least recently used first.
+  size_t bytes = GetEmbeddedFontBytes();
+  while (bytes > target_bytes) {
+    auto oldest_it = embedded_fonts_.end();
+    size_t oldest_index = 0;
+    for (auto it = embedded_fonts_.begin(); it != embedded_fonts_.end(); ++it) {
+      for (size_t i = 0; i < it->second.size(); ++i) {
+        const EmbeddedFont& font = it->second[i];
+        if (IsIdle(font) &&
+            (oldest_it == embedded_fonts_.end() ||
+             font.last_use < oldest_it->second[oldest_index].last_use)) {
+          oldest_it = it;
+          oldest_index = i;
+        }
+      }
+    }
+    if (oldest_it == embedded_fonts_.end()) {
+      return;
+    }
+
+    std::vector<EmbeddedFont>& fonts = oldest_it->second;
+    const size_t program_bytes = std::get<0>(oldest_it->first);
+    bytes -= program_bytes + GetGlyphCacheBytes(fonts[oldest_index]);
+    embedded_program_bytes_ -= program_bytes;
+    fonts.erase(fonts.begin() + oldest_index);
+    if (fonts.empty()) {
+      embedded_fonts_.erase(oldest_it);
+    }
+  }
+}
+
+// static
+bool CFX_FontCache::IsIdle(const SharedFace& shared_face) {
+  return shared_face.glyph_cache->HasOneRef() &&
+         shared_face.face->HasOneRef();
+}
+
+// static
+bool CFX_FontCache::IsIdle(const EmbeddedFont& font) {
+  return std::ranges::all_of(
+      font.faces, [](const SharedFace& face) { return IsIdle(face); });
+}
+
+// static
+size_t CFX_FontCache::GetGlyphCacheBytes(const EmbeddedFont& font) {
+  size_t bytes = 0;
+  for (const SharedFace& face : font.faces) {
+    bytes += face.glyph_cache->GetMemorySize();
+  }
+  return bytes;
+}
+
+RetainPtr<CFX_Face> CFX_FontCache::NewSharedFace(EmbeddedFont& font) {
+  RetainPtr<CFX_Face> face = CFX_GEModule::Get()->GetFontMgr()->NewFixedFace(
+      font.desc, font.desc->FontData(), 0);
+  if (!face) {
+    return nullptr;
+  }
+
+  auto glyph_cache = pdfium::MakeRetain<CFX_GlyphCache>(face);
+  glyph_cache_map_[face.Get()].Reset(glyph_cache.Get());
+  CFX_Face::CharMap initial_charmap = face->GetCurrentCharMap();
+  font.faces.push_back({std::move(glyph_cache),
+                        UnownedPtr<CFX_Face>(face.Get()), initial_charmap});
+  return face;
+}
@@ -7,17 +7,35 @@
 #ifndef CORE_FXGE_CFX_FONTCACHE_H_
 #define CORE_FXGE_CFX_FONTCACHE_H_
 
+#include <stddef.h>
+#include <stdint.h>
+
 #include <map>
+#include <tuple>
+#include <vector>
 
 #include "core/fxcrt/fx_system.h"
 #include "core/fxcrt/retain_ptr.h"
+#include "core/fxcrt/span.h"
+#include "core/fxcrt/unowned_ptr.h"
+#include "core/fxge/cfx_face.h"
+#include "core/fxge/cfx_fontmgr.h"
 #include "core/fxge/cfx_glyphcache.h"
 
 class CFX_Font;
 
 class CFX_FontCache {
  public:
+  struct EmbeddedFontStats {
+    size_t programs_loaded = 0;
+    size_t programs_shared = 0;
+    size_t faces_reused = 0;
+  };
+
+  static constexpr size_t kDefaultMaxEmbeddedFontBytes = 64 * 1024 * 1024;
+
   CFX_FontCache();
+  explicit CFX_FontCache(size_t max_embedded_font_bytes);
   ~CFX_FontCache();
 
   RetainPtr<CFX_GlyphCache> GetGlyphCache(const CFX_Font* pFont);
@@ -25,9 +43,63 @@ class CFX_FontCache {
   CFX_TypeFace* GetDeviceCache(const CFX_Font* pFont);
 #endif
 
+  // Returns a face for the embedded font program `data`, or nullptr if it is
+  // not a font. Fonts with byte-identical programs share one copy of them,
+  // even across documents. Once no font uses a face any more, it is handed
+  // out again along with its glyph cache, so glyphs rendered for one document
+  // are not rendered again for the next.
+  RetainPtr<CFX_Face> GetEmbeddedFace(pdfium::span<const uint8_t> data);
+
+  // Releases the programs, faces and glyph caches that no font uses, least
+  // recently used first, until the cache is within its budget again. Glyphs
+  // cached for the faces count towards the budget, and accumulate as fonts
+  // render, so this should be called once a document is done with its fonts.
+  void TrimEmbeddedFonts();
+
+  // Releases all of the programs, faces and glyph caches that no font uses.
+  void ReleaseUnusedEmbeddedFonts();
+
+  // Returns the size of all programs the cache holds and of the glyphs cached
+  // for their faces, in use or not.
+  size_t GetEmbeddedFontBytes() const;
+  const EmbeddedFontStats& embedded_font_stats() const {
+    return embedded_font_stats_;
+  }
+
  private:
+  // A face of an embedded font program, used by at most one font at a time,
+  // since fonts select charmaps on their faces.
+  struct SharedFace {
+    RetainPtr<CFX_GlyphCache> glyph_cache;
+    // Kept alive by `glyph_cache`.
+    UnownedPtr<CFX_Face> face;
+    CFX_Face::CharMap initial_charmap;
+  };
+
+  struct EmbeddedFont {
+    RetainPtr<CFX_FontMgr::FontDesc> desc;
+    std::vector<SharedFace> faces;
+    uint64_t last_use;
+  };
+
+  // <size, hash>
+  using EmbeddedFontKey = std::tuple<size_t, uint32_t>;
+
+  static bool IsIdle(const SharedFace& shared_face);
+  static bool IsIdle(const EmbeddedFont& font);
+  static size_t GetGlyphCacheBytes(const EmbeddedFont& font);
+
+  RetainPtr<CFX_Face> NewSharedFace(EmbeddedFont& font);
+  void TrimEmbeddedFontsTo(size_t target_bytes);
+
   std::map<CFX_Face*, ObservedPtr<CFX_GlyphCache>> glyph_cache_map_;
   std::map<CFX_Face*, ObservedPtr<CFX_GlyphCache>> ext_glyph_cache_map_;
+  const size_t max_embedded_font_bytes_;
+  std::map<EmbeddedFontKey, std::vector<EmbeddedFont>> embedded_fonts_;
+  // The size of the programs in `embedded_fonts_`.
+  size_t embedded_program_bytes_ = 0;
+  uint64_t embedded_font_use_count_ = 0;
+  EmbeddedFontStats embedded_font_stats_;
 };
 
 #endif  // CORE_FXGE_CFX_FONTCACHE_H_
@@ -0,0 +1,102 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxge/cfx_fontcache.h"
+
+#include <stdint.h>
+
+#include <algorithm>
+
+#include "core/fxcrt/bytestring.h"
+#include "core/fxcrt/retain_ptr.h"
+#include "core/fxcrt/span.h"
+#include "core/fxge/cfx_face.h"
+#include "core/fxge/cfx_font.h"
+#include "core/fxge/cfx_fontmgr.h"
+#include "core/fxge/cfx_gemodule.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+TEST(CFXFontCacheTest, EmbeddedFacesShared) {
+  CFX_FontCache cache;
+  pdfium::span<const uint8_t> program = CFX_FontMgr::GetStandardFont(0);
+  RetainPtr<CFX_Face> face1 = cache.GetEmbeddedFace(program);
+  ASSERT_TRUE(face1);
+  RetainPtr<CFX_Face> face2 = cache.GetEmbeddedFace(program);
+  ASSERT_TRUE(face2);
+
+  // Both faces are in use, so they are separate, but share one copy of the
+  // program.
+  EXPECT_NE(face1, face2);
+  EXPECT_EQ(face1->GetData().data(), face2->GetData().data());
+  EXPECT_NE(program.data(), face1->GetData().data());
+  EXPECT_EQ(program.size(), cache.GetEmbeddedFontBytes());
+
+  // A face no font uses any more is handed out again.
+  const CFX_Face* released_face = face1.Get();
+  face1.Reset();
+  RetainPtr<CFX_Face> face3 = cache.GetEmbeddedFace(program);
+  EXPECT_EQ(released_face, face3.Get());
+
+  EXPECT_FALSE(
+      cache.GetEmbeddedFace(ByteStringView("not a font").unsigned_span()));
+  EXPECT_EQ(program.size(), cache.GetEmbeddedFontBytes());
+
+  const CFX_FontCache::EmbeddedFontStats& stats = cache.embedded_font_stats();
+  EXPECT_EQ(2u, stats.programs_loaded);
+  EXPECT_EQ(2u, stats.programs_shared);
+  EXPECT_EQ(1u, stats.faces_reused);
+}
+
+TEST(CFXFontCacheTest, EmbeddedFontBudget) {
+  pdfium::span<const uint8_t> program1 = CFX_FontMgr::GetStandardFont(0);
+  pdfium::span<const uint8_t> program2 = CFX_FontMgr::GetStandardFont(1);
+  CFX_FontCache cache(std::max(program1.size(), program2.size()));
+
+  // The first program is in use, so there is no room to keep the second.
+  RetainPtr<CFX_Face> face1 = cache.GetEmbeddedFace(program1);
+  ASSERT_TRUE(face1);
+  RetainPtr<CFX_Face> face2 = cache.GetEmbeddedFace(program2);
+  ASSERT_TRUE(face2);
+  EXPECT_EQ(program1.size(), cache.GetEmbeddedFontBytes());
+
+  // Once it is not, it makes room.
+  face1.Reset();
+  face2.Reset();
+  face2 = cache.GetEmbeddedFace(program2);
+  ASSERT_TRUE(face2);
+  EXPECT_EQ(program2.size(), cache.GetEmbeddedFontBytes());
+
+  // Within budget, so trimming keeps the program even once it is idle.
+  face2.Reset();
+  cache.TrimEmbeddedFonts();
+  EXPECT_EQ(program2.size(), cache.GetEmbeddedFontBytes());
+  cache.ReleaseUnusedEmbeddedFonts();
+  EXPECT_EQ(0u, cache.GetEmbeddedFontBytes());
+}
+
+TEST(CFXFontCacheTest, EmbeddedGlyphCachesCount) {
+  // CFX_Font gets its faces and glyph caches from the global cache.
+  CFX_FontCache* cache = CFX_GEModule::Get()->GetFontCache();
+  cache->ReleaseUnusedEmbeddedFonts();
+  const size_t initial_bytes = cache->GetEmbeddedFontBytes();
+
+  pdfium::span<const uint8_t> program = CFX_FontMgr::GetStandardFont(0);
+  {
+    CFX_Font font;
+    ASSERT_TRUE(font.LoadEmbedded(program, /*force_vertical=*/false,
+                                  /*object_tag=*/0));
+    EXPECT_EQ(initial_bytes + program.size(), cache->GetEmbeddedFontBytes());
+
+    ASSERT_TRUE(font.LoadGlyphPath(font.GetFace()->GetCharIndex('A'),
+                                   /*dest_width=*/0));
+    EXPECT_GT(cache->GetEmbeddedFontBytes(), initial_bytes + program.size());
+
+    // The glyphs of fonts in use stay.
+    cache->ReleaseUnusedEmbeddedFonts();
+    EXPECT_GT(cache->GetEmbeddedFontBytes(), initial_bytes + program.size());
+  }
+
+  cache->ReleaseUnusedEmbeddedFonts();
+  EXPECT_EQ(initial_bytes, cache->GetEmbeddedFontBytes());
+}
@@ -430,9 +430,11 @@ void CFX_FontMapper::SetSystemFontInfo(
 
   list_loaded_ = false;
   font_info_ = std::move(pFontInfo);
+  subst_font_cache_.clear();
 }
 
 std::unique_ptr<SystemFontInfoIface> CFX_FontMapper::TakeSystemFontInfo() {
+  subst_font_cache_.clear();
   return std::move(font_info_);
 }
 
@@ -465,6 +467,7 @@ void CFX_FontMapper::AddInstalledFont(const ByteString& name,
     return;
   }
 
+  subst_font_cache_.clear();
   face_array_.push_back({name, static_cast<uint32_t>(charset)});
   if (name == last_family_) {
     return;
@@ -615,7 +618,35 @@ RetainPtr<CFX_Face> CFX_FontMapper::FindSubstFont(const ByteString& name,
     weight = pdfium::kFontWeightNormal;
     italic_angle = 0;
   }
-  const ByteString subst_name = GetSubstName(name, is_truetype);
+
+  SubstFontKey key(GetSubstName(name, is_truetype), is_truetype, flags, weight,
+                   italic_angle, code_page);
+  auto it = subst_font_cache_.find(key);
+  if (it != subst_font_cache_.end() && it->second.face) {
+    ++subst_font_cache_stats_.hits;
+    *subst_font = it->second.subst_font;
+    return RetainPtr<CFX_Face>(it->second.face.Get());
+  }
+
+  ++subst_font_cache_stats_.misses;
+  RetainPtr<CFX_Face> face =
+      FindSubstFontUncached(std::get<0>(key), is_truetype, flags, weight,
+                            italic_angle, code_page, subst_font);
+  if (face) {
+    subst_font_cache_[std::move(key)] = {ObservedPtr<CFX_Face>(face.Get()),
+                                         *subst_font};
+  }
+  return face;
+}
+
+RetainPtr<CFX_Face> CFX_FontMapper::FindSubstFontUncached(
+    const ByteString& subst_name,
+    bool is_truetype,
+    uint32_t flags,
+    int weight,
+    int italic_angle,
+    FX_CodePage code_page,
+    CFX_SubstFont* subst_font) {
   if (subst_name == "Symbol" && !is_truetype) {
     subst_font->family_ = "Chrome Symbol";
     subst_font->charset_ = FX_Charset::kSymbol;
@@ -8,24 +8,27 @@
 #define CORE_FXGE_CFX_FONTMAPPER_H_
 
 #include <array>
+#include <map>
 #include <memory>
 #include <optional>
+#include <tuple>
 #include <utility>
 #include <vector>
 
 #include "build/build_config.h"
 #include "core/fxcrt/bytestring.h"
 #include "core/fxcrt/fx_codepage_forward.h"
+#include "core/fxcrt/observed_ptr.h"
 #include "core/fxcrt/retain_ptr.h"
 #include "core/fxcrt/unowned_ptr.h"
 #include "core/fxge/cfx_face.h"
+#include "core/fxge/cfx_substfont.h"
 
 #ifdef PDF_ENABLE_XFA
 #include "core/fxcrt/fixed_size_data_vector.h"
 #endif
 
 class CFX_FontMgr;
-class CFX_SubstFont;
 class SystemFontInfoIface;
 
 class CFX_FontMapper {
@@ -49,6 +52,11 @@ class CFX_FontMapper {
   };
   static constexpr int kNumStandardFonts = 14;
 
+  struct SubstFontCacheStats {
+    size_t hits = 0;
+    size_t misses = 0;
+  };
+
   explicit CFX_FontMapper(CFX_FontMgr* mgr);
   ~CFX_FontMapper();
 
@@ -66,6 +74,9 @@ class CFX_FontMapper {
   void AddInstalledFont(const ByteString& name, FX_Charset charset);
   void LoadInstalledFonts();
 
+  // `subst_font` must be newly constructed. Remembers the result, so that
+  // asking for the same substitution again returns the same face without
+  // searching, for as long as the face is alive.
   RetainPtr<CFX_Face> FindSubstFont(const ByteString& face_name,
                                     bool is_truetype,
                                     uint32_t flags,
@@ -73,6 +84,9 @@ class CFX_FontMapper {
                                     int italic_angle,
                                     FX_CodePage code_page,
                                     CFX_SubstFont* subst_font);
+  const SubstFontCacheStats& GetSubstFontCacheStats() const {
+    return subst_font_cache_stats_;
+  }
 
   size_t GetFaceSize() const;
   // `index` must be less than GetFaceSize().
@@ -98,6 +112,13 @@ class CFX_FontMapper {
   uint32_t GetChecksumFromTT(void* font_handle);
   ByteString GetPSNameFromTT(void* font_handle);
   ByteString MatchInstalledFonts(const ByteString& norm_name);
+  RetainPtr<CFX_Face> FindSubstFontUncached(const ByteString& subst_name,
+                                            bool is_truetype,
+                                            uint32_t flags,
+                                            int weight,
+                                            int italic_angle,
+                                            FX_CodePage code_page,
+                                            CFX_SubstFont* subst_font);
   RetainPtr<CFX_Face> UseInternalSubst(int base_font,
                                        int weight,
                                        int italic_angle,
@@ -124,6 +145,16 @@ class CFX_FontMapper {
     uint32_t charset;
   };
 
+  struct SubstFontResult {
+    ObservedPtr<CFX_Face> face;
+    CFX_SubstFont subst_font;
+  };
+
+  // Keyed by substitute name, whether the font is TrueType, flags, weight,
+  // italic angle and code page.
+  using SubstFontKey =
+      std::tuple<ByteString, bool, uint32_t, int, int, FX_CodePage>;
+
   bool list_loaded_ = false;
   ByteString last_family_;
   std::vector<FaceData> face_array_;
@@ -134,6 +165,8 @@ class CFX_FontMapper {
   std::array<RetainPtr<CFX_Face>, kNumStandardFonts> standard_faces_;
   RetainPtr<CFX_Face> generic_sans_face_;
   RetainPtr<CFX_Face> generic_serif_face_;
+  std::map<SubstFontKey, SubstFontResult> subst_font_cache_;
+  SubstFontCacheStats subst_font_cache_stats_;
 };
 
 #endif  // CORE_FXGE_CFX_FONTMAPPER_H_
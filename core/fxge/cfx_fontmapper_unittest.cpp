@@ -10,6 +10,7 @@
 
 #include "core/fxcrt/fx_codepage.h"
 #include "core/fxge/cfx_gemodule.h"
+#include "core/fxge/cfx_substfont.h"
 #include "core/fxge/systemfontinfo_iface.h"
 #include "testing/gmock/include/gmock/gmock.h"
 #include "testing/gtest/include/gtest/gtest.h"
@@ -233,3 +234,40 @@ TEST_F(CFXFontMapperSystemFontInfoTest, GetCachedFaceFailToGetData) {
   EXPECT_FALSE(font_mapper().GetCachedFace(kFontHandle, kSubstName, kWeight,
                                            kItalic, kDataSize));
 }
+
+TEST_F(CFXFontMapperSystemFontInfoTest, FindSubstFontCached) {
+  EXPECT_CALL(system_font_info(), MapFont(_, _, _, _, _))
+      .Times(2)
+      .WillRepeatedly(Return(nullptr));
+
+  CFX_SubstFont subst_font1;
+  RetainPtr<CFX_Face> face1 = font_mapper().FindSubstFont(
+      "Arial,Bold", /*is_truetype=*/true, /*flags=*/0, /*weight=*/0,
+      /*italic_angle=*/0, FX_CodePage::kDefANSI, &subst_font1);
+  ASSERT_TRUE(face1);
+  EXPECT_EQ(0u, font_mapper().GetSubstFontCacheStats().hits);
+  EXPECT_EQ(1u, font_mapper().GetSubstFontCacheStats().misses);
+
+  // The same substitution does not map a font again.
+  CFX_SubstFont subst_font2;
+  RetainPtr<CFX_Face> face2 = font_mapper().FindSubstFont(
+      "Arial,Bold", /*is_truetype=*/true, /*flags=*/0, /*weight=*/0,
+      /*italic_angle=*/0, FX_CodePage::kDefANSI, &subst_font2);
+  EXPECT_EQ(face1, face2);
+  EXPECT_EQ(subst_font1.family_, subst_font2.family_);
+  EXPECT_EQ(subst_font1.charset_, subst_font2.charset_);
+  EXPECT_EQ(subst_font1.weight_, subst_font2.weight_);
+  EXPECT_EQ(subst_font1.italic_angle_, subst_font2.italic_angle_);
+  EXPECT_EQ(1u, font_mapper().GetSubstFontCacheStats().hits);
+  EXPECT_EQ(1u, font_mapper().GetSubstFontCacheStats().misses);
+
+  // Installing a font forgets the substitutions.
+  font_mapper().AddInstalledFont("other", FX_Charset::kANSI);
+  CFX_SubstFont subst_font3;
+  EXPECT_EQ(face1, font_mapper().FindSubstFont(
+                       "Arial,Bold", /*is_truetype=*/true, /*flags=*/0,
+                       /*weight=*/0, /*italic_angle=*/0, FX_CodePage::kDefANSI,
+                       &subst_font3));
+  EXPECT_EQ(1u, font_mapper().GetSubstFontCacheStats().hits);
+  EXPECT_EQ(2u, font_mapper().GetSubstFontCacheStats().misses);
+}
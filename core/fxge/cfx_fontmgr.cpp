@@ -43,12 +43,6 @@ constexpr std::array<pdfium::span<const uint8_t>,
 constexpr pdfium::span<const uint8_t> kGenericSansFont = kFoxitSansMMFontData;
 constexpr pdfium::span<const uint8_t> kGenericSerifFont = kFoxitSerifMMFontData;
 
-FXFT_LibraryRec* FTLibraryInitHelper() {
-  FXFT_LibraryRec* pLibrary = nullptr;
-  FT_Init_FreeType(&pLibrary);
-  return pLibrary;
-}
-
 }  // namespace
 
 CFX_FontMgr::FontDesc::FontDesc(FixedSizeDataVector<uint8_t> data)
@@ -67,10 +61,7 @@ CFX_Face* CFX_FontMgr::FontDesc::GetFace(size_t index) const {
 }
 
 CFX_FontMgr::CFX_FontMgr()
-    : ft_library_(FTLibraryInitHelper()),
-      builtin_mapper_(std::make_unique<CFX_FontMapper>(this)),
-      ft_library_supports_hinting_(SetLcdFilterMode() ||
-                                   FreeTypeVersionSupportsHinting()) {}
+    : builtin_mapper_(std::make_unique<CFX_FontMapper>(this)) {}
 
 CFX_FontMgr::~CFX_FontMgr() = default;
 
@@ -113,7 +104,7 @@ RetainPtr<CFX_Face> CFX_FontMgr::NewFixedFace(RetainPtr<FontDesc> pDesc,
                                               pdfium::span<const uint8_t> span,
                                               size_t face_index) {
   RetainPtr<CFX_Face> face =
-      CFX_Face::New(ft_library_.get(), std::move(pDesc), span,
+      CFX_Face::New(GetFTLibrary(), std::move(pDesc), span,
                     static_cast<FT_Long>(face_index));
   if (!face || !face->SetPixelSize(64, 64)) {
     return nullptr;
@@ -137,6 +128,28 @@ pdfium::span<const uint8_t> CFX_FontMgr::GetGenericSerifFont() {
   return kGenericSerifFont;
 }
 
+FXFT_LibraryRec* CFX_FontMgr::GetFTLibrary() {
+  if (!ft_library_) {
+    InitFTLibrary();
+  }
+  return ft_library_.get();
+}
+
+bool CFX_FontMgr::FTLibrarySupportsHinting() {
+  if (!ft_library_) {
+    InitFTLibrary();
+  }
+  return ft_library_supports_hinting_;
+}
+
+void CFX_FontMgr::InitFTLibrary() {
+  FXFT_LibraryRec* library = nullptr;
+  FT_Init_FreeType(&library);
+  ft_library_.reset(library);
+  ft_library_supports_hinting_ =
+      SetLcdFilterMode() || FreeTypeVersionSupportsHinting();
+}
+
 bool CFX_FontMgr::FreeTypeVersionSupportsHinting() const {
   FT_Int major;
   FT_Int minor;
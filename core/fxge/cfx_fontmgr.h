@@ -71,19 +71,22 @@ class CFX_FontMgr {
   // Always present.
   CFX_FontMapper* GetBuiltinMapper() const { return builtin_mapper_.get(); }
 
-  FXFT_LibraryRec* GetFTLibrary() const { return ft_library_.get(); }
-  bool FTLibrarySupportsHinting() const { return ft_library_supports_hinting_; }
+  // The FreeType library is initialized on first use, so that processes that
+  // never load a font do not pay for it.
+  FXFT_LibraryRec* GetFTLibrary();
+  bool FTLibrarySupportsHinting();
 
  private:
+  void InitFTLibrary();
   bool FreeTypeVersionSupportsHinting() const;
   bool SetLcdFilterMode() const;
 
   // Must come before |builtin_mapper_| and |face_map_|.
-  ScopedFXFTLibraryRec const ft_library_;
+  ScopedFXFTLibraryRec ft_library_;
   std::unique_ptr<CFX_FontMapper> builtin_mapper_;
   std::map<std::tuple<ByteString, int, bool>, ObservedPtr<FontDesc>> face_map_;
   std::map<std::tuple<size_t, uint32_t>, ObservedPtr<FontDesc>> ttc_face_map_;
-  const bool ft_library_supports_hinting_;
+  bool ft_library_supports_hinting_ = false;
 };
 
 #endif  // CORE_FXGE_CFX_FONTMGR_H_
@@ -12,6 +12,7 @@
 #include <memory>
 
 #include "build/build_config.h"
+#include "core/fxcrt/bytestring.h"
 #include "core/fxcrt/unowned_ptr_exclusion.h"
 
 #if BUILDFLAG(IS_APPLE)
@@ -37,7 +38,9 @@ class CFX_GEModule {
 #endif
   };
 
-  static void Create(const char** pUserFontPaths);
+  // `font_catalog_path` may be nullptr.
+  static void Create(const char** pUserFontPaths,
+                     const char* font_catalog_path);
   static void Destroy();
   static CFX_GEModule* Get();
 
@@ -45,9 +48,11 @@ class CFX_GEModule {
   CFX_FontMgr* GetFontMgr() const { return font_mgr_.get(); }
   PlatformIface* GetPlatform() const { return platform_.get(); }
   const char** GetUserFontPaths() const { return user_font_paths_; }
+  // Empty if fonts are not cached.
+  const ByteString& GetFontCatalogPath() const { return font_catalog_path_; }
 
  private:
-  explicit CFX_GEModule(const char** pUserFontPaths);
+  CFX_GEModule(const char** pUserFontPaths, const char* font_catalog_path);
   ~CFX_GEModule();
 
   std::unique_ptr<PlatformIface> const platform_;
@@ -56,6 +61,7 @@ class CFX_GEModule {
 
   // Exclude because taken from public API.
   UNOWNED_PTR_EXCLUSION const char** const user_font_paths_;
+  const ByteString font_catalog_path_;
 };
 
 #endif  // CORE_FXGE_CFX_GEMODULE_H_
@@ -6,19 +6,24 @@
 
 #include "core/fxge/cfx_glyphcache.h"
 
+#include <algorithm>
 #include <initializer_list>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "build/build_config.h"
+#include "core/fxcrt/check_op.h"
 #include "core/fxcrt/fx_codepage.h"
 #include "core/fxcrt/fx_memcpy_wrappers.h"
 #include "core/fxcrt/span.h"
 #include "core/fxge/cfx_defaultrenderdevice.h"
 #include "core/fxge/cfx_font.h"
 #include "core/fxge/cfx_glyphbitmap.h"
+#include "core/fxge/cfx_glyphoutline.h"
 #include "core/fxge/cfx_path.h"
 #include "core/fxge/cfx_substfont.h"
+#include "core/fxge/dib/cfx_dibitmap.h"
 
 #if defined(PDF_USE_SKIA)
 #include "third_party/skia/include/core/SkFontMgr.h"         // nogncheck
@@ -42,6 +47,21 @@ namespace {
 
 constexpr uint32_t kInvalidGlyphIndex = static_cast<uint32_t>(-1);
 
+size_t GetGlyphBitmapBytes(const CFX_GlyphBitmap* glyph_bitmap) {
+  if (!glyph_bitmap) {
+    return 0;
+  }
+  const RetainPtr<CFX_DIBitmap>& bitmap = glyph_bitmap->GetBitmap();
+  return sizeof(CFX_GlyphBitmap) +
+         static_cast<size_t>(bitmap->GetPitch()) * bitmap->GetHeight();
+}
+
+size_t GetGlyphPathBytes(const CFX_Path* path) {
+  return path ? sizeof(CFX_Path) +
+                    path->GetPoints().size() * sizeof(CFX_Path::Point)
+              : 0;
+}
+
 class UniqueKeyGen {
  public:
   UniqueKeyGen(const CFX_Font* pFont,
@@ -110,6 +130,16 @@ UniqueKeyGen::UniqueKeyGen(const CFX_Font* pFont,
 
 }  // namespace
 
+CFX_GlyphCache::CachedOutline::CachedOutline() = default;
+
+CFX_GlyphCache::CachedOutline::CachedOutline(CachedOutline&&) noexcept =
+    default;
+
+CFX_GlyphCache::CachedOutline& CFX_GlyphCache::CachedOutline::operator=(
+    CachedOutline&&) noexcept = default;
+
+CFX_GlyphCache::CachedOutline::~CachedOutline() = default;
+
 CFX_GlyphCache::CFX_GlyphCache(RetainPtr<CFX_Face> face)
     : face_(std::move(face)) {}
 
@@ -121,13 +151,14 @@ std::unique_ptr<CFX_GlyphBitmap> CFX_GlyphCache::RenderGlyph(
     bool bFontStyle,
     const CFX_Matrix& matrix,
     int dest_width,
-    int anti_alias) {
+    int anti_alias,
+    int subpixel_x) {
   if (!face_) {
     return nullptr;
   }
 
   return face_->RenderGlyph(pFont, glyph_index, bFontStyle, matrix, dest_width,
-                            anti_alias);
+                            anti_alias, subpixel_x * 64 / kSubpixelPositions);
 }
 
 const CFX_Path* CFX_GlyphCache::LoadGlyphPath(const CFX_Font* pFont,
@@ -137,19 +168,45 @@ const CFX_Path* CFX_GlyphCache::LoadGlyphPath(const CFX_Font* pFont,
     return nullptr;
   }
 
-  const auto* pSubstFont = pFont->GetSubstFont();
-  int weight = pSubstFont ? pSubstFont->weight_ : 0;
-  int angle = pSubstFont ? pSubstFont->italic_angle_ : 0;
-  bool vertical = pSubstFont && pFont->IsVertical();
-  const PathMapKey key =
-      std::make_tuple(glyph_index, dest_width, weight, angle, vertical);
+  const PathMapKey key = GetPathMapKey(pFont, glyph_index, dest_width);
   auto it = path_map_.find(key);
   if (it != path_map_.end()) {
     return it->second.get();
   }
 
-  path_map_[key] = pFont->LoadGlyphPathImpl(glyph_index, dest_width);
-  return path_map_[key].get();
+  std::unique_ptr<CFX_Path>& path = path_map_[key];
+  path = pFont->LoadGlyphPathImpl(glyph_index, dest_width);
+  glyph_bytes_ += GetGlyphPathBytes(path.get());
+  return path.get();
+}
+
+const CFX_GlyphOutline* CFX_GlyphCache::LoadGlyphOutline(
+    const CFX_Font* pFont,
+    uint32_t glyph_index,
+    int dest_width) {
+  if (!GetFace() || glyph_index == kInvalidGlyphIndex) {
+    return nullptr;
+  }
+
+  const PathMapKey key = GetPathMapKey(pFont, glyph_index, dest_width);
+  auto it = outline_map_.find(key);
+  if (it == outline_map_.end()) {
+    CachedOutline cached;
+    std::unique_ptr<CFX_Path> path =
+        pFont->LoadGlyphPathImpl(glyph_index, dest_width);
+    if (path) {
+      cached.outline = std::make_unique<CFX_GlyphOutline>(*path);
+    }
+    cached.size = sizeof(CachedOutline) +
+                  (cached.outline ? cached.outline->GetMemorySize() : 0);
+    outline_bytes_ += cached.size;
+    if (outline_bytes_ > kMaxGlyphOutlineBytes) {
+      TrimGlyphOutlines();
+    }
+    it = outline_map_.emplace(key, std::move(cached)).first;
+  }
+  it->second.last_use = ++outline_use_count_;
+  return it->second.outline.get();
 }
 
 const CFX_GlyphBitmap* CFX_GlyphCache::LoadGlyphBitmap(
@@ -159,18 +216,22 @@ const CFX_GlyphBitmap* CFX_GlyphCache::LoadGlyphBitmap(
     const CFX_Matrix& matrix,
     int dest_width,
     int anti_alias,
+    int subpixel_x,
     CFX_TextRenderOptions* text_options) {
   if (glyph_index == kInvalidGlyphIndex) {
     return nullptr;
   }
 
+  DCHECK_GE(subpixel_x, 0);
+  DCHECK_LT(subpixel_x, kSubpixelPositions);
+
 #if BUILDFLAG(IS_APPLE)
   const bool bNative = text_options->native_text;
 #else
   const bool bNative = false;
 #endif
   UniqueKeyGen keygen(pFont, matrix, dest_width, anti_alias, bNative);
-  auto FaceGlyphsKey = ByteString(ByteStringView(keygen.span()));
+  const ByteStringView FaceGlyphsKey(keygen.span());
 
 #if BUILDFLAG(IS_APPLE)
   const bool bDoLookUp =
@@ -180,17 +241,17 @@ const CFX_GlyphBitmap* CFX_GlyphCache::LoadGlyphBitmap(
 #endif
   if (bDoLookUp) {
     return LookUpGlyphBitmap(pFont, matrix, FaceGlyphsKey, glyph_index,
-                             bFontStyle, dest_width, anti_alias);
+                             bFontStyle, dest_width, anti_alias, subpixel_x);
   }
 
 #if BUILDFLAG(IS_APPLE)
   DCHECK(!CFX_DefaultRenderDevice::UseSkiaRenderer());
 
   std::unique_ptr<CFX_GlyphBitmap> pGlyphBitmap;
-  auto it = size_map_.find(FaceGlyphsKey);
+  auto it = size_map_.find(ByteString(FaceGlyphsKey));
   if (it != size_map_.end()) {
     SizeGlyphCache* pSizeCache = &(it->second);
-    auto it2 = pSizeCache->find(glyph_index);
+    auto it2 = pSizeCache->find(GetGlyphKey(glyph_index, 0));
     if (it2 != pSizeCache->end()) {
       return it2->second.get();
     }
@@ -199,7 +260,8 @@ const CFX_GlyphBitmap* CFX_GlyphCache::LoadGlyphBitmap(
                                           dest_width, anti_alias);
     if (pGlyphBitmap) {
       CFX_GlyphBitmap* pResult = pGlyphBitmap.get();
-      (*pSizeCache)[glyph_index] = std::move(pGlyphBitmap);
+      glyph_bytes_ += GetGlyphBitmapBytes(pResult);
+      (*pSizeCache)[GetGlyphKey(glyph_index, 0)] = std::move(pGlyphBitmap);
       return pResult;
     }
   } else {
@@ -207,20 +269,21 @@ const CFX_GlyphBitmap* CFX_GlyphCache::LoadGlyphBitmap(
                                           dest_width, anti_alias);
     if (pGlyphBitmap) {
       CFX_GlyphBitmap* pResult = pGlyphBitmap.get();
+      glyph_bytes_ += GetGlyphBitmapBytes(pResult);
 
       SizeGlyphCache cache;
-      cache[glyph_index] = std::move(pGlyphBitmap);
+      cache[GetGlyphKey(glyph_index, 0)] = std::move(pGlyphBitmap);
 
-      size_map_[FaceGlyphsKey] = std::move(cache);
+      size_map_[ByteString(FaceGlyphsKey)] = std::move(cache);
       return pResult;
     }
   }
   UniqueKeyGen keygen2(pFont, matrix, dest_width, anti_alias,
                        /*bNative=*/false);
-  auto FaceGlyphsKey2 = ByteString(ByteStringView(keygen2.span()));
   text_options->native_text = false;
-  return LookUpGlyphBitmap(pFont, matrix, FaceGlyphsKey2, glyph_index,
-                           bFontStyle, dest_width, anti_alias);
+  return LookUpGlyphBitmap(pFont, matrix, ByteStringView(keygen2.span()),
+                           glyph_index, bFontStyle, dest_width, anti_alias,
+                           subpixel_x);
 #endif  // BUILDFLAG(IS_APPLE)
 }
 
@@ -238,6 +301,47 @@ int CFX_GlyphCache::GetGlyphWidth(const CFX_Font* font,
   return width_map_[key];
 }
 
+// static
+CFX_GlyphCache::PathMapKey CFX_GlyphCache::GetPathMapKey(
+    const CFX_Font* pFont,
+    uint32_t glyph_index,
+    int dest_width) {
+  // See CFX_Face::LoadGlyphPath(). Outlines of fonts other than substitutes
+  // only depend on the glyph, so all sizes share one.
+  const CFX_SubstFont* pSubstFont = pFont->GetSubstFont();
+  if (!pSubstFont) {
+    return std::make_tuple(glyph_index, 0, 0, 0, false);
+  }
+
+  const bool is_generic = pSubstFont->IsBuiltInGenericFont();
+  const int width = is_generic ? dest_width : 0;
+  const int weight =
+      is_generic || pSubstFont->weight_ > 400 ? pSubstFont->weight_ : 0;
+  const int angle = pSubstFont->italic_angle_;
+  const bool vertical = angle && pFont->IsVertical();
+  return std::make_tuple(glyph_index, width, weight, angle, vertical);
+}
+
+void CFX_GlyphCache::TrimGlyphOutlines() {
+  // Evict the least recently used outlines, down to 3/4 of the budget, so
+  // that this does not happen again on the next miss.
+  std::vector<std::map<PathMapKey, CachedOutline>::iterator> entries;
+  entries.reserve(outline_map_.size());
+  for (auto it = outline_map_.begin(); it != outline_map_.end(); ++it) {
+    entries.push_back(it);
+  }
+  std::ranges::sort(entries, [](const auto& a, const auto& b) {
+    return a->second.last_use < b->second.last_use;
+  });
+  for (const auto& entry : entries) {
+    if (outline_bytes_ <= kMaxGlyphOutlineBytes / 4 * 3) {
+      break;
+    }
+    outline_bytes_ -= entry->second.size;
+    outline_map_.erase(entry);
+  }
+}
+
 #if defined(PDF_USE_SKIA)
 
 namespace {
@@ -288,28 +392,28 @@ CFX_TypeFace* CFX_GlyphCache::GetDeviceCache(const CFX_Font* pFont) {
 CFX_GlyphBitmap* CFX_GlyphCache::LookUpGlyphBitmap(
     const CFX_Font* pFont,
     const CFX_Matrix& matrix,
-    const ByteString& FaceGlyphsKey,
+    ByteStringView FaceGlyphsKey,
     uint32_t glyph_index,
     bool bFontStyle,
     int dest_width,
-    int anti_alias) {
-  SizeGlyphCache* pSizeCache;
-  auto it = size_map_.find(FaceGlyphsKey);
-  if (it == size_map_.end()) {
-    size_map_[FaceGlyphsKey] = SizeGlyphCache();
-    pSizeCache = &(size_map_[FaceGlyphsKey]);
-  } else {
-    pSizeCache = &(it->second);
+    int anti_alias,
+    int subpixel_x) {
+  if (!last_size_cache_ || last_size_key_ != FaceGlyphsKey) {
+    last_size_key_ = FaceGlyphsKey;
+    last_size_cache_ = &size_map_[last_size_key_];
   }
 
-  auto it2 = pSizeCache->find(glyph_index);
-  if (it2 != pSizeCache->end()) {
-    return it2->second.get();
+  auto [it, inserted] =
+      last_size_cache_->try_emplace(GetGlyphKey(glyph_index, subpixel_x));
+  if (inserted) {
+    it->second = RenderGlyph(pFont, glyph_index, bFontStyle, matrix,
+                             dest_width, anti_alias, subpixel_x);
+    glyph_bytes_ += GetGlyphBitmapBytes(it->second.get());
   }
+  return it->second.get();
+}
 
-  std::unique_ptr<CFX_GlyphBitmap> pGlyphBitmap = RenderGlyph(
-      pFont, glyph_index, bFontStyle, matrix, dest_width, anti_alias);
-  CFX_GlyphBitmap* pResult = pGlyphBitmap.get();
-  (*pSizeCache)[glyph_index] = std::move(pGlyphBitmap);
-  return pResult;
+// static
+uint64_t CFX_GlyphCache::GetGlyphKey(uint32_t glyph_index, int subpixel_x) {
+  return static_cast<uint64_t>(subpixel_x) << 32 | glyph_index;
 }
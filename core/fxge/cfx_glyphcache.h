@@ -7,13 +7,18 @@
 #ifndef CORE_FXGE_CFX_GLYPHCACHE_H_
 #define CORE_FXGE_CFX_GLYPHCACHE_H_
 
+#include <stddef.h>
+#include <stdint.h>
+
 #include <map>
 #include <memory>
 #include <tuple>
+#include <unordered_map>
 
 #include "core/fxcrt/bytestring.h"
 #include "core/fxcrt/observed_ptr.h"
 #include "core/fxcrt/retain_ptr.h"
+#include "core/fxcrt/unowned_ptr.h"
 #include "core/fxge/cfx_face.h"
 
 #if defined(PDF_USE_SKIA)
@@ -23,24 +28,37 @@
 
 class CFX_Font;
 class CFX_GlyphBitmap;
+class CFX_GlyphOutline;
 class CFX_Matrix;
 class CFX_Path;
 struct CFX_TextRenderOptions;
 
 class CFX_GlyphCache final : public Retainable, public Observable {
  public:
+  // The number of horizontal positions within a pixel that glyphs can be
+  // rendered at.
+  static constexpr int kSubpixelPositions = 4;
+
   CONSTRUCT_VIA_MAKE_RETAIN;
 
+  // `subpixel_x` is the horizontal position within a pixel to render the
+  // glyph at, in 1/kSubpixelPositions pixels.
   const CFX_GlyphBitmap* LoadGlyphBitmap(const CFX_Font* pFont,
                                          uint32_t glyph_index,
                                          bool bFontStyle,
                                          const CFX_Matrix& matrix,
                                          int dest_width,
                                          int anti_alias,
+                                         int subpixel_x,
                                          CFX_TextRenderOptions* text_options);
   const CFX_Path* LoadGlyphPath(const CFX_Font* pFont,
                                 uint32_t glyph_index,
                                 int dest_width);
+  // Like LoadGlyphPath(), but the outline is only valid until the next call,
+  // as outlines are evicted to stay within kMaxGlyphOutlineBytes.
+  const CFX_GlyphOutline* LoadGlyphOutline(const CFX_Font* pFont,
+                                           uint32_t glyph_index,
+                                           int dest_width);
   int GetGlyphWidth(const CFX_Font* font,
                     uint32_t glyph_index,
                     int dest_width,
@@ -48,6 +66,9 @@ class CFX_GlyphCache final : public Retainable, public Observable {
 
   RetainPtr<CFX_Face> GetFace() { return face_; }
 
+  // Returns the size of the glyph bitmaps, paths and outlines cached so far.
+  size_t GetMemorySize() const { return glyph_bytes_ + outline_bytes_; }
+
 #if defined(PDF_USE_SKIA)
   CFX_TypeFace* GetDeviceCache(const CFX_Font* pFont);
   static void InitializeGlobals();
@@ -58,34 +79,68 @@ class CFX_GlyphCache final : public Retainable, public Observable {
   explicit CFX_GlyphCache(RetainPtr<CFX_Face> face);
   ~CFX_GlyphCache() override;
 
-  using SizeGlyphCache = std::map<uint32_t, std::unique_ptr<CFX_GlyphBitmap>>;
+  static constexpr size_t kMaxGlyphOutlineBytes = 1024 * 1024;
+
+  // Keyed by GetGlyphKey().
+  using SizeGlyphCache =
+      std::unordered_map<uint64_t, std::unique_ptr<CFX_GlyphBitmap>>;
   // <glyph_index, width, weight, angle, vertical>
   using PathMapKey = std::tuple<uint32_t, int, int, int, bool>;
+  struct CachedOutline {
+    CachedOutline();
+    CachedOutline(CachedOutline&&) noexcept;
+    CachedOutline& operator=(CachedOutline&&) noexcept;
+    ~CachedOutline();
+
+    // Null if the glyph has no outline.
+    std::unique_ptr<CFX_GlyphOutline> outline;
+    size_t size = 0;
+    uint64_t last_use = 0;
+  };
   // <glyph_index, dest_width, weight>
   using WidthMapKey = std::tuple<uint32_t, int, int>;
 
+  static uint64_t GetGlyphKey(uint32_t glyph_index, int subpixel_x);
+
   std::unique_ptr<CFX_GlyphBitmap> RenderGlyph(const CFX_Font* pFont,
                                                uint32_t glyph_index,
                                                bool bFontStyle,
                                                const CFX_Matrix& matrix,
                                                int dest_width,
-                                               int anti_alias);
+                                               int anti_alias,
+                                               int subpixel_x);
   std::unique_ptr<CFX_GlyphBitmap> RenderGlyph_Nativetext(
       const CFX_Font* pFont,
       uint32_t glyph_index,
       const CFX_Matrix& matrix,
       int dest_width,
       int anti_alias);
+  // Returns the key for the outline of the glyph, leaving out the parameters
+  // that do not affect it for `pFont`.
+  static PathMapKey GetPathMapKey(const CFX_Font* pFont,
+                                  uint32_t glyph_index,
+                                  int dest_width);
+
+  void TrimGlyphOutlines();
   CFX_GlyphBitmap* LookUpGlyphBitmap(const CFX_Font* pFont,
                                      const CFX_Matrix& matrix,
-                                     const ByteString& FaceGlyphsKey,
+                                     ByteStringView FaceGlyphsKey,
                                      uint32_t glyph_index,
                                      bool bFontStyle,
                                      int dest_width,
-                                     int anti_alias);
+                                     int anti_alias,
+                                     int subpixel_x);
   RetainPtr<CFX_Face> const face_;
   std::map<ByteString, SizeGlyphCache> size_map_;
+  // The entry of `size_map_` looked up last. Text runs mostly use one.
+  ByteString last_size_key_;
+  UnownedPtr<SizeGlyphCache> last_size_cache_;
   std::map<PathMapKey, std::unique_ptr<CFX_Path>> path_map_;
+  // The size of the bitmaps in `size_map_` and the paths in `path_map_`.
+  size_t glyph_bytes_ = 0;
+  std::map<PathMapKey, CachedOutline> outline_map_;
+  size_t outline_bytes_ = 0;
+  uint64_t outline_use_count_ = 0;
   std::map<WidthMapKey, int> width_map_;
 #if defined(PDF_USE_SKIA)
   sk_sp<SkTypeface> typeface_;
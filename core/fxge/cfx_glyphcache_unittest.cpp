@@ -0,0 +1,73 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxge/cfx_glyphcache.h"
+
+#include <stdint.h>
+
+#include "core/fxcrt/fx_coordinates.h"
+#include "core/fxcrt/span.h"
+#include "core/fxge/cfx_font.h"
+#include "core/fxge/cfx_fontmgr.h"
+#include "core/fxge/cfx_glyphbitmap.h"
+#include "core/fxge/cfx_textrenderoptions.h"
+#include "core/fxge/dib/cfx_dibitmap.h"
+#include "core/fxge/freetype/fx_freetype.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+bool SameBitmap(const CFX_GlyphBitmap& a, const CFX_GlyphBitmap& b) {
+  const CFX_DIBitmap& bitmap_a = *a.GetBitmap();
+  const CFX_DIBitmap& bitmap_b = *b.GetBitmap();
+  if (a.left() != b.left() || a.top() != b.top() ||
+      bitmap_a.GetWidth() != bitmap_b.GetWidth() ||
+      bitmap_a.GetHeight() != bitmap_b.GetHeight()) {
+    return false;
+  }
+  for (int row = 0; row < bitmap_a.GetHeight(); ++row) {
+    pdfium::span<const uint8_t> scan_a = bitmap_a.GetScanline(row);
+    pdfium::span<const uint8_t> scan_b = bitmap_b.GetScanline(row);
+    for (int col = 0; col < bitmap_a.GetWidth(); ++col) {
+      if (scan_a[col] != scan_b[col]) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+TEST(CFXGlyphCacheTest, SubpixelPositions) {
+  CFX_Font font;
+  ASSERT_TRUE(font.LoadEmbedded(CFX_FontMgr::GetStandardFont(0),
+                                /*force_vertical=*/false, /*object_tag=*/0));
+  const uint32_t glyph_index = font.GetFace()->GetCharIndex('H');
+  const CFX_Matrix matrix(12, 0, 0, 12, 0, 0);
+  CFX_TextRenderOptions options;
+
+  const CFX_GlyphBitmap* glyph = font.LoadGlyphBitmap(
+      glyph_index, /*bFontStyle=*/false, matrix, /*dest_width=*/0,
+      FT_RENDER_MODE_NORMAL, /*subpixel_x=*/0, &options);
+  ASSERT_TRUE(glyph);
+  const CFX_GlyphBitmap* shifted_glyph = font.LoadGlyphBitmap(
+      glyph_index, /*bFontStyle=*/false, matrix, /*dest_width=*/0,
+      FT_RENDER_MODE_NORMAL, /*subpixel_x=*/2, &options);
+  ASSERT_TRUE(shifted_glyph);
+
+  // Half a pixel to the right, the vertical stems cover pixels differently.
+  EXPECT_NE(glyph, shifted_glyph);
+  EXPECT_FALSE(SameBitmap(*glyph, *shifted_glyph));
+
+  // Each position is rendered once.
+  EXPECT_EQ(glyph, font.LoadGlyphBitmap(glyph_index, /*bFontStyle=*/false,
+                                        matrix, /*dest_width=*/0,
+                                        FT_RENDER_MODE_NORMAL,
+                                        /*subpixel_x=*/0, &options));
+  EXPECT_EQ(shifted_glyph,
+            font.LoadGlyphBitmap(glyph_index, /*bFontStyle=*/false, matrix,
+                                 /*dest_width=*/0, FT_RENDER_MODE_NORMAL,
+                                 /*subpixel_x=*/2, &options));
+}
@@ -0,0 +1,77 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxge/cfx_glyphoutline.h"
+
+#include <math.h>
+
+#include <algorithm>
+#include <utility>
+
+#include "core/fxcrt/fx_coordinates.h"
+#include "core/fxcrt/numerics/safe_conversions.h"
+#include "core/fxge/cfx_path.h"
+
+namespace {
+
+// The units of CFX_Face::LoadGlyphPath(): 26.6 fixed point at 64 pixels/em.
+constexpr float kCoordUnit = 64 * 64.0f;
+
+constexpr uint8_t kTypeMask = 0x03;
+constexpr uint8_t kCloseFigure = 0x04;
+
+int32_t ToCoord(float value) {
+  return pdfium::saturated_cast<int32_t>(roundf(value * kCoordUnit));
+}
+
+}  // namespace
+
+CFX_GlyphOutline::CFX_GlyphOutline(const CFX_Path& path) {
+  pdfium::span<const CFX_Path::Point> points = path.GetPoints();
+  std::vector<int32_t> coords;
+  coords.reserve(points.size() * 2);
+  types_.reserve(points.size());
+  for (const CFX_Path::Point& point : points) {
+    coords.push_back(ToCoord(point.point_.x));
+    coords.push_back(ToCoord(point.point_.y));
+    types_.push_back(static_cast<uint8_t>(point.type_) |
+                     (point.close_figure_ ? kCloseFigure : 0));
+  }
+
+  const bool fits_in_16_bits =
+      std::ranges::all_of(coords, [](int32_t coord) {
+        return pdfium::IsValueInRangeForNumericType<int16_t>(coord);
+      });
+  if (fits_in_16_bits) {
+    coords16_.assign(coords.begin(), coords.end());
+  } else {
+    coords32_ = std::move(coords);
+  }
+}
+
+CFX_GlyphOutline::~CFX_GlyphOutline() = default;
+
+void CFX_GlyphOutline::AppendToPath(CFX_Path& path,
+                                    const CFX_Matrix& matrix) const {
+  std::vector<CFX_Path::Point>& points = path.GetPoints();
+  points.reserve(points.size() + types_.size());
+  for (size_t i = 0; i < types_.size(); ++i) {
+    CFX_PointF point(GetCoord(2 * i) / kCoordUnit,
+                     GetCoord(2 * i + 1) / kCoordUnit);
+    points.emplace_back(
+        matrix.Transform(point),
+        static_cast<CFX_Path::Point::Type>(types_[i] & kTypeMask),
+        /*close=*/!!(types_[i] & kCloseFigure));
+  }
+}
+
+size_t CFX_GlyphOutline::GetMemorySize() const {
+  return sizeof(*this) + types_.capacity() +
+         coords16_.capacity() * sizeof(int16_t) +
+         coords32_.capacity() * sizeof(int32_t);
+}
+
+int32_t CFX_GlyphOutline::GetCoord(size_t index) const {
+  return coords32_.empty() ? coords16_[index] : coords32_[index];
+}
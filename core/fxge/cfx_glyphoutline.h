@@ -0,0 +1,44 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FXGE_CFX_GLYPHOUTLINE_H_
+#define CORE_FXGE_CFX_GLYPHOUTLINE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+class CFX_Matrix;
+class CFX_Path;
+
+// A glyph outline from CFX_Face::LoadGlyphPath(), stored compactly. The
+// coordinates of those outlines are whole multiples of 1/4096 em, so they are
+// kept as integers: 16 bits wide for glyphs within 8 em of the origin, which
+// is nearly all of them, and 32 bits wide otherwise. Converting back gives
+// the same path.
+class CFX_GlyphOutline {
+ public:
+  explicit CFX_GlyphOutline(const CFX_Path& path);
+  ~CFX_GlyphOutline();
+
+  // Appends the outline to `path`, transformed by `matrix`. This is the same
+  // as appending the original path with CFX_Path::Append(), without making a
+  // copy of it first.
+  void AppendToPath(CFX_Path& path, const CFX_Matrix& matrix) const;
+
+  size_t GetPointCount() const { return types_.size(); }
+  size_t GetMemorySize() const;
+
+ private:
+  int32_t GetCoord(size_t index) const;
+
+  // Point::Type in the low bits, and kCloseFigure.
+  std::vector<uint8_t> types_;
+  // x, y pairs. Only one of these is used.
+  std::vector<int16_t> coords16_;
+  std::vector<int32_t> coords32_;
+};
+
+#endif  // CORE_FXGE_CFX_GLYPHOUTLINE_H_
@@ -0,0 +1,79 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxge/cfx_glyphoutline.h"
+
+#include <vector>
+
+#include "core/fxcrt/fx_coordinates.h"
+#include "core/fxge/cfx_path.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+void ExpectSamePoints(const CFX_Path& expected, const CFX_Path& actual) {
+  const std::vector<CFX_Path::Point>& expected_points = expected.GetPoints();
+  const std::vector<CFX_Path::Point>& actual_points = actual.GetPoints();
+  ASSERT_EQ(expected_points.size(), actual_points.size());
+  for (size_t i = 0; i < expected_points.size(); ++i) {
+    EXPECT_EQ(expected_points[i].point_, actual_points[i].point_);
+    EXPECT_EQ(expected_points[i].type_, actual_points[i].type_);
+    EXPECT_EQ(expected_points[i].close_figure_,
+              actual_points[i].close_figure_);
+  }
+}
+
+// Returns a glyph-like path, in multiples of 1/4096 em, reaching `extent` em.
+CFX_Path MakeGlyphPath(float extent) {
+  CFX_Path path;
+  path.AppendPoint(CFX_PointF(0.125f, -0.25f), CFX_Path::Point::Type::kMove);
+  path.AppendPoint(CFX_PointF(extent, 0), CFX_Path::Point::Type::kLine);
+  path.AppendPoint(CFX_PointF(123 / 4096.0f, 2047 / 4096.0f),
+                   CFX_Path::Point::Type::kBezier);
+  path.AppendPoint(CFX_PointF(-5 / 4096.0f, 1.0f),
+                   CFX_Path::Point::Type::kBezier);
+  path.AppendPoint(CFX_PointF(0.5f, -extent), CFX_Path::Point::Type::kBezier);
+  path.ClosePath();
+  path.AppendPoint(CFX_PointF(0.75f, 0.75f), CFX_Path::Point::Type::kMove);
+  path.AppendPointAndClose(CFX_PointF(0.25f, 0.5f),
+                           CFX_Path::Point::Type::kLine);
+  return path;
+}
+
+}  // namespace
+
+TEST(CFXGlyphOutlineTest, RoundTrip) {
+  const CFX_Matrix kMatrices[] = {
+      CFX_Matrix(),
+      CFX_Matrix(12, 0, 0, 12, 100.5f, 200.25f),
+      CFX_Matrix(0, 300, -300, 0, 7, 9),
+  };
+  for (float extent : {1.0f, 20.0f}) {
+    const CFX_Path path = MakeGlyphPath(extent);
+    CFX_GlyphOutline outline(path);
+    EXPECT_EQ(path.GetPoints().size(), outline.GetPointCount());
+    for (const CFX_Matrix& matrix : kMatrices) {
+      CFX_Path expected;
+      expected.Append(path, &matrix);
+      CFX_Path actual;
+      outline.AppendToPath(actual, matrix);
+      ExpectSamePoints(expected, actual);
+    }
+  }
+}
+
+TEST(CFXGlyphOutlineTest, Compact) {
+  CFX_Path path;
+  for (int i = 0; i < 16; ++i) {
+    path.Append(MakeGlyphPath(1.0f), nullptr);
+  }
+  CFX_GlyphOutline outline(path);
+  EXPECT_LT(outline.GetMemorySize(),
+            path.GetPoints().size() * sizeof(CFX_Path::Point) / 2);
+
+  // Outlines beyond 8 em need wider coordinates.
+  CFX_GlyphOutline small_outline(MakeGlyphPath(1.0f));
+  CFX_GlyphOutline large_outline(MakeGlyphPath(20.0f));
+  EXPECT_GT(large_outline.GetMemorySize(), small_outline.GetMemorySize());
+}
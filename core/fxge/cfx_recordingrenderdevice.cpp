@@ -0,0 +1,218 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxge/cfx_recordingrenderdevice.h"
+
+#include <utility>
+
+#include "core/fxcrt/notreached.h"
+#include "core/fxge/agg/cfx_agg_imagerenderer.h"
+#include "core/fxge/cfx_displaylist.h"
+#include "core/fxge/cfx_fillrenderoptions.h"
+#include "core/fxge/cfx_graphstatedata.h"
+#include "core/fxge/cfx_path.h"
+#include "core/fxge/dib/cfx_dibbase.h"
+#include "core/fxge/dib/cfx_dibitmap.h"
+#include "core/fxge/render_defines.h"
+
+namespace {
+
+class CFX_RecordingDeviceDriver final : public RenderDeviceDriverIface {
+ public:
+  CFX_RecordingDeviceDriver(int width, int height)
+      : width_(width),
+        height_(height),
+        clip_box_(0, 0, width, height),
+        display_list_(std::make_unique<CFX_DisplayList>(width, height)) {}
+  ~CFX_RecordingDeviceDriver() override = default;
+
+  std::unique_ptr<CFX_DisplayList> TakeDisplayList() {
+    return std::exchange(display_list_,
+                         std::make_unique<CFX_DisplayList>(width_, height_));
+  }
+
+  // RenderDeviceDriverIface:
+  DeviceType GetDeviceType() const override { return DeviceType::kDisplay; }
+
+  int GetDeviceCaps(int caps_id) const override {
+    switch (caps_id) {
+      case FXDC_PIXEL_WIDTH:
+        return width_;
+      case FXDC_PIXEL_HEIGHT:
+        return height_;
+      case FXDC_BITS_PIXEL:
+        return 32;
+      case FXDC_HORZ_SIZE:
+      case FXDC_VERT_SIZE:
+        return 0;
+      case FXDC_RENDER_CAPS:
+        // Everything that is not drawn directly gets rendered into an alpha
+        // bitmap, so that it can be recorded without reading back the device.
+        return FXRC_ALPHA_PATH | FXRC_ALPHA_IMAGE | FXRC_ALPHA_OUTPUT |
+               FXRC_BLEND_MODE | FXRC_SOFT_CLIP | FXRC_FILLSTROKE_PATH;
+      default:
+        NOTREACHED();
+    }
+  }
+
+  void SaveState() override {
+    saved_clip_boxes_.push_back(clip_box_);
+    display_list_->SaveState();
+  }
+
+  void RestoreState(bool bKeepSaved) override {
+    if (saved_clip_boxes_.empty()) {
+      return;
+    }
+    clip_box_ = saved_clip_boxes_.back();
+    if (!bKeepSaved) {
+      saved_clip_boxes_.pop_back();
+    }
+    display_list_->RestoreState(bKeepSaved);
+  }
+
+  bool SetClip_PathFill(const CFX_Path& path,
+                        const CFX_Matrix* pObject2Device,
+                        const CFX_FillRenderOptions& fill_options) override {
+    CFX_FloatRect bbox = path.GetBoundingBox();
+    if (pObject2Device) {
+      bbox = pObject2Device->TransformRect(bbox);
+    }
+    clip_box_.Intersect(bbox.GetOuterRect());
+    display_list_->ClipPathFill(path, pObject2Device, fill_options);
+    return true;
+  }
+
+  bool SetClip_PathStroke(const CFX_Path& path,
+                          const CFX_Matrix* pObject2Device,
+                          const CFX_GraphStateData* pGraphState) override {
+    CFX_FloatRect bbox =
+        pGraphState
+            ? path.GetBoundingBoxForStrokePath(pGraphState->line_width(),
+                                               pGraphState->miter_limit())
+            : path.GetBoundingBox();
+    if (pObject2Device) {
+      bbox = pObject2Device->TransformRect(bbox);
+    }
+    clip_box_.Intersect(bbox.GetOuterRect());
+    display_list_->ClipPathStroke(path, pObject2Device, pGraphState);
+    return true;
+  }
+
+  bool DrawPath(const CFX_Path& path,
+                const CFX_Matrix* pObject2Device,
+                const CFX_GraphStateData* pGraphState,
+                uint32_t fill_color,
+                uint32_t stroke_color,
+                const CFX_FillRenderOptions& fill_options) override {
+    display_list_->DrawPath(path, pObject2Device, pGraphState, fill_color,
+                            stroke_color, fill_options);
+    return true;
+  }
+
+  // FillRect() is deliberately not overridden: failing it makes
+  // CFX_RenderDevice::DrawPath() record rectangles as paths, instead of
+  // rectangles snapped to the pixel grid of the recording.
+
+  bool DrawCosmeticLine(const CFX_PointF& ptMoveTo,
+                        const CFX_PointF& ptLineTo,
+                        uint32_t color) override {
+    // A zero line width keeps the line one pixel wide at any replay scale.
+    CFX_GraphStateData graph_state;
+    graph_state.set_line_width(0.0f);
+    CFX_Path path;
+    path.AppendLine(ptMoveTo, ptLineTo);
+    display_list_->DrawPath(path, nullptr, &graph_state, /*fill_color=*/0,
+                            color, CFX_FillRenderOptions());
+    return true;
+  }
+
+  FX_RECT GetClipBox() const override { return clip_box_; }
+
+  bool SetDIBits(RetainPtr<const CFX_DIBBase> bitmap,
+                 uint32_t color,
+                 const FX_RECT& src_rect,
+                 int dest_left,
+                 int dest_top,
+                 BlendMode blend_type) override {
+    RetainPtr<const CFX_DIBBase> source = bitmap->RealizeIfNeeded();
+    if (src_rect != FX_RECT(0, 0, bitmap->GetWidth(), bitmap->GetHeight())) {
+      source = source->ClipTo(src_rect);
+      if (!source) {
+        return false;
+      }
+    }
+    display_list_->DrawBitmap(
+        std::move(source), /*alpha=*/1.0f, color,
+        CFX_RenderDevice::GetFlipMatrix(src_rect.Width(), src_rect.Height(),
+                                        dest_left, dest_top),
+        /*clip_rect=*/nullptr, FXDIB_ResampleOptions(), blend_type);
+    return true;
+  }
+
+  bool StretchDIBits(RetainPtr<const CFX_DIBBase> bitmap,
+                     uint32_t color,
+                     int dest_left,
+                     int dest_top,
+                     int dest_width,
+                     int dest_height,
+                     const FX_RECT* pClipRect,
+                     const FXDIB_ResampleOptions& options,
+                     BlendMode blend_type) override {
+    display_list_->DrawBitmap(
+        bitmap->RealizeIfNeeded(), /*alpha=*/1.0f, color,
+        CFX_RenderDevice::GetFlipMatrix(dest_width, dest_height, dest_left,
+                                        dest_top),
+        pClipRect, options, blend_type);
+    return true;
+  }
+
+  StartResult StartDIBits(RetainPtr<const CFX_DIBBase> bitmap,
+                          float alpha,
+                          uint32_t color,
+                          const CFX_Matrix& matrix,
+                          const FXDIB_ResampleOptions& options,
+                          BlendMode blend_type) override {
+    display_list_->DrawBitmap(bitmap->RealizeIfNeeded(), alpha, color, matrix,
+                              /*clip_rect=*/nullptr, options, blend_type);
+    return {Result::kSuccess, nullptr};
+  }
+
+  bool DrawDeviceText(pdfium::span<const TextCharPos> pCharPos,
+                      CFX_Font* pFont,
+                      const CFX_Matrix& mtObject2Device,
+                      float font_size,
+                      uint32_t color,
+                      const CFX_TextRenderOptions& options) override {
+    display_list_->DrawText(pCharPos, pFont, mtObject2Device, font_size, color,
+                            options);
+    return true;
+  }
+
+  // The device has no pixels to multiply.
+  bool MultiplyAlpha(float alpha) override { return false; }
+  bool MultiplyAlphaMask(RetainPtr<const CFX_DIBitmap> mask) override {
+    return false;
+  }
+
+ private:
+  const int width_;
+  const int height_;
+  FX_RECT clip_box_;
+  std::vector<FX_RECT> saved_clip_boxes_;
+  std::unique_ptr<CFX_DisplayList> display_list_;
+};
+
+}  // namespace
+
+CFX_RecordingRenderDevice::CFX_RecordingRenderDevice(int width, int height) {
+  SetDeviceDriver(std::make_unique<CFX_RecordingDeviceDriver>(width, height));
+}
+
+CFX_RecordingRenderDevice::~CFX_RecordingRenderDevice() = default;
+
+std::unique_ptr<CFX_DisplayList> CFX_RecordingRenderDevice::TakeDisplayList() {
+  return static_cast<CFX_RecordingDeviceDriver*>(GetDeviceDriver())
+      ->TakeDisplayList();
+}
@@ -0,0 +1,27 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FXGE_CFX_RECORDINGRENDERDEVICE_H_
+#define CORE_FXGE_CFX_RECORDINGRENDERDEVICE_H_
+
+#include <memory>
+
+#include "core/fxge/cfx_renderdevice.h"
+
+class CFX_DisplayList;
+
+// A render device that records what is drawn to it into a CFX_DisplayList
+// instead of rasterizing it. There is no backing bitmap, so the device does
+// not report FXRC_GET_BITS, and content that has to be composited against
+// the device pixels is recorded as the bitmap its renderer produced.
+class CFX_RecordingRenderDevice final : public CFX_RenderDevice {
+ public:
+  CFX_RecordingRenderDevice(int width, int height);
+  ~CFX_RecordingRenderDevice() override;
+
+  // Returns the operations recorded so far, and starts a new empty list.
+  std::unique_ptr<CFX_DisplayList> TakeDisplayList();
+};
+
+#endif  // CORE_FXGE_CFX_RECORDINGRENDERDEVICE_H_
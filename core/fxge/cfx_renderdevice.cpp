@@ -9,6 +9,7 @@
 #include <math.h>
 
 #include <algorithm>
+#include <array>
 #include <memory>
 #include <utility>
 
@@ -27,10 +28,12 @@
 #include "core/fxge/cfx_gemodule.h"
 #include "core/fxge/cfx_glyphbitmap.h"
 #include "core/fxge/cfx_glyphcache.h"
+#include "core/fxge/cfx_glyphoutline.h"
 #include "core/fxge/cfx_graphstatedata.h"
 #include "core/fxge/cfx_path.h"
 #include "core/fxge/cfx_textrenderoptions.h"
 #include "core/fxge/dib/cfx_dibitmap.h"
+#include "core/fxge/dib/cfx_scanlinecompositor.h"
 #include "core/fxge/fx_font.h"
 #include "core/fxge/renderdevicedriver_iface.h"
 #include "core/fxge/text_char_pos.h"
@@ -113,18 +116,38 @@ int CalcAlpha(int src, int alpha) {
   return src * alpha / 255;
 }
 
-void MergeGammaAdjust(uint8_t src, int channel, int alpha, uint8_t* dest) {
-  *dest =
-      FXDIB_ALPHA_MERGE(*dest, channel, CalcAlpha(TextGammaAdjust(src), alpha));
+// Maps glyph coverage values to the alpha they are blended with, folding the
+// text gamma adjustment and the fill alpha into one lookup. Built once per
+// text run.
+class TextAlphaTable {
+ public:
+  explicit TextAlphaTable(int fill_alpha) {
+    for (int i = 0; i < 256; ++i) {
+      alpha_[i] = CalcAlpha(TextGammaAdjust(i), fill_alpha);
+    }
+  }
+
+  int operator[](int value) const { return alpha_[value]; }
+
+ private:
+  std::array<uint8_t, 256> alpha_;
+};
+
+void MergeGammaAdjust(uint8_t src,
+                      int channel,
+                      const TextAlphaTable& alpha,
+                      uint8_t* dest) {
+  *dest = FXDIB_ALPHA_MERGE(*dest, channel, alpha[src]);
 }
 
 void MergeGammaAdjustRgb(const uint8_t* src,
                          const FX_BGRA_STRUCT<uint8_t>& bgra,
+                         const TextAlphaTable& alpha,
                          uint8_t* dest) {
   UNSAFE_TODO({
-    MergeGammaAdjust(src[2], bgra.blue, bgra.alpha, &dest[0]);
-    MergeGammaAdjust(src[1], bgra.green, bgra.alpha, &dest[1]);
-    MergeGammaAdjust(src[0], bgra.red, bgra.alpha, &dest[2]);
+    MergeGammaAdjust(src[2], bgra.blue, alpha, &dest[0]);
+    MergeGammaAdjust(src[1], bgra.green, alpha, &dest[1]);
+    MergeGammaAdjust(src[0], bgra.red, alpha, &dest[2]);
   });
 }
 
@@ -153,8 +176,7 @@ void ApplyDestAlpha(uint8_t back_alpha,
   UNSAFE_TODO(dest[3] = dest_alpha);
 }
 
-void NormalizeArgb(int src_value,
-                   const FX_BGRA_STRUCT<uint8_t>& bgra,
+void NormalizeArgb(const FX_BGRA_STRUCT<uint8_t>& bgra,
                    uint8_t* dest,
                    int src_alpha) {
   UNSAFE_TODO({
@@ -168,47 +190,133 @@ void NormalizeArgb(int src_value,
   });
 }
 
-void NormalizeDest(bool has_alpha,
-                   int src_value,
+template <bool kHasAlpha>
+void NormalizeDest(int src_value,
                    const FX_BGRA_STRUCT<uint8_t>& bgra,
+                   const TextAlphaTable& alpha,
                    uint8_t* dest) {
-  if (has_alpha) {
-    NormalizeArgb(src_value, bgra, dest,
-                  CalcAlpha(TextGammaAdjust(src_value), bgra.alpha));
-    return;
+  const int src_alpha = alpha[src_value];
+  if constexpr (kHasAlpha) {
+    NormalizeArgb(bgra, dest, src_alpha);
+  } else if (src_alpha != 0) {
+    ApplyAlpha(dest, bgra, src_alpha);
   }
-  int src_alpha = CalcAlpha(TextGammaAdjust(src_value), bgra.alpha);
-  if (src_alpha == 0) {
-    return;
-  }
-
-  ApplyAlpha(dest, bgra, src_alpha);
 }
 
-void NormalizeSrc(bool has_alpha,
-                  int src_value,
+template <bool kHasAlpha>
+void NormalizeSrc(int src_value,
                   const FX_BGRA_STRUCT<uint8_t>& bgra,
+                  const TextAlphaTable& alpha,
                   uint8_t* dest) {
-  if (!has_alpha) {
-    ApplyAlpha(dest, bgra, CalcAlpha(TextGammaAdjust(src_value), bgra.alpha));
-    return;
+  const int src_alpha = alpha[src_value];
+  if constexpr (kHasAlpha) {
+    if (src_alpha != 0) {
+      NormalizeArgb(bgra, dest, src_alpha);
+    }
+  } else {
+    ApplyAlpha(dest, bgra, src_alpha);
   }
-  int src_alpha = CalcAlpha(TextGammaAdjust(src_value), bgra.alpha);
-  if (src_alpha != 0) {
-    NormalizeArgb(src_value, bgra, dest, src_alpha);
+}
+
+template <bool kHasAlpha>
+void SetAlpha(uint8_t* dest) {
+  if constexpr (kHasAlpha) {
+    UNSAFE_TODO(dest[3] = 255);
   }
 }
 
-void NextPixel(const uint8_t** src_scan, uint8_t** dst_scan, int bpp) {
+// Composites one row of an LCD glyph, whose pixels are 3 coverage values
+// each, onto `dest_scan`. `src_scan` and `dest_scan` point at column
+// `start_col`. The destination layout and the normalization mode are
+// template parameters so that the per-pixel loops do not branch on them.
+template <bool kHasAlpha, bool kNormalize>
+void CompositeLcdGlyphRow(const uint8_t* src_scan,
+                          uint8_t* dest_scan,
+                          int bytes_per_pixel,
+                          int left,
+                          int start_col,
+                          int end_col,
+                          int x_subpixel,
+                          const FX_BGRA_STRUCT<uint8_t>& bgra,
+                          const TextAlphaTable& alpha) {
   UNSAFE_TODO({
-    *src_scan += 3;
-    *dst_scan += bpp;
+    // Offset of the source pixel blended into each destination pixel, which
+    // straddles two glyph pixels when the glyph origin is not pixel-aligned.
+    int src_offset = 0;
+    int col = start_col;
+    if (x_subpixel == 1) {
+      src_offset = -1;
+      if constexpr (kNormalize) {
+        int src_value = start_col > left ? AverageRgb(&src_scan[-1])
+                                         : (src_scan[0] + src_scan[1]) / 3;
+        NormalizeSrc<kHasAlpha>(src_value, bgra, alpha, dest_scan);
+      } else {
+        if (start_col > left) {
+          MergeGammaAdjust(src_scan[-1], bgra.red, alpha, &dest_scan[2]);
+        }
+        MergeGammaAdjust(src_scan[0], bgra.green, alpha, &dest_scan[1]);
+        MergeGammaAdjust(src_scan[1], bgra.blue, alpha, &dest_scan[0]);
+        SetAlpha<kHasAlpha>(dest_scan);
+      }
+    } else if (x_subpixel != 0) {
+      src_offset = -2;
+      if constexpr (kNormalize) {
+        int src_value =
+            start_col > left ? AverageRgb(&src_scan[-2]) : src_scan[0] / 3;
+        NormalizeSrc<kHasAlpha>(src_value, bgra, alpha, dest_scan);
+      } else {
+        if (start_col > left) {
+          MergeGammaAdjust(src_scan[-2], bgra.red, alpha, &dest_scan[2]);
+          MergeGammaAdjust(src_scan[-1], bgra.green, alpha, &dest_scan[1]);
+        }
+        MergeGammaAdjust(src_scan[0], bgra.blue, alpha, &dest_scan[0]);
+        SetAlpha<kHasAlpha>(dest_scan);
+      }
+    }
+    if (src_offset != 0) {
+      src_scan += 3;
+      dest_scan += bytes_per_pixel;
+      ++col;
+    }
+    const uint8_t* src = src_scan + src_offset;
+    for (; col < end_col; ++col) {
+      if constexpr (kNormalize) {
+        NormalizeDest<kHasAlpha>(AverageRgb(src), bgra, alpha, dest_scan);
+      } else {
+        MergeGammaAdjustRgb(src, bgra, alpha, dest_scan);
+        SetAlpha<kHasAlpha>(dest_scan);
+      }
+      src += 3;
+      dest_scan += bytes_per_pixel;
+    }
   });
 }
 
-void SetAlpha(bool has_alpha, uint8_t* alpha) {
-  if (has_alpha) {
-    UNSAFE_TODO(alpha[3] = 255);
+template <bool kHasAlpha, bool kNormalize>
+void CompositeLcdGlyph(const RetainPtr<CFX_DIBitmap>& bitmap,
+                       const RetainPtr<CFX_DIBitmap>& pGlyph,
+                       int start_row,
+                       int end_row,
+                       int left,
+                       int top,
+                       int start_col,
+                       int end_col,
+                       int x_subpixel,
+                       const FX_BGRA_STRUCT<uint8_t>& bgra,
+                       const TextAlphaTable& alpha) {
+  const int bytes_per_pixel = kHasAlpha ? 4 : bitmap->GetBPP() / 8;
+  for (int row = start_row; row < end_row; ++row) {
+    const uint8_t* src_scan =
+        pGlyph->GetScanline(row)
+            .subspan(static_cast<size_t>((start_col - left) * 3))
+            .data();
+    uint8_t* dest_scan =
+        bitmap->GetWritableScanline(row + top)
+            .subspan(static_cast<size_t>(start_col * bytes_per_pixel))
+            .data();
+    CompositeLcdGlyphRow<kHasAlpha, kNormalize>(
+        src_scan, dest_scan, bytes_per_pixel, left, start_col, end_col,
+        x_subpixel, bgra, alpha);
   }
 }
 
@@ -221,92 +329,110 @@ void DrawNormalTextHelper(const RetainPtr<CFX_DIBitmap>& bitmap,
                           int end_col,
                           bool normalize,
                           int x_subpixel,
-                          const FX_BGRA_STRUCT<uint8_t>& bgra) {
+                          const FX_BGRA_STRUCT<uint8_t>& bgra,
+                          const TextAlphaTable& alpha) {
   // TODO(crbug.com/42271020): Add support for `FXDIB_Format::kBgraPremul`.
   CHECK(!bitmap->IsPremultiplied());
+
+  // Clip the glyph rows against the bitmap once, rather than per row.
+  FX_SAFE_INT32 safe_start_row = 0;
+  safe_start_row -= top;
+  FX_SAFE_INT32 safe_end_row = bitmap->GetHeight();
+  safe_end_row -= top;
+  if (!safe_start_row.IsValid() || !safe_end_row.IsValid()) {
+    return;
+  }
+  const int start_row = std::max<int>(0, safe_start_row.ValueOrDie());
+  const int end_row = std::min<int>(nrows, safe_end_row.ValueOrDie());
+  if (start_row >= end_row) {
+    return;
+  }
+
   const bool has_alpha = bitmap->IsAlphaFormat();
-  const int bytes_per_pixel = has_alpha ? 4 : bitmap->GetBPP() / 8;
-  for (int row = 0; row < nrows; ++row) {
-    FX_SAFE_INT32 safe_dest_row = row;
-    safe_dest_row += top;
-    const int dest_row = safe_dest_row.ValueOrDefault(-1);
-    if (dest_row < 0 || dest_row >= bitmap->GetHeight()) {
+  if (has_alpha) {
+    if (normalize) {
+      CompositeLcdGlyph<true, true>(bitmap, pGlyph, start_row, end_row, left,
+                                    top, start_col, end_col, x_subpixel, bgra,
+                                    alpha);
+    } else {
+      CompositeLcdGlyph<true, false>(bitmap, pGlyph, start_row, end_row, left,
+                                     top, start_col, end_col, x_subpixel, bgra,
+                                     alpha);
+    }
+    return;
+  }
+  if (normalize) {
+    CompositeLcdGlyph<false, true>(bitmap, pGlyph, start_row, end_row, left,
+                                   top, start_col, end_col, x_subpixel, bgra,
+                                   alpha);
+  } else {
+    CompositeLcdGlyph<false, false>(bitmap, pGlyph, start_row, end_row, left,
+                                    top, start_col, end_col, x_subpixel, bgra,
+                                    alpha);
+  }
+}
+
+// Composites the 8bpp coverage masks of all glyphs in a text run onto
+// `bitmap`. This is what CFX_DIBitmap::CompositeMask() does per glyph, but
+// the scanline compositor is set up once for the whole run.
+bool CompositeGlyphRun(const RetainPtr<CFX_DIBitmap>& bitmap,
+                       pdfium::span<const TextGlyphPos> glyphs,
+                       const CFX_Point& offset,
+                       uint32_t fill_color) {
+  if (FXARGB_A(fill_color) == 0) {
+    return true;
+  }
+
+  CFX_ScanlineCompositor compositor;
+  if (!compositor.Init(bitmap->GetFormat(), FXDIB_Format::k8bppMask, {},
+                       fill_color, BlendMode::kNormal,
+                       /*bRgbByteOrder=*/false)) {
+    return false;
+  }
+
+  const int bytes_per_pixel = bitmap->GetBPP() / 8;
+  for (const TextGlyphPos& glyph : glyphs) {
+    if (!glyph.glyph_) {
       continue;
     }
 
-    const uint8_t* src_scan =
-        pGlyph->GetScanline(row)
-            .subspan(static_cast<size_t>((start_col - left) * 3))
-            .data();
-    uint8_t* dest_scan =
-        bitmap->GetWritableScanline(dest_row)
-            .subspan(static_cast<size_t>(start_col * bytes_per_pixel))
-            .data();
-    if (x_subpixel == 0) {
-      for (int col = start_col; col < end_col; ++col) {
-        if (normalize) {
-          int src_value = AverageRgb(&src_scan[0]);
-          NormalizeDest(has_alpha, src_value, bgra, dest_scan);
-        } else {
-          MergeGammaAdjustRgb(&src_scan[0], bgra, &dest_scan[0]);
-          SetAlpha(has_alpha, dest_scan);
-        }
-        NextPixel(&src_scan, &dest_scan, bytes_per_pixel);
-      }
+    std::optional<CFX_Point> point = glyph.GetOrigin(offset);
+    if (!point.has_value()) {
       continue;
     }
-    UNSAFE_TODO({
-      if (x_subpixel == 1) {
-        if (normalize) {
-          int src_value = start_col > left ? AverageRgb(&src_scan[-1])
-                                           : (src_scan[0] + src_scan[1]) / 3;
-          NormalizeSrc(has_alpha, src_value, bgra, dest_scan);
-        } else {
-          if (start_col > left) {
-            MergeGammaAdjust(src_scan[-1], bgra.red, bgra.alpha, &dest_scan[2]);
-          }
-          MergeGammaAdjust(src_scan[0], bgra.green, bgra.alpha, &dest_scan[1]);
-          MergeGammaAdjust(src_scan[1], bgra.blue, bgra.alpha, &dest_scan[0]);
-          SetAlpha(has_alpha, dest_scan);
-        }
-        NextPixel(&src_scan, &dest_scan, bytes_per_pixel);
-        for (int col = start_col + 1; col < end_col; ++col) {
-          if (normalize) {
-            int src_value = AverageRgb(&src_scan[-1]);
-            NormalizeDest(has_alpha, src_value, bgra, dest_scan);
-          } else {
-            MergeGammaAdjustRgb(&src_scan[-1], bgra, &dest_scan[0]);
-            SetAlpha(has_alpha, dest_scan);
-          }
-          NextPixel(&src_scan, &dest_scan, bytes_per_pixel);
-        }
-        continue;
-      }
-      if (normalize) {
-        int src_value =
-            start_col > left ? AverageRgb(&src_scan[-2]) : src_scan[0] / 3;
-        NormalizeSrc(has_alpha, src_value, bgra, dest_scan);
-      } else {
-        if (start_col > left) {
-          MergeGammaAdjust(src_scan[-2], bgra.red, bgra.alpha, &dest_scan[2]);
-          MergeGammaAdjust(src_scan[-1], bgra.green, bgra.alpha, &dest_scan[1]);
-        }
-        MergeGammaAdjust(src_scan[0], bgra.blue, bgra.alpha, &dest_scan[0]);
-        SetAlpha(has_alpha, dest_scan);
-      }
-      NextPixel(&src_scan, &dest_scan, bytes_per_pixel);
-      for (int col = start_col + 1; col < end_col; ++col) {
-        if (normalize) {
-          int src_value = AverageRgb(&src_scan[-2]);
-          NormalizeDest(has_alpha, src_value, bgra, dest_scan);
-        } else {
-          MergeGammaAdjustRgb(&src_scan[-2], bgra, &dest_scan[0]);
-          SetAlpha(has_alpha, dest_scan);
-        }
-        NextPixel(&src_scan, &dest_scan, bytes_per_pixel);
+
+    const RetainPtr<CFX_DIBitmap>& pGlyph = glyph.glyph_->GetBitmap();
+    if (pGlyph->GetFormat() != FXDIB_Format::k8bppMask) {
+      if (!bitmap->CompositeMask(point.value().x, point.value().y,
+                                 pGlyph->GetWidth(), pGlyph->GetHeight(),
+                                 pGlyph, fill_color, 0, 0, BlendMode::kNormal,
+                                 nullptr, false)) {
+        return false;
       }
-    });
+      continue;
+    }
+
+    int dest_left = point.value().x;
+    int dest_top = point.value().y;
+    int width = pGlyph->GetWidth();
+    int height = pGlyph->GetHeight();
+    int src_left = 0;
+    int src_top = 0;
+    if (!bitmap->GetOverlapRect(dest_left, dest_top, width, height,
+                                pGlyph->GetWidth(), pGlyph->GetHeight(),
+                                src_left, src_top, nullptr)) {
+      continue;
+    }
+    for (int row = 0; row < height; ++row) {
+      compositor.CompositeByteMaskLine(
+          bitmap->GetWritableScanline(dest_top + row)
+              .subspan(static_cast<size_t>(dest_left * bytes_per_pixel)),
+          pGlyph->GetScanline(src_top + row)
+              .subspan(static_cast<size_t>(src_left)),
+          width, {});
+    }
   }
+  return true;
 }
 
 bool ShouldDrawDeviceText(const CFX_Font* pFont,
@@ -574,9 +700,12 @@ bool CFX_RenderDevice::CreateCompatibleBitmap(
     const RetainPtr<CFX_DIBitmap>& pDIB,
     int width,
     int height) const {
-  return pDIB->Create(
-      width, height,
-      GetCreateCompatibleBitmapFormat(render_caps_, /*use_argb_premul=*/true));
+  return pDIB->Create(width, height, GetCompatibleBitmapFormat());
+}
+
+FXDIB_Format CFX_RenderDevice::GetCompatibleBitmapFormat() const {
+  return GetCreateCompatibleBitmapFormat(render_caps_,
+                                         /*use_argb_premul=*/true);
 }
 
 void CFX_RenderDevice::SetBaseClip(const FX_RECT& rect) {
@@ -742,24 +871,25 @@ bool CFX_RenderDevice::DrawPath(const CFX_Path& path,
   }
 
   if (fill && fill_alpha && stroke_alpha < 0xff && fill_options.stroke) {
-#if defined(PDF_USE_SKIA)
     if (render_caps_ & FXRC_FILLSTROKE_PATH) {
+#if defined(PDF_USE_SKIA)
       const bool using_skia = CFX_DefaultRenderDevice::UseSkiaRenderer();
       if (using_skia) {
         device_driver_->SetGroupKnockout(true);
       }
+#endif
       bool draw_fillstroke_path_result =
           device_driver_->DrawPath(path, pObject2Device, pGraphState,
                                    fill_color, stroke_color, fill_options);
-
+#if defined(PDF_USE_SKIA)
       if (using_skia) {
         // Restore the group knockout status for `device_driver_` after
         // finishing painting a fill-and-stroke path.
         device_driver_->SetGroupKnockout(false);
       }
+#endif
       return draw_fillstroke_path_result;
     }
-#endif  // defined(PDF_USE_SKIA)
     return DrawFillStrokePath(path, pObject2Device, pGraphState, fill_color,
                               stroke_color, fill_options);
   }
@@ -1175,20 +1305,43 @@ bool CFX_RenderDevice::DrawNormalText(pdfium::span<const TextCharPos> pCharPos,
                           nullptr, fill_color, 0, nullptr, path_options);
     }
   }
+  const bool subpixel_positioning =
+      options.subpixel_positioning && anti_alias == FT_RENDER_MODE_NORMAL;
+  if (subpixel_positioning) {
+    // Native glyph bitmaps are cached per glyph only, without the fraction.
+    text_options.native_text = false;
+  }
   std::vector<TextGlyphPos> glyphs(pCharPos.size());
   for (auto [charpos, glyph] : fxcrt::Zip(pCharPos, pdfium::span(glyphs))) {
     glyph.device_origin_ = text2Device.Transform(charpos.origin_);
-    glyph.origin_.x = anti_alias < FT_RENDER_MODE_LCD
-                          ? FXSYS_roundf(glyph.device_origin_.x)
-                          : static_cast<int>(floor(glyph.device_origin_.x));
+    int subpixel_x = 0;
+    if (subpixel_positioning) {
+      // The glyph bitmap carries the fraction, rounded to the nearest
+      // position the glyph cache renders at.
+      const float pixel_x = floorf(glyph.device_origin_.x);
+      subpixel_x = FXSYS_roundf((glyph.device_origin_.x - pixel_x) *
+                                CFX_GlyphCache::kSubpixelPositions);
+      // `pixel_x` is whole, so this only saturates values out of range.
+      glyph.origin_.x = FXSYS_roundf(pixel_x);
+      if (subpixel_x == CFX_GlyphCache::kSubpixelPositions) {
+        subpixel_x = 0;
+        ++glyph.origin_.x;
+      }
+    } else {
+      glyph.origin_.x = anti_alias < FT_RENDER_MODE_LCD
+                            ? FXSYS_roundf(glyph.device_origin_.x)
+                            : static_cast<int>(floor(glyph.device_origin_.x));
+    }
     glyph.origin_.y = FXSYS_roundf(glyph.device_origin_.y);
 
     CFX_Matrix matrix = charpos.GetEffectiveMatrix(char2device);
     glyph.glyph_ = pFont->LoadGlyphBitmap(
         charpos.glyph_index_, charpos.font_style_, matrix,
-        charpos.font_char_width_, anti_alias, &text_options);
+        charpos.font_char_width_, anti_alias, subpixel_x, &text_options);
   }
-  if (anti_alias < FT_RENDER_MODE_LCD && glyphs.size() > 1) {
+  // Glyphs positioned to a fraction of a pixel are already spaced evenly.
+  if (anti_alias < FT_RENDER_MODE_LCD && !subpixel_positioning &&
+      glyphs.size() > 1) {
     AdjustGlyphSpace(&glyphs);
   }
 
@@ -1245,12 +1398,22 @@ bool CFX_RenderDevice::DrawNormalText(pdfium::span<const TextCharPos> pCharPos,
       return false;
     }
   }
-  int dest_width = pixel_width;
-  FX_BGRA_STRUCT<uint8_t> bgra;
-  if (anti_alias == FT_RENDER_MODE_LCD) {
-    bgra = ArgbToBGRAStruct(fill_color);
+  if (anti_alias == FT_RENDER_MODE_NORMAL) {
+    if (!CompositeGlyphRun(bitmap, glyphs, {pixel_left, pixel_top},
+                           fill_color)) {
+      return false;
+    }
+    if (bitmap->IsMaskFormat()) {
+      SetBitMask(std::move(bitmap), bmp_rect.left, bmp_rect.top, fill_color);
+    } else {
+      SetDIBits(std::move(bitmap), bmp_rect.left, bmp_rect.top);
+    }
+    return true;
   }
 
+  int dest_width = pixel_width;
+  const FX_BGRA_STRUCT<uint8_t> bgra = ArgbToBGRAStruct(fill_color);
+  const TextAlphaTable alpha(bgra.alpha);
   for (const TextGlyphPos& glyph : glyphs) {
     if (!glyph.glyph_) {
       continue;
@@ -1262,17 +1425,8 @@ bool CFX_RenderDevice::DrawNormalText(pdfium::span<const TextCharPos> pCharPos,
     }
 
     const RetainPtr<CFX_DIBitmap>& pGlyph = glyph.glyph_->GetBitmap();
-    int ncols = pGlyph->GetWidth();
+    int ncols = pGlyph->GetWidth() / 3;
     int nrows = pGlyph->GetHeight();
-    if (anti_alias == FT_RENDER_MODE_NORMAL) {
-      if (!bitmap->CompositeMask(point.value().x, point.value().y, ncols, nrows,
-                                 pGlyph, fill_color, 0, 0, BlendMode::kNormal,
-                                 nullptr, false)) {
-        return false;
-      }
-      continue;
-    }
-    ncols /= 3;
     int x_subpixel = static_cast<int>(glyph.device_origin_.x * 3) % 3;
     int start_col = std::max(point->x, 0);
     FX_SAFE_INT32 end_col_safe = point->x;
@@ -1287,7 +1441,7 @@ bool CFX_RenderDevice::DrawNormalText(pdfium::span<const TextCharPos> pCharPos,
     }
 
     DrawNormalTextHelper(bitmap, pGlyph, nrows, point->x, point->y, start_col,
-                         end_col, normalize, x_subpixel, bgra);
+                         end_col, normalize, x_subpixel, bgra, alpha);
   }
 
   if (bitmap->IsMaskFormat()) {
@@ -1309,9 +1463,9 @@ bool CFX_RenderDevice::DrawTextPath(pdfium::span<const TextCharPos> pCharPos,
                                     CFX_Path* pClippingPath,
                                     const CFX_FillRenderOptions& fill_options) {
   for (const auto& charpos : pCharPos) {
-    const CFX_Path* pPath =
-        pFont->LoadGlyphPath(charpos.glyph_index_, charpos.font_char_width_);
-    if (!pPath) {
+    const CFX_GlyphOutline* outline = pFont->LoadGlyphOutline(
+        charpos.glyph_index_, charpos.font_char_width_);
+    if (!outline) {
       continue;
     }
 
@@ -1320,8 +1474,8 @@ bool CFX_RenderDevice::DrawTextPath(pdfium::span<const TextCharPos> pCharPos,
     matrix = charpos.GetEffectiveMatrix(matrix);
     matrix.Concat(mtText2User);
 
-    CFX_Path transformed_path(*pPath);
-    transformed_path.Transform(matrix);
+    CFX_Path transformed_path;
+    outline->AppendToPath(transformed_path, matrix);
     if (fill_color || stroke_color) {
       CFX_FillRenderOptions options(fill_options);
       if (fill_color) {
@@ -67,6 +67,8 @@ class CFX_RenderDevice {
   [[nodiscard]] bool CreateCompatibleBitmap(const RetainPtr<CFX_DIBitmap>& pDIB,
                                             int width,
                                             int height) const;
+  // Returns the format that CreateCompatibleBitmap() creates bitmaps in.
+  FXDIB_Format GetCompatibleBitmapFormat() const;
   const FX_RECT& GetClipBox() const { return clip_box_; }
   void SetBaseClip(const FX_RECT& rect);
   bool SetClip_PathFill(const CFX_Path& path,
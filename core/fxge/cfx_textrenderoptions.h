@@ -40,13 +40,18 @@ struct CFX_TextRenderOptions {
 
   // Using the native text output available on some platforms.
   bool native_text = true;
+
+  // Position glyphs to a fraction of a pixel, rather than to whole pixels.
+  // Only affects anti-aliased text without LCD optimization.
+  bool subpixel_positioning = false;
 };
 
 inline bool operator==(const CFX_TextRenderOptions& lhs,
                        const CFX_TextRenderOptions& rhs) {
   return lhs.aliasing_type == rhs.aliasing_type &&
          lhs.font_is_cid == rhs.font_is_cid &&
-         lhs.native_text == rhs.native_text;
+         lhs.native_text == rhs.native_text &&
+         lhs.subpixel_positioning == rhs.subpixel_positioning;
 }
 
 #endif  // CORE_FXGE_CFX_TEXTRENDEROPTIONS_H_
@@ -553,11 +553,9 @@ size_t CFX_DIBBase::GetEstimatedImageMemoryBurden() const {
   return GetRequiredPaletteSize() * sizeof(uint32_t);
 }
 
-#if BUILDFLAG(IS_WIN) || defined(PDF_USE_SKIA)
 RetainPtr<const CFX_DIBitmap> CFX_DIBBase::RealizeIfNeeded() const {
   return Realize();
 }
-#endif
 
 RetainPtr<CFX_DIBitmap> CFX_DIBBase::Realize() const {
   return ClipToInternal(nullptr);
@@ -29,16 +29,6 @@
 #include "core/fxge/cfx_defaultrenderdevice.h"
 #include "core/fxge/dib/cfx_scanlinecompositor.h"
 
-namespace {
-
-size_t GetAllocSizeOrZero(uint32_t size) {
-  FX_SAFE_SIZE_T safe_buffer_size = size;
-  safe_buffer_size += 4;
-  return safe_buffer_size.ValueOrDefault(0);
-}
-
-}  // namespace
-
 CFX_DIBitmap::CFX_DIBitmap() = default;
 
 bool CFX_DIBitmap::Create(int width, int height, FXDIB_Format format) {
@@ -51,6 +41,7 @@ bool CFX_DIBitmap::Create(int width,
                           uint8_t* pBuffer,
                           uint32_t pitch) {
   buffer_ = nullptr;
+  buffer_capacity_ = 0;
   SetFormat(format);
   SetWidth(0);
   SetHeight(0);
@@ -65,7 +56,8 @@ bool CFX_DIBitmap::Create(int width,
   if (pBuffer) {
     buffer_.Reset(pBuffer);
   } else {
-    const size_t buffer_size = GetAllocSizeOrZero(pitch_size.value().size);
+    const size_t buffer_size =
+        GetBufferCapacityForSize(pitch_size.value().size);
     if (buffer_size == 0) {
       return false;
     }
@@ -75,13 +67,41 @@ bool CFX_DIBitmap::Create(int width,
     if (!buffer_) {
       return false;
     }
+    buffer_capacity_ = buffer_size;
+  }
+  SetWidth(width);
+  SetHeight(height);
+  SetPitch(pitch_size.value().pitch);
+  return true;
+}
+
+bool CFX_DIBitmap::Recreate(int width, int height, FXDIB_Format format) {
+  std::optional<PitchAndSize> pitch_size =
+      CalculatePitchAndSize(width, height, format, /*pitch=*/0);
+  if (!pitch_size.has_value()) {
+    return false;
   }
+
+  if (!buffer_ || !buffer_.IsOwned() ||
+      GetBufferCapacityForSize(pitch_size.value().size) > buffer_capacity_) {
+    return Create(width, height, format);
+  }
+
+  palette_.clear();
+  SetFormat(format);
   SetWidth(width);
   SetHeight(height);
   SetPitch(pitch_size.value().pitch);
   return true;
 }
 
+// static
+size_t CFX_DIBitmap::GetBufferCapacityForSize(uint32_t size) {
+  FX_SAFE_SIZE_T safe_buffer_size = size;
+  safe_buffer_size += 4;
+  return safe_buffer_size.ValueOrDefault(0);
+}
+
 bool CFX_DIBitmap::Copy(RetainPtr<const CFX_DIBBase> source) {
   if (buffer_) {
     return false;
@@ -128,19 +148,19 @@ size_t CFX_DIBitmap::GetEstimatedImageMemoryBurden() const {
   return result;
 }
 
-#if BUILDFLAG(IS_WIN) || defined(PDF_USE_SKIA)
 RetainPtr<const CFX_DIBitmap> CFX_DIBitmap::RealizeIfNeeded() const {
   if (GetBuffer().empty()) {
     return Realize();
   }
   return pdfium::WrapRetain(this);
 }
-#endif
 
 void CFX_DIBitmap::TakeOver(RetainPtr<CFX_DIBitmap>&& pSrcBitmap) {
   buffer_ = std::move(pSrcBitmap->buffer_);
+  buffer_capacity_ = pSrcBitmap->buffer_capacity_;
   palette_ = std::move(pSrcBitmap->palette_);
   pSrcBitmap->buffer_ = nullptr;
+  pSrcBitmap->buffer_capacity_ = 0;
   SetFormat(pSrcBitmap->GetFormat());
   SetWidth(pSrcBitmap->GetWidth());
   SetHeight(pSrcBitmap->GetHeight());
@@ -957,7 +977,8 @@ bool CFX_DIBitmap::ConvertFormat(FXDIB_Format dest_format) {
     return false;
   }
 
-  const size_t dest_buf_size = GetAllocSizeOrZero(pitch_size.value().size);
+  const size_t dest_buf_size =
+      GetBufferCapacityForSize(pitch_size.value().size);
   if (dest_buf_size == 0) {
     return false;
   }
@@ -980,6 +1001,7 @@ bool CFX_DIBitmap::ConvertFormat(FXDIB_Format dest_format) {
                            GetHeight(), holder, /*src_left=*/0,
                            /*src_top=*/0);
   buffer_ = std::move(dest_buf);
+  buffer_capacity_ = dest_buf_size;
   SetFormat(dest_format);
   SetPitch(dest_pitch);
   return true;
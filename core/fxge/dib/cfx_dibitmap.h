@@ -57,16 +57,26 @@ class CFX_DIBitmap final : public CFX_DIBBase {
                             uint8_t* pBuffer,
                             uint32_t pitch);
 
+  // Like Create(), but keeps the existing buffer if this bitmap owns it and it
+  // is large enough for the new dimensions. A kept buffer retains its previous
+  // contents, so callers must initialize it as needed.
+  [[nodiscard]] bool Recreate(int width, int height, FXDIB_Format format);
+
+  // Returns the buffer capacity that Create() allocates and Recreate()
+  // requires for a bitmap of `size` bytes, or 0 on overflow.
+  static size_t GetBufferCapacityForSize(uint32_t size);
+
   bool Copy(RetainPtr<const CFX_DIBBase> source);
 
   // CFX_DIBBase
   pdfium::span<const uint8_t> GetScanline(int line) const override;
   size_t GetEstimatedImageMemoryBurden() const override;
-#if BUILDFLAG(IS_WIN) || defined(PDF_USE_SKIA)
   RetainPtr<const CFX_DIBitmap> RealizeIfNeeded() const override;
-#endif
 
   pdfium::span<const uint8_t> GetBuffer() const;
+  // Returns the size of the owned buffer, which may exceed GetBuffer().size()
+  // after Recreate(). Returns 0 for externally provided buffers.
+  size_t GetBufferCapacity() const { return buffer_capacity_; }
   pdfium::span<uint8_t> GetWritableBuffer() {
     pdfium::span<const uint8_t> src = GetBuffer();
     // SAFETY: const_cast<>() doesn't change size.
@@ -203,6 +213,7 @@ class CFX_DIBitmap final : public CFX_DIBBase {
                                   int src_top);
 
   MaybeOwned<uint8_t, FxFreeDeleter> buffer_;
+  size_t buffer_capacity_ = 0;
 };
 
 #endif  // CORE_FXGE_DIB_CFX_DIBITMAP_H_
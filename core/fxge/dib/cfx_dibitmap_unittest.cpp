@@ -27,6 +27,44 @@ TEST(CFXDIBitmapTest, Create) {
   EXPECT_TRUE(pBitmap->Create(400, 300, FXDIB_Format::k1bppRgb));
 }
 
+TEST(CFXDIBitmapTest, Recreate) {
+  auto bitmap = pdfium::MakeRetain<CFX_DIBitmap>();
+  ASSERT_TRUE(bitmap->Create(100, 100, FXDIB_Format::kBgra));
+  const uint8_t* buffer = bitmap->GetBuffer().data();
+  const size_t capacity = bitmap->GetBufferCapacity();
+  EXPECT_GE(capacity, 40000u);
+
+  // Shrinking keeps the buffer.
+  ASSERT_TRUE(bitmap->Recreate(50, 100, FXDIB_Format::k8bppMask));
+  EXPECT_EQ(buffer, bitmap->GetBuffer().data());
+  EXPECT_EQ(capacity, bitmap->GetBufferCapacity());
+  EXPECT_EQ(50, bitmap->GetWidth());
+  EXPECT_EQ(100, bitmap->GetHeight());
+  EXPECT_EQ(52u, bitmap->GetPitch());
+  EXPECT_EQ(FXDIB_Format::k8bppMask, bitmap->GetFormat());
+
+  // Growing past the capacity allocates a new buffer.
+  ASSERT_TRUE(bitmap->Recreate(200, 100, FXDIB_Format::kBgra));
+  EXPECT_GE(bitmap->GetBufferCapacity(), 80000u);
+  EXPECT_EQ(200, bitmap->GetWidth());
+
+  EXPECT_FALSE(bitmap->Recreate(0, 100, FXDIB_Format::kBgra));
+}
+
+TEST(CFXDIBitmapTest, RecreateAtExactCapacity) {
+  auto bitmap = pdfium::MakeRetain<CFX_DIBitmap>();
+  ASSERT_TRUE(bitmap->Create(100, 100, FXDIB_Format::kBgra));
+  EXPECT_EQ(CFX_DIBitmap::GetBufferCapacityForSize(40000),
+            bitmap->GetBufferCapacity());
+  const uint8_t* buffer = bitmap->GetBuffer().data();
+
+  // A bitmap that needs exactly the capacity keeps the buffer.
+  ASSERT_TRUE(bitmap->Recreate(200, 50, FXDIB_Format::kBgra));
+  EXPECT_EQ(buffer, bitmap->GetBuffer().data());
+  EXPECT_EQ(CFX_DIBitmap::GetBufferCapacityForSize(40000),
+            bitmap->GetBufferCapacity());
+}
+
 TEST(CFXDIBitmapTest, CalculatePitchAndSizeGood) {
   // Simple case with no provided pitch.
   std::optional<CFX_DIBitmap::PitchAndSize> result =
@@ -0,0 +1,112 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxge/dib/cfx_dibitmappool.h"
+
+#include <algorithm>
+#include <bit>
+#include <optional>
+#include <utility>
+
+#include "core/fxcrt/check_op.h"
+#include "core/fxge/dib/cfx_dibitmap.h"
+
+CFX_DIBitmapPool::CFX_DIBitmapPool()
+    : CFX_DIBitmapPool(kDefaultMaxPooledBytes) {}
+
+CFX_DIBitmapPool::CFX_DIBitmapPool(size_t max_pooled_bytes)
+    : max_pooled_bytes_(max_pooled_bytes) {}
+
+CFX_DIBitmapPool::~CFX_DIBitmapPool() = default;
+
+RetainPtr<CFX_DIBitmap> CFX_DIBitmapPool::Acquire(int width,
+                                                  int height,
+                                                  FXDIB_Format format,
+                                                  Contents contents) {
+  ++stats_.acquire_count;
+  std::optional<CFX_DIBitmap::PitchAndSize> pitch_size =
+      CFX_DIBitmap::CalculatePitchAndSize(width, height, format, /*pitch=*/0);
+  if (!pitch_size.has_value()) {
+    return nullptr;
+  }
+
+  // Pick the smallest idle bitmap that Recreate() can reuse, without handing
+  // out buffers that are more than one size class too big.
+  const size_t size = pitch_size.value().size;
+  const size_t required = CFX_DIBitmap::GetBufferCapacityForSize(size);
+  if (required == 0) {
+    return nullptr;
+  }
+
+  const size_t size_class = GetSizeClass(required);
+  CFX_DIBitmap* best = nullptr;
+  for (const RetainPtr<CFX_DIBitmap>& bitmap : bitmaps_) {
+    const size_t capacity = bitmap->GetBufferCapacity();
+    if (!bitmap->HasOneRef() || capacity < required ||
+        GetSizeClass(capacity) > size_class + 1) {
+      continue;
+    }
+    if (!best || capacity < best->GetBufferCapacity()) {
+      best = bitmap.Get();
+    }
+  }
+
+  if (best) {
+    const size_t old_capacity = best->GetBufferCapacity();
+    if (!best->Recreate(width, height, format)) {
+      return nullptr;
+    }
+    CHECK_EQ(old_capacity, best->GetBufferCapacity());
+    ++stats_.reuse_count;
+    stats_.bytes_reused += size;
+    if (contents == Contents::kZeroed) {
+      std::ranges::fill(best->GetWritableBuffer(), 0);
+    } else {
+      ++stats_.clears_skipped;
+    }
+    return pdfium::WrapRetain(best);
+  }
+
+  auto bitmap = pdfium::MakeRetain<CFX_DIBitmap>();
+  if (!bitmap->Create(width, height, format)) {
+    return nullptr;
+  }
+
+  const size_t capacity = bitmap->GetBufferCapacity();
+  stats_.bytes_allocated += capacity;
+  if (GetPooledBytes() + capacity > max_pooled_bytes_) {
+    Trim();
+  }
+  if (GetPooledBytes() + capacity <= max_pooled_bytes_) {
+    bitmaps_.push_back(bitmap);
+  }
+  return bitmap;
+}
+
+void CFX_DIBitmapPool::Trim() {
+  std::erase_if(bitmaps_, [](const RetainPtr<CFX_DIBitmap>& bitmap) {
+    return bitmap->HasOneRef();
+  });
+}
+
+size_t CFX_DIBitmapPool::GetPooledBytes() const {
+  size_t result = 0;
+  for (const RetainPtr<CFX_DIBitmap>& bitmap : bitmaps_) {
+    result += bitmap->GetBufferCapacity();
+  }
+  return result;
+}
+
+// static
+size_t CFX_DIBitmapPool::GetSizeClass(size_t size) {
+  if (size <= 4) {
+    return size;
+  }
+
+  // `size` is in (2^log2, 2^(log2 + 1)], which is split into 4 classes.
+  const size_t log2 = std::bit_width(size - 1) - 1;
+  const size_t base = size_t{1} << log2;
+  const size_t step = base / 4;
+  return log2 * 4 + (size - base + step - 1) / step;
+}
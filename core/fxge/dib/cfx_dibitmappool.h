@@ -0,0 +1,66 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FXGE_DIB_CFX_DIBITMAPPOOL_H_
+#define CORE_FXGE_DIB_CFX_DIBITMAPPOOL_H_
+
+#include <stddef.h>
+
+#include <vector>
+
+#include "core/fxcrt/retain_ptr.h"
+#include "core/fxge/dib/fx_dib.h"
+
+class CFX_DIBitmap;
+
+// Recycles the scratch bitmaps that a render repeatedly creates and destroys,
+// such as transparency groups, soft masks and backdrops. The pool keeps a
+// reference to every bitmap it hands out, and reuses a bitmap's buffer once
+// the pool holds the only remaining reference to it.
+class CFX_DIBitmapPool {
+ public:
+  // Whether Acquire() must return a zero-filled bitmap, or whether the caller
+  // overwrites every pixel itself.
+  enum class Contents : bool { kZeroed, kUninitialized };
+
+  struct Stats {
+    size_t acquire_count = 0;
+    size_t reuse_count = 0;
+    size_t bytes_allocated = 0;
+    size_t bytes_reused = 0;
+    size_t clears_skipped = 0;
+  };
+
+  static constexpr size_t kDefaultMaxPooledBytes = 64 * 1024 * 1024;
+
+  CFX_DIBitmapPool();
+  explicit CFX_DIBitmapPool(size_t max_pooled_bytes);
+  CFX_DIBitmapPool(const CFX_DIBitmapPool&) = delete;
+  CFX_DIBitmapPool& operator=(const CFX_DIBitmapPool&) = delete;
+  ~CFX_DIBitmapPool();
+
+  // Returns a `width` x `height` bitmap in `format`, or nullptr on failure.
+  RetainPtr<CFX_DIBitmap> Acquire(int width,
+                                  int height,
+                                  FXDIB_Format format,
+                                  Contents contents);
+
+  // Releases all pooled bitmaps that are not in use.
+  void Trim();
+
+  // Returns the buffer size of all bitmaps the pool holds, in use or not.
+  size_t GetPooledBytes() const;
+  const Stats& stats() const { return stats_; }
+
+  // Bitmaps with buffers in the same or adjacent size classes can share them.
+  // Size classes are spaced at quarter powers of two.
+  static size_t GetSizeClass(size_t size);
+
+ private:
+  const size_t max_pooled_bytes_;
+  std::vector<RetainPtr<CFX_DIBitmap>> bitmaps_;
+  Stats stats_;
+};
+
+#endif  // CORE_FXGE_DIB_CFX_DIBITMAPPOOL_H_
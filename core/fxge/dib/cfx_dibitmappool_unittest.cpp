@@ -0,0 +1,147 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxge/dib/cfx_dibitmappool.h"
+
+#include <stdint.h>
+
+#include <algorithm>
+
+#include "core/fxge/dib/cfx_dibitmap.h"
+#include "core/fxge/dib/fx_dib.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+using Contents = CFX_DIBitmapPool::Contents;
+
+TEST(CFXDIBitmapPoolTest, SizeClass) {
+  EXPECT_EQ(0u, CFX_DIBitmapPool::GetSizeClass(0));
+  EXPECT_EQ(4u, CFX_DIBitmapPool::GetSizeClass(4));
+  EXPECT_EQ(CFX_DIBitmapPool::GetSizeClass(1000),
+            CFX_DIBitmapPool::GetSizeClass(1024));
+  EXPECT_EQ(CFX_DIBitmapPool::GetSizeClass(1024) + 1,
+            CFX_DIBitmapPool::GetSizeClass(1025));
+  EXPECT_EQ(CFX_DIBitmapPool::GetSizeClass(1024) + 4,
+            CFX_DIBitmapPool::GetSizeClass(2048));
+
+  size_t last_class = 0;
+  for (size_t size = 1; size < 100000; ++size) {
+    const size_t size_class = CFX_DIBitmapPool::GetSizeClass(size);
+    EXPECT_GE(size_class, last_class);
+    last_class = size_class;
+  }
+}
+
+TEST(CFXDIBitmapPoolTest, ReuseReleasedBitmap) {
+  CFX_DIBitmapPool pool;
+  RetainPtr<CFX_DIBitmap> bitmap =
+      pool.Acquire(100, 100, FXDIB_Format::kBgra, Contents::kZeroed);
+  ASSERT_TRUE(bitmap);
+  const uint8_t* buffer = bitmap->GetBuffer().data();
+
+  // Still in use, so a second request gets a new bitmap.
+  RetainPtr<CFX_DIBitmap> other =
+      pool.Acquire(100, 100, FXDIB_Format::kBgra, Contents::kZeroed);
+  ASSERT_TRUE(other);
+  EXPECT_NE(buffer, other->GetBuffer().data());
+  other.Reset();
+
+  bitmap->Clear(0xff102030);
+  bitmap.Reset();
+  EXPECT_EQ(0u, pool.stats().reuse_count);
+
+  // A smaller request in the same size class reuses a released buffer, and
+  // the contents get zeroed.
+  bitmap = pool.Acquire(90, 100, FXDIB_Format::kBgra, Contents::kZeroed);
+  ASSERT_TRUE(bitmap);
+  EXPECT_EQ(90, bitmap->GetWidth());
+  EXPECT_EQ(100, bitmap->GetHeight());
+  EXPECT_EQ(FXDIB_Format::kBgra, bitmap->GetFormat());
+  EXPECT_EQ(360u, bitmap->GetPitch());
+  EXPECT_TRUE(std::ranges::all_of(bitmap->GetBuffer(),
+                                  [](uint8_t value) { return value == 0; }));
+  EXPECT_EQ(1u, pool.stats().reuse_count);
+  EXPECT_EQ(0u, pool.stats().clears_skipped);
+  EXPECT_EQ(3u, pool.stats().acquire_count);
+}
+
+TEST(CFXDIBitmapPoolTest, ReuseAtExactCapacity) {
+  CFX_DIBitmapPool pool;
+  RetainPtr<CFX_DIBitmap> bitmap =
+      pool.Acquire(100, 100, FXDIB_Format::kBgra, Contents::kZeroed);
+  ASSERT_TRUE(bitmap);
+  const uint8_t* buffer = bitmap->GetBuffer().data();
+  bitmap.Reset();
+
+  // Needs the whole capacity of the released buffer, padding included.
+  bitmap = pool.Acquire(200, 50, FXDIB_Format::kBgra, Contents::kZeroed);
+  ASSERT_TRUE(bitmap);
+  EXPECT_EQ(buffer, bitmap->GetBuffer().data());
+  EXPECT_EQ(1u, pool.stats().reuse_count);
+  EXPECT_EQ(bitmap->GetBufferCapacity(), pool.GetPooledBytes());
+
+  // Needs one row more than the released buffer holds.
+  bitmap.Reset();
+  bitmap = pool.Acquire(200, 51, FXDIB_Format::kBgra, Contents::kZeroed);
+  ASSERT_TRUE(bitmap);
+  EXPECT_EQ(1u, pool.stats().reuse_count);
+}
+
+TEST(CFXDIBitmapPoolTest, UninitializedSkipsClear) {
+  CFX_DIBitmapPool pool;
+  RetainPtr<CFX_DIBitmap> bitmap =
+      pool.Acquire(50, 50, FXDIB_Format::k8bppMask, Contents::kUninitialized);
+  ASSERT_TRUE(bitmap);
+  bitmap->Clear(0xff000000);
+  bitmap.Reset();
+
+  bitmap = pool.Acquire(50, 50, FXDIB_Format::k8bppMask,
+                        Contents::kUninitialized);
+  ASSERT_TRUE(bitmap);
+  EXPECT_EQ(1u, pool.stats().reuse_count);
+  EXPECT_EQ(1u, pool.stats().clears_skipped);
+  EXPECT_EQ(0xff, bitmap->GetBuffer()[0]);
+}
+
+TEST(CFXDIBitmapPoolTest, NoReuseAcrossDistantSizeClasses) {
+  CFX_DIBitmapPool pool;
+  RetainPtr<CFX_DIBitmap> bitmap =
+      pool.Acquire(1000, 1000, FXDIB_Format::kBgra, Contents::kZeroed);
+  ASSERT_TRUE(bitmap);
+  bitmap.Reset();
+
+  // Far too small to be worth handing out the big buffer.
+  bitmap = pool.Acquire(10, 10, FXDIB_Format::kBgra, Contents::kZeroed);
+  ASSERT_TRUE(bitmap);
+  EXPECT_EQ(0u, pool.stats().reuse_count);
+  EXPECT_EQ(2u, pool.stats().acquire_count);
+}
+
+TEST(CFXDIBitmapPoolTest, BudgetAndTrim) {
+  CFX_DIBitmapPool pool(/*max_pooled_bytes=*/50000);
+  RetainPtr<CFX_DIBitmap> small =
+      pool.Acquire(100, 100, FXDIB_Format::kBgra, Contents::kZeroed);
+  ASSERT_TRUE(small);
+  EXPECT_EQ(small->GetBufferCapacity(), pool.GetPooledBytes());
+
+  // Does not fit in the budget, so the pool does not keep it.
+  RetainPtr<CFX_DIBitmap> big =
+      pool.Acquire(200, 200, FXDIB_Format::kBgra, Contents::kZeroed);
+  ASSERT_TRUE(big);
+  EXPECT_EQ(small->GetBufferCapacity(), pool.GetPooledBytes());
+
+  // Bitmaps in use survive Trim().
+  pool.Trim();
+  EXPECT_EQ(small->GetBufferCapacity(), pool.GetPooledBytes());
+
+  small.Reset();
+  pool.Trim();
+  EXPECT_EQ(0u, pool.GetPooledBytes());
+}
+
+TEST(CFXDIBitmapPoolTest, InvalidDimensions) {
+  CFX_DIBitmapPool pool;
+  EXPECT_FALSE(pool.Acquire(0, 10, FXDIB_Format::kBgra, Contents::kZeroed));
+  EXPECT_FALSE(pool.Acquire(10, 10, FXDIB_Format::kInvalid, Contents::kZeroed));
+  EXPECT_EQ(0u, pool.GetPooledBytes());
+}
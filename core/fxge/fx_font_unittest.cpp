@@ -2,9 +2,12 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <algorithm>
+#include <iterator>
 #include <string>
 
 #include "core/fxcrt/check.h"
+#include "core/fxcrt/data_vector.h"
 #include "core/fxge/cfx_folderfontinfo.h"
 #include "core/fxge/cfx_fontmapper.h"
 #include "core/fxge/cfx_gemodule.h"
@@ -54,3 +57,58 @@ TEST(FXFontTest, ReadFontNameFromMicrosoftEntries) {
   ASSERT_EQ(1u, font_mapper.GetFaceSize());
   ASSERT_EQ("Test", font_mapper.GetFaceName(0));
 }
+
+TEST(FXFontTest, FolderFontCatalog) {
+  std::string test_data_dir;
+  ASSERT_TRUE(PathService::GetTestDataDir(&test_data_dir));
+  DCHECK(!test_data_dir.empty());
+  const ByteString font_path(
+      (test_data_dir + PATH_SEPARATOR + "font_tests").c_str());
+
+  DataVector<uint8_t> catalog;
+  {
+    CFX_FontMapper font_mapper(nullptr);
+    {
+      CFX_FolderFontInfo folder_font_info;
+      folder_font_info.AddPath(font_path);
+      font_mapper.SetSystemFontInfo(
+          CFX_GEModule::Get()->GetPlatform()->CreateDefaultSystemFontInfo());
+      folder_font_info.EnumFontList(&font_mapper);
+      catalog = folder_font_info.SerializeCatalog();
+    }
+    ASSERT_EQ(1u, font_mapper.GetFaceSize());
+    EXPECT_EQ("Test", font_mapper.GetFaceName(0));
+  }
+
+  // Rename the face in the catalog, to tell whether it gets used.
+  static constexpr uint8_t kFaceName[] = {4, 0, 0, 0, 'T', 'e', 's', 't'};
+  auto it = std::search(catalog.begin(), catalog.end(), std::begin(kFaceName),
+                        std::end(kFaceName));
+  ASSERT_NE(catalog.end(), it);
+  *(it + 4) = 'B';
+
+  {
+    CFX_FontMapper font_mapper(nullptr);
+    {
+      CFX_FolderFontInfo folder_font_info;
+      ASSERT_TRUE(folder_font_info.LoadCatalog(catalog));
+      folder_font_info.AddPath(font_path);
+      font_mapper.SetSystemFontInfo(
+          CFX_GEModule::Get()->GetPlatform()->CreateDefaultSystemFontInfo());
+      folder_font_info.EnumFontList(&font_mapper);
+      EXPECT_EQ(catalog, folder_font_info.SerializeCatalog());
+    }
+    ASSERT_EQ(1u, font_mapper.GetFaceSize());
+    EXPECT_EQ("Best", font_mapper.GetFaceName(0));
+  }
+
+  // Bad catalogs load nothing.
+  CFX_FolderFontInfo folder_font_info;
+  for (size_t size = 0; size < catalog.size(); ++size) {
+    EXPECT_FALSE(
+        folder_font_info.LoadCatalog(pdfium::span(catalog).first(size)));
+  }
+  DataVector<uint8_t> extra = catalog;
+  extra.push_back(0);
+  EXPECT_FALSE(folder_font_info.LoadCatalog(extra));
+}
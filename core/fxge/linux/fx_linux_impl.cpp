@@ -184,6 +184,7 @@ class CLinuxPlatform : public CFX_GEModule::PlatformIface {
       pInfo->AddPath("/usr/share/X11/fonts/TTF");
       pInfo->AddPath("/usr/local/share/fonts");
     }
+    pInfo->SetCatalogPath(CFX_GEModule::Get()->GetFontCatalogPath());
     return pInfo;
   }
 };
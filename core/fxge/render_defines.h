@@ -21,10 +21,10 @@
 #define FXRC_BLEND_MODE 0x10
 #define FXRC_SOFT_CLIP 0x20
 #define FXRC_BYTEMASK_OUTPUT 0x40
+#define FXRC_FILLSTROKE_PATH 0x80
 // Assuming these are Skia-only for now. If this assumption changes, update both
 // the #if logic here, as well as the callsites that check these capabilities.
 #if defined(PDF_USE_SKIA)
-#define FXRC_FILLSTROKE_PATH 0x80
 #define FXRC_SHADING 0x100
 #define FXRC_PREMULTIPLIED_ALPHA 0x200
 #endif
@@ -22,9 +22,10 @@ void ResetTransform(FT_Face face) {
 }  // namespace
 
 ScopedFontTransform::ScopedFontTransform(RetainPtr<CFX_Face> face,
-                                         FT_Matrix* matrix)
+                                         FT_Matrix* matrix,
+                                         FT_Vector* delta)
     : face_(std::move(face)) {
-  FT_Set_Transform(face_->GetRec(), matrix, nullptr);
+  FT_Set_Transform(face_->GetRec(), matrix, delta);
 }
 
 ScopedFontTransform::~ScopedFontTransform() {
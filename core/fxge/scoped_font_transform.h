@@ -18,7 +18,10 @@ class ScopedFontTransform {
  public:
   FX_STACK_ALLOCATED();
 
-  ScopedFontTransform(RetainPtr<CFX_Face> face, FT_Matrix* matrix);
+  // `delta` may be null.
+  ScopedFontTransform(RetainPtr<CFX_Face> face,
+                      FT_Matrix* matrix,
+                      FT_Vector* delta);
   ~ScopedFontTransform();
 
  private:
@@ -31,6 +31,7 @@
 #include "core/fxge/cfx_fontcache.h"
 #include "core/fxge/cfx_gemodule.h"
 #include "core/fxge/cfx_glyphcache.h"
+#include "core/fxge/cfx_glyphoutline.h"
 #include "core/fxge/cfx_path.h"
 #include "core/fxge/cfx_renderdevice.h"
 #include "core/fxge/dib/cfx_dibbase.h"
@@ -742,16 +743,14 @@ void CFX_PSRenderer::FindPSFontGlyph(CFX_GlyphCache* pGlyphCache,
         CFX_Matrix(charpos.adjust_matrix_[0], charpos.adjust_matrix_[1],
                    charpos.adjust_matrix_[2], charpos.adjust_matrix_[3], 0, 0);
   }
-  const CFX_Path* pPath = pGlyphCache->LoadGlyphPath(
+  const CFX_GlyphOutline* outline = pGlyphCache->LoadGlyphOutline(
       pFont, charpos.glyph_index_, charpos.font_char_width_);
-  if (!pPath) {
+  if (!outline) {
     return;
   }
 
-  CFX_Path TransformedPath(*pPath);
-  if (charpos.glyph_adjust_) {
-    TransformedPath.Transform(matrix);
-  }
+  CFX_Path TransformedPath;
+  outline->AppendToPath(TransformedPath, matrix);
 
   fxcrt::ostringstream buf;
   buf << "/X" << *ps_fontnum << " Ff/CharProcs get begin/" << *ps_glyphindex
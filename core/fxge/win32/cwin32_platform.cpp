@@ -487,6 +487,7 @@ CWin32Platform::CreateDefaultSystemFontInfo() {
         font_info->AddPath(*user_paths);
       }
     });
+    font_info->SetCatalogPath(CFX_GEModule::Get()->GetFontCatalogPath());
     return font_info;
   }
 
@@ -505,6 +506,7 @@ CWin32Platform::CreateDefaultSystemFontInfo() {
     fonts_path += "\\Fonts";
     fallback_info->AddPath(fonts_path);
   }
+  fallback_info->SetCatalogPath(CFX_GEModule::Get()->GetFontCatalogPath());
   return fallback_info;
 }
 
@@ -261,6 +261,23 @@ CPDFSDK_InteractiveForm* FormHandleToInteractiveForm(FPDF_FORMHANDLE hHandle) {
   return pFormFillEnv ? pFormFillEnv->GetInteractiveForm() : nullptr;
 }
 
+RetainPtr<CPDF_Page> LoadCPDFPage(CPDF_Document* doc,
+                                  int page_index,
+                                  bool text_only) {
+  RetainPtr<CPDF_Dictionary> dict = doc->GetMutablePageDictionary(page_index);
+  if (!dict) {
+    return nullptr;
+  }
+
+  auto page = pdfium::MakeRetain<CPDF_Page>(doc, std::move(dict));
+  page->AddPageImageCache();
+  if (text_only) {
+    page->SetTextOnly();
+  }
+  page->ParseContent();
+  return page;
+}
+
 ByteString ByteStringFromFPDFWideString(FPDF_WIDESTRING wide_string) {
   // SAFETY: caller ensures `wide_string` is NUL-terminated and enforced
   // by UNSAFE_BUFFER_USAGE in header file.
@@ -40,6 +40,7 @@ class CPDF_Stream;
 class CPDF_StructElement;
 class CPDF_StructTree;
 class CPDF_TextPage;
+class CPDF_TextIndex;
 class CPDF_TextPageFind;
 class CPDFSDK_FormFillEnvironment;
 class CPDFSDK_InteractiveForm;
@@ -236,6 +237,13 @@ inline CPDF_TextPageFind* CPDFTextPageFindFromFPDFSchHandle(
   return reinterpret_cast<CPDF_TextPageFind*>(handle);
 }
 
+inline FPDF_TEXTINDEX FPDFTextIndexFromCPDFTextIndex(CPDF_TextIndex* index) {
+  return reinterpret_cast<FPDF_TEXTINDEX>(index);
+}
+inline CPDF_TextIndex* CPDFTextIndexFromFPDFTextIndex(FPDF_TEXTINDEX index) {
+  return reinterpret_cast<CPDF_TextIndex*>(index);
+}
+
 inline FPDF_FORMHANDLE FPDFFormHandleFromCPDFSDKFormFillEnvironment(
     CPDFSDK_FormFillEnvironment* handle) {
   return reinterpret_cast<FPDF_FORMHANDLE>(handle);
@@ -274,6 +282,12 @@ void ValidateBitmapPremultiplyState(CFX_DIBitmap* bitmap);
 
 CPDFSDK_InteractiveForm* FormHandleToInteractiveForm(FPDF_FORMHANDLE hHandle);
 
+// Loads the page at `page_index` of `doc` and parses its content, or only its
+// text objects if `text_only` is set. Returns nullptr if there is no such page.
+RetainPtr<CPDF_Page> LoadCPDFPage(CPDF_Document* doc,
+                                  int page_index,
+                                  bool text_only);
+
 // PRECONDITIONS: `wide_string` must be terminated by a NUL FPDF_WCHAR.
 UNSAFE_BUFFER_USAGE ByteString
 ByteStringFromFPDFWideString(FPDF_WIDESTRING wide_string);
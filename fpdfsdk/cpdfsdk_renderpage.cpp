@@ -39,6 +39,7 @@ void RenderPageImpl(CPDF_PageRenderContext* pContext,
   options.bLimitedImageCache = !!(flags & FPDF_RENDER_LIMITEDIMAGECACHE);
   options.bForceHalftone = !!(flags & FPDF_RENDER_FORCEHALFTONE);
   options.bNoTextSmooth = !!(flags & FPDF_RENDER_NO_SMOOTHTEXT);
+  options.bSubpixelText = !!(flags & FPDF_RENDER_SUBPIXEL_TEXT);
   options.bNoImageSmooth = !!(flags & FPDF_RENDER_NO_SMOOTHIMAGE);
   options.bNoPathSmooth = !!(flags & FPDF_RENDER_NO_SMOOTHPATH);
 
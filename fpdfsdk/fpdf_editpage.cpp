@@ -82,6 +82,12 @@ bool IsPageObject(CPDF_Page* pPage) {
   return pName && pName->GetString() == "Page";
 }
 
+// Pages loaded with FPDF_LoadPageTextOnly() lack their non-text content, so
+// changing their objects and regenerating their content would lose it.
+bool IsEditablePage(CPDF_Page* pPage) {
+  return IsPageObject(pPage) && !pPage->IsTextOnly();
+}
+
 void CalcBoundingBox(CPDF_PageObject* pPageObj) {
   switch (pPageObj->GetType()) {
     case CPDF_PageObject::Type::kText: {
@@ -267,7 +273,7 @@ FPDFPage_InsertObject(FPDF_PAGE page, FPDF_PAGEOBJECT page_object) {
 
   std::unique_ptr<CPDF_PageObject> pPageObjHolder(pPageObj);
   CPDF_Page* pPage = CPDFPageFromFPDFPage(page);
-  if (!IsPageObject(pPage)) {
+  if (!IsEditablePage(pPage)) {
     return;
   }
 
@@ -284,7 +290,7 @@ FPDFPage_RemoveObject(FPDF_PAGE page, FPDF_PAGEOBJECT page_object) {
   }
 
   CPDF_Page* pPage = CPDFPageFromFPDFPage(page);
-  if (!IsPageObject(pPage)) {
+  if (!IsEditablePage(pPage)) {
     return false;
   }
 
@@ -699,7 +705,7 @@ FPDFPageObj_SetIsActive(FPDF_PAGEOBJECT page_object, FPDF_BOOL active) {
 
 FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV FPDFPage_GenerateContent(FPDF_PAGE page) {
   CPDF_Page* pPage = CPDFPageFromFPDFPage(page);
-  if (!IsPageObject(pPage)) {
+  if (!IsEditablePage(pPage)) {
     return false;
   }
 
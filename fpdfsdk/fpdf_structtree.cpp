@@ -85,6 +85,17 @@ FPDF_StructTree_GetChildAtIndex(FPDF_STRUCTTREE struct_tree, int index) {
       tree->GetTopElement(static_cast<size_t>(index)));
 }
 
+FPDF_EXPORT FPDF_STRUCTELEMENT FPDF_CALLCONV
+FPDF_StructTree_GetElementForMarkedContentID(FPDF_STRUCTTREE struct_tree,
+                                             int mcid) {
+  CPDF_StructTree* tree = CPDFStructTreeFromFPDFStructTree(struct_tree);
+  if (!tree) {
+    return nullptr;
+  }
+  return FPDFStructElementFromCPDFStructElement(
+      tree->GetElementForMarkedContentId(mcid));
+}
+
 FPDF_EXPORT unsigned long FPDF_CALLCONV
 FPDF_StructElement_GetAltText(FPDF_STRUCTELEMENT struct_element,
                               void* buffer,
@@ -376,6 +376,30 @@ TEST_F(FPDFStructTreeEmbedderTest, GetMarkedContentIdAtIndex) {
   }
 }
 
+TEST_F(FPDFStructTreeEmbedderTest, GetElementForMarkedContentID) {
+  ASSERT_TRUE(OpenDocument("tagged_marked_content.pdf"));
+  ScopedEmbedderTestPage page = LoadScopedPage(0);
+  ASSERT_TRUE(page);
+
+  {
+    ScopedFPDFStructTree struct_tree(FPDF_StructTree_GetForPage(page.get()));
+    ASSERT_TRUE(struct_tree);
+    ASSERT_EQ(4, FPDF_StructTree_CountChildren(struct_tree.get()));
+
+    // The parent tree lists the top elements in order.
+    for (int mcid = 0; mcid < 4; ++mcid) {
+      EXPECT_EQ(FPDF_StructTree_GetChildAtIndex(struct_tree.get(), mcid),
+                FPDF_StructTree_GetElementForMarkedContentID(struct_tree.get(),
+                                                             mcid));
+    }
+    EXPECT_FALSE(
+        FPDF_StructTree_GetElementForMarkedContentID(struct_tree.get(), -1));
+    EXPECT_FALSE(
+        FPDF_StructTree_GetElementForMarkedContentID(struct_tree.get(), 4));
+    EXPECT_FALSE(FPDF_StructTree_GetElementForMarkedContentID(nullptr, 0));
+  }
+}
+
 TEST_F(FPDFStructTreeEmbedderTest, GetChildMarkedContentID) {
   ASSERT_TRUE(OpenDocument("tagged_mcr_multipage.pdf"));
 
@@ -15,8 +15,10 @@
 #include "core/fpdfapi/font/cpdf_font.h"
 #include "core/fpdfapi/page/cpdf_page.h"
 #include "core/fpdfapi/page/cpdf_textobject.h"
+#include "core/fpdfapi/parser/cpdf_document.h"
 #include "core/fpdfdoc/cpdf_viewerpreferences.h"
 #include "core/fpdftext/cpdf_linkextract.h"
+#include "core/fpdftext/cpdf_textindex.h"
 #include "core/fpdftext/cpdf_textpage.h"
 #include "core/fpdftext/cpdf_textpagefind.h"
 #include "core/fxcrt/check_op.h"
@@ -73,7 +75,7 @@ FPDFText_GetUnicode(FPDF_TEXTPAGE text_page, int index) {
     return 0;
   }
 
-  const CPDF_TextPage::CharInfo& charinfo = textpage->GetCharInfo(index);
+  const CPDF_TextPage::CharView charinfo = textpage->GetCharInfo(index);
   return charinfo.unicode();
 }
 
@@ -84,8 +86,7 @@ FPDFText_GetTextObject(FPDF_TEXTPAGE text_page, int index) {
     return nullptr;
   }
 
-  return FPDFPageObjectFromCPDFPageObject(
-      textpage->GetCharInfo(index).text_object());
+  return FPDFPageObjectFromCPDFPageObject(textpage->GetCharTextObject(index));
 }
 
 FPDF_EXPORT int FPDF_CALLCONV FPDFText_IsGenerated(FPDF_TEXTPAGE text_page,
@@ -95,7 +96,7 @@ FPDF_EXPORT int FPDF_CALLCONV FPDFText_IsGenerated(FPDF_TEXTPAGE text_page,
     return -1;
   }
 
-  const CPDF_TextPage::CharInfo& charinfo = textpage->GetCharInfo(index);
+  const CPDF_TextPage::CharView charinfo = textpage->GetCharInfo(index);
   return charinfo.char_type() == CPDF_TextPage::CharType::kGenerated ? 1 : 0;
 }
 
@@ -106,7 +107,7 @@ FPDF_EXPORT int FPDF_CALLCONV FPDFText_IsHyphen(FPDF_TEXTPAGE text_page,
     return -1;
   }
 
-  const CPDF_TextPage::CharInfo& charinfo = textpage->GetCharInfo(index);
+  const CPDF_TextPage::CharView charinfo = textpage->GetCharInfo(index);
   return charinfo.char_type() == CPDF_TextPage::CharType::kHyphen;
 }
 
@@ -117,7 +118,7 @@ FPDFText_HasUnicodeMapError(FPDF_TEXTPAGE text_page, int index) {
     return -1;
   }
 
-  const CPDF_TextPage::CharInfo& charinfo = textpage->GetCharInfo(index);
+  const CPDF_TextPage::CharView charinfo = textpage->GetCharInfo(index);
   return charinfo.char_type() == CPDF_TextPage::CharType::kNotUnicode;
 }
 
@@ -142,7 +143,7 @@ FPDFText_GetFontInfo(FPDF_TEXTPAGE text_page,
     return 0;
   }
 
-  const CPDF_TextPage::CharInfo& charinfo = textpage->GetCharInfo(index);
+  const CPDF_TextPage::CharView charinfo = textpage->GetCharInfo(index);
   if (!charinfo.text_object()) {
     return 0;
   }
@@ -167,7 +168,7 @@ FPDF_EXPORT int FPDF_CALLCONV FPDFText_GetFontWeight(FPDF_TEXTPAGE text_page,
     return -1;
   }
 
-  const CPDF_TextPage::CharInfo& charinfo = textpage->GetCharInfo(index);
+  const CPDF_TextPage::CharView charinfo = textpage->GetCharInfo(index);
   if (!charinfo.text_object()) {
     return -1;
   }
@@ -187,7 +188,7 @@ FPDFText_GetFillColor(FPDF_TEXTPAGE text_page,
     return false;
   }
 
-  const CPDF_TextPage::CharInfo& charinfo = textpage->GetCharInfo(index);
+  const CPDF_TextPage::CharView charinfo = textpage->GetCharInfo(index);
   if (!charinfo.text_object()) {
     return false;
   }
@@ -214,7 +215,7 @@ FPDFText_GetStrokeColor(FPDF_TEXTPAGE text_page,
     return false;
   }
 
-  const CPDF_TextPage::CharInfo& charinfo = textpage->GetCharInfo(index);
+  const CPDF_TextPage::CharView charinfo = textpage->GetCharInfo(index);
   if (!charinfo.text_object()) {
     return false;
   }
@@ -236,7 +237,7 @@ FPDF_EXPORT float FPDF_CALLCONV FPDFText_GetCharAngle(FPDF_TEXTPAGE text_page,
     return -1.0f;
   }
 
-  const CPDF_TextPage::CharInfo& charinfo = textpage->GetCharInfo(index);
+  const CPDF_TextPage::CharView charinfo = textpage->GetCharInfo(index);
   // On the left is our current Matrix and on the right a generic rotation
   // matrix for our coordinate space.
   // | a  b  0 |    | cos(t)  -sin(t)  0 |
@@ -266,7 +267,7 @@ FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV FPDFText_GetCharBox(FPDF_TEXTPAGE text_page,
     return false;
   }
 
-  const CPDF_TextPage::CharInfo& charinfo = textpage->GetCharInfo(index);
+  const CPDF_TextPage::CharView charinfo = textpage->GetCharInfo(index);
   *left = charinfo.char_box().left;
   *right = charinfo.char_box().right;
   *bottom = charinfo.char_box().bottom;
@@ -301,7 +302,7 @@ FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV FPDFText_GetMatrix(FPDF_TEXTPAGE text_page,
     return false;
   }
 
-  const CPDF_TextPage::CharInfo& charinfo = textpage->GetCharInfo(index);
+  const CPDF_TextPage::CharView charinfo = textpage->GetCharInfo(index);
   *matrix = FSMatrixFromCFXMatrix(charinfo.matrix());
   return true;
 }
@@ -316,12 +317,66 @@ FPDFText_GetCharOrigin(FPDF_TEXTPAGE text_page,
     return false;
   }
 
-  const CPDF_TextPage::CharInfo& charinfo = textpage->GetCharInfo(index);
+  const CPDF_TextPage::CharView charinfo = textpage->GetCharInfo(index);
   *x = charinfo.origin().x;
   *y = charinfo.origin().y;
   return true;
 }
 
+FPDF_EXPORT int FPDF_CALLCONV FPDFText_GetCharData(FPDF_TEXTPAGE text_page,
+                                                   int start_index,
+                                                   int count,
+                                                   unsigned int* unicodes,
+                                                   FS_POINTF* origins,
+                                                   FS_RECTF* boxes,
+                                                   float* font_sizes,
+                                                   int* object_ids,
+                                                   int* font_ids) {
+  CPDF_TextPage* textpage = CPDFTextPageFromFPDFTextPage(text_page);
+  if (!textpage || start_index < 0 || count < 0) {
+    return -1;
+  }
+
+  const size_t start = std::min<size_t>(start_index, textpage->size());
+  const size_t size = std::min<size_t>(count, textpage->size() - start);
+
+  // SAFETY: required from caller.
+  auto unicodes_span =
+      UNSAFE_BUFFERS(pdfium::span(unicodes, unicodes ? size : 0));
+  auto origins_span = UNSAFE_BUFFERS(pdfium::span(origins, origins ? size : 0));
+  auto boxes_span = UNSAFE_BUFFERS(pdfium::span(boxes, boxes ? size : 0));
+  auto font_sizes_span =
+      UNSAFE_BUFFERS(pdfium::span(font_sizes, font_sizes ? size : 0));
+  auto object_ids_span =
+      UNSAFE_BUFFERS(pdfium::span(object_ids, object_ids ? size : 0));
+  auto font_ids_span =
+      UNSAFE_BUFFERS(pdfium::span(font_ids, font_ids ? size : 0));
+
+  for (size_t i = 0; i < size; ++i) {
+    const size_t index = start + i;
+    const CPDF_TextPage::CharView charinfo = textpage->GetCharInfo(index);
+    if (!unicodes_span.empty()) {
+      unicodes_span[i] = charinfo.unicode();
+    }
+    if (!origins_span.empty()) {
+      origins_span[i] = {charinfo.origin().x, charinfo.origin().y};
+    }
+    if (!boxes_span.empty()) {
+      boxes_span[i] = FSRectFFromCFXFloatRect(charinfo.char_box());
+    }
+    if (!font_sizes_span.empty()) {
+      font_sizes_span[i] = textpage->GetCharFontSize(index);
+    }
+    if (!object_ids_span.empty()) {
+      object_ids_span[i] = textpage->GetCharTextObjectId(index);
+    }
+    if (!font_ids_span.empty()) {
+      font_ids_span[i] = textpage->GetCharFontId(index);
+    }
+  }
+  return pdfium::checked_cast<int>(size);
+}
+
 FPDF_EXPORT int FPDF_CALLCONV
 FPDFText_GetCharIndexAtPos(FPDF_TEXTPAGE text_page,
                            double x,
@@ -504,6 +559,108 @@ FPDF_EXPORT void FPDF_CALLCONV FPDFText_FindClose(FPDF_SCHHANDLE handle) {
       CPDFTextPageFindFromFPDFSchHandle(handle));
 }
 
+FPDF_EXPORT FPDF_TEXTINDEX FPDF_CALLCONV
+FPDFText_BuildIndex(FPDF_DOCUMENT document) {
+  CPDF_Document* doc = CPDFDocumentFromFPDFDocument(document);
+  if (!doc) {
+    return nullptr;
+  }
+
+  const bool rtl = CPDF_ViewerPreferences(doc).IsDirectionR2L();
+  auto index = std::make_unique<CPDF_TextIndex>();
+  for (int i = 0; i < doc->GetPageCount(); ++i) {
+    RetainPtr<CPDF_Page> page = LoadCPDFPage(doc, i, /*text_only=*/true);
+    if (page) {
+      index->AddPage(i, CPDF_TextPage(page.Get(), rtl));
+    }
+  }
+
+  // Caller takes ownership.
+  return FPDFTextIndexFromCPDFTextIndex(index.release());
+}
+
+FPDF_EXPORT unsigned long FPDF_CALLCONV
+FPDFText_SaveIndex(FPDF_TEXTINDEX index, void* buffer, unsigned long buflen) {
+  CPDF_TextIndex* text_index = CPDFTextIndexFromFPDFTextIndex(index);
+  if (!text_index) {
+    return 0;
+  }
+
+  const DataVector<uint8_t> data = text_index->Serialize();
+  if (!pdfium::IsValueInRangeForNumericType<unsigned long>(data.size())) {
+    return 0;
+  }
+  // SAFETY: required from caller.
+  auto buffer_span = UNSAFE_BUFFERS(SpanFromFPDFApiArgs(buffer, buflen));
+  if (buffer_span.size() >= data.size()) {
+    fxcrt::spancpy(pdfium::as_writable_bytes(buffer_span), pdfium::span(data));
+  }
+  return static_cast<unsigned long>(data.size());
+}
+
+FPDF_EXPORT FPDF_TEXTINDEX FPDF_CALLCONV
+FPDFText_LoadIndex(const void* data, unsigned long size) {
+  if (!data) {
+    return nullptr;
+  }
+
+  // SAFETY: required from caller.
+  auto data_span = UNSAFE_BUFFERS(pdfium::span(
+      static_cast<const uint8_t*>(data), static_cast<size_t>(size)));
+  // Caller takes ownership.
+  return FPDFTextIndexFromCPDFTextIndex(
+      CPDF_TextIndex::Deserialize(data_span).release());
+}
+
+FPDF_EXPORT int FPDF_CALLCONV FPDFText_SearchIndex(FPDF_TEXTINDEX index,
+                                                   FPDF_WIDESTRING query,
+                                                   int* page_indices,
+                                                   int* char_indices,
+                                                   int* char_counts,
+                                                   FS_RECTF* rects,
+                                                   int max_hits) {
+  CPDF_TextIndex* text_index = CPDFTextIndexFromFPDFTextIndex(index);
+  if (!text_index || max_hits < 0) {
+    return -1;
+  }
+
+  // SAFETY: required from caller.
+  const std::vector<CPDF_TextIndex::Hit> hits = text_index->Find(
+      UNSAFE_BUFFERS(WideStringFromFPDFWideString(query)).AsStringView());
+  const size_t size = std::min<size_t>(hits.size(), max_hits);
+
+  // SAFETY: required from caller.
+  auto page_indices_span =
+      UNSAFE_BUFFERS(pdfium::span(page_indices, page_indices ? size : 0));
+  auto char_indices_span =
+      UNSAFE_BUFFERS(pdfium::span(char_indices, char_indices ? size : 0));
+  auto char_counts_span =
+      UNSAFE_BUFFERS(pdfium::span(char_counts, char_counts ? size : 0));
+  auto rects_span = UNSAFE_BUFFERS(pdfium::span(rects, rects ? size : 0));
+
+  for (size_t i = 0; i < size; ++i) {
+    const CPDF_TextIndex::Hit& hit = hits[i];
+    if (!page_indices_span.empty()) {
+      page_indices_span[i] = hit.page_index;
+    }
+    if (!char_indices_span.empty()) {
+      char_indices_span[i] = hit.char_index;
+    }
+    if (!char_counts_span.empty()) {
+      char_counts_span[i] = hit.char_count;
+    }
+    if (!rects_span.empty()) {
+      rects_span[i] = FSRectFFromCFXFloatRect(hit.rect);
+    }
+  }
+  return pdfium::checked_cast<int>(hits.size());
+}
+
+FPDF_EXPORT void FPDF_CALLCONV FPDFText_CloseIndex(FPDF_TEXTINDEX index) {
+  // Take ownership back from caller and destroy.
+  std::unique_ptr<CPDF_TextIndex>(CPDFTextIndexFromFPDFTextIndex(index));
+}
+
 // web link
 FPDF_EXPORT FPDF_PAGELINK FPDF_CALLCONV
 FPDFLink_LoadWebLinks(FPDF_TEXTPAGE text_page) {
@@ -512,8 +669,8 @@ FPDFLink_LoadWebLinks(FPDF_TEXTPAGE text_page) {
     return nullptr;
   }
 
+  // Links are found on first use of `pagelink`.
   auto pagelink = std::make_unique<CPDF_LinkExtract>(textpage);
-  pagelink->ExtractLinks();
 
   // Caller takes ownership.
   return FPDFPageLinkFromCPDFLinkExtract(pagelink.release());
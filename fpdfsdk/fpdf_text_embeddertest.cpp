@@ -13,6 +13,7 @@
 #include "core/fxge/fx_font.h"
 #include "public/cpp/fpdf_scopers.h"
 #include "public/fpdf_doc.h"
+#include "public/fpdf_edit.h"
 #include "public/fpdf_text.h"
 #include "public/fpdf_transformpage.h"
 #include "public/fpdfview.h"
@@ -22,6 +23,7 @@
 #include "testing/gtest/include/gtest/gtest.h"
 #include "testing/utils/compare_coordinates.h"
 
+using ::testing::Each;
 using ::testing::ElementsAreArray;
 
 namespace {
@@ -2230,3 +2232,293 @@ TEST_F(FPDFTextEmbedderTest, TextObjectSetIsActive) {
                 ElementsAreArray(kHelloGoodbyeText));
   }
 }
+
+TEST_F(FPDFTextEmbedderTest, LoadPageTextOnly) {
+  ASSERT_TRUE(OpenDocument("marked_content_id.pdf"));
+  ScopedEmbedderTestPage page = LoadScopedPage(0);
+  ASSERT_TRUE(page);
+  ASSERT_EQ(2, FPDFPage_CountObjects(page.get()));
+
+  ScopedFPDFPage text_only_page(FPDF_LoadPageTextOnly(document(), 0));
+  ASSERT_TRUE(text_only_page);
+
+  // The image is not loaded.
+  ASSERT_EQ(1, FPDFPage_CountObjects(text_only_page.get()));
+  EXPECT_EQ(FPDF_PAGEOBJ_TEXT,
+            FPDFPageObj_GetType(FPDFPage_GetObject(text_only_page.get(), 0)));
+
+  ScopedFPDFTextPage textpage(FPDFText_LoadPage(page.get()));
+  ASSERT_TRUE(textpage);
+  ScopedFPDFTextPage text_only_textpage(
+      FPDFText_LoadPage(text_only_page.get()));
+  ASSERT_TRUE(text_only_textpage);
+
+  const int num_chars = FPDFText_CountChars(textpage.get());
+  ASSERT_EQ(num_chars, FPDFText_CountChars(text_only_textpage.get()));
+  for (int i = 0; i < num_chars; ++i) {
+    EXPECT_EQ(FPDFText_GetUnicode(textpage.get(), i),
+              FPDFText_GetUnicode(text_only_textpage.get(), i));
+  }
+
+  EXPECT_FALSE(FPDF_LoadPageTextOnly(document(), -1));
+  EXPECT_FALSE(FPDF_LoadPageTextOnly(document(), 1));
+  EXPECT_FALSE(FPDF_LoadPageTextOnly(nullptr, 0));
+}
+
+TEST_F(FPDFTextEmbedderTest, LoadPageTextOnlyWithForm) {
+  ASSERT_TRUE(OpenDocument("form_object_with_text.pdf"));
+  ScopedEmbedderTestPage page = LoadScopedPage(0);
+  ASSERT_TRUE(page);
+  ScopedFPDFPage text_only_page(FPDF_LoadPageTextOnly(document(), 0));
+  ASSERT_TRUE(text_only_page);
+
+  // Text inside form XObjects is kept.
+  ASSERT_EQ(1, FPDFPage_CountObjects(text_only_page.get()));
+  FPDF_PAGEOBJECT form = FPDFPage_GetObject(text_only_page.get(), 0);
+  ASSERT_EQ(FPDF_PAGEOBJ_FORM, FPDFPageObj_GetType(form));
+  EXPECT_EQ(2, FPDFFormObj_CountObjects(form));
+
+  ScopedFPDFTextPage textpage(FPDFText_LoadPage(page.get()));
+  ASSERT_TRUE(textpage);
+  ScopedFPDFTextPage text_only_textpage(
+      FPDFText_LoadPage(text_only_page.get()));
+  ASSERT_TRUE(text_only_textpage);
+
+  const int num_chars = FPDFText_CountChars(textpage.get());
+  ASSERT_GT(num_chars, 0);
+  ASSERT_EQ(num_chars, FPDFText_CountChars(text_only_textpage.get()));
+  for (int i = 0; i < num_chars; ++i) {
+    EXPECT_EQ(FPDFText_GetUnicode(textpage.get(), i),
+              FPDFText_GetUnicode(text_only_textpage.get(), i));
+    double left;
+    double right;
+    double bottom;
+    double top;
+    ASSERT_TRUE(
+        FPDFText_GetCharBox(textpage.get(), i, &left, &right, &bottom, &top));
+    double text_only_left;
+    double text_only_right;
+    double text_only_bottom;
+    double text_only_top;
+    ASSERT_TRUE(FPDFText_GetCharBox(text_only_textpage.get(), i,
+                                    &text_only_left, &text_only_right,
+                                    &text_only_bottom, &text_only_top));
+    EXPECT_DOUBLE_EQ(left, text_only_left);
+    EXPECT_DOUBLE_EQ(right, text_only_right);
+    EXPECT_DOUBLE_EQ(bottom, text_only_bottom);
+    EXPECT_DOUBLE_EQ(top, text_only_top);
+  }
+}
+
+TEST_F(FPDFTextEmbedderTest, LoadPageTextOnlyColors) {
+  ASSERT_TRUE(OpenDocument("text_color_named_colorspace.pdf"));
+  ScopedFPDFPage text_only_page(FPDF_LoadPageTextOnly(document(), 0));
+  ASSERT_TRUE(text_only_page);
+  ScopedFPDFTextPage textpage(FPDFText_LoadPage(text_only_page.get()));
+  ASSERT_TRUE(textpage);
+  ASSERT_EQ(1, FPDFText_CountChars(textpage.get()));
+
+  // The colors are set in a named colorspace.
+  unsigned int r;
+  unsigned int g;
+  unsigned int b;
+  unsigned int a;
+  ASSERT_TRUE(FPDFText_GetFillColor(textpage.get(), 0, &r, &g, &b, &a));
+  EXPECT_EQ(0xffu, r);
+  EXPECT_EQ(0u, g);
+  EXPECT_EQ(0u, b);
+  EXPECT_EQ(0xffu, a);
+  ASSERT_TRUE(FPDFText_GetStrokeColor(textpage.get(), 0, &r, &g, &b, &a));
+  EXPECT_EQ(0u, r);
+  EXPECT_EQ(0xffu, g);
+  EXPECT_EQ(0u, b);
+  EXPECT_EQ(0xffu, a);
+}
+
+TEST_F(FPDFTextEmbedderTest, LoadPageTextOnlyIsReadOnly) {
+  ASSERT_TRUE(OpenDocument("marked_content_id.pdf"));
+  ScopedFPDFPage text_only_page(FPDF_LoadPageTextOnly(document(), 0));
+  ASSERT_TRUE(text_only_page);
+  ASSERT_EQ(1, FPDFPage_CountObjects(text_only_page.get()));
+
+  // Regenerating the content would drop the image that was not loaded.
+  EXPECT_FALSE(FPDFPage_GenerateContent(text_only_page.get()));
+
+  FPDF_PAGEOBJECT text = FPDFPage_GetObject(text_only_page.get(), 0);
+  EXPECT_FALSE(FPDFPage_RemoveObject(text_only_page.get(), text));
+  FPDFPage_InsertObject(text_only_page.get(),
+                        FPDFPageObj_CreateNewRect(10, 10, 20, 20));
+  EXPECT_EQ(1, FPDFPage_CountObjects(text_only_page.get()));
+  EXPECT_EQ(text, FPDFPage_GetObject(text_only_page.get(), 0));
+
+  // The same page loaded normally can still be edited.
+  ScopedEmbedderTestPage page = LoadScopedPage(0);
+  ASSERT_TRUE(page);
+  EXPECT_TRUE(FPDFPage_GenerateContent(page.get()));
+}
+
+TEST_F(FPDFTextEmbedderTest, GetCharData) {
+  ASSERT_TRUE(OpenDocument("hello_world.pdf"));
+  ScopedEmbedderTestPage page = LoadScopedPage(0);
+  ASSERT_TRUE(page);
+
+  ScopedFPDFTextPage textpage(FPDFText_LoadPage(page.get()));
+  ASSERT_TRUE(textpage);
+
+  const int num_chars = FPDFText_CountChars(textpage.get());
+  ASSERT_GT(num_chars, 0);
+
+  std::vector<unsigned int> unicodes(num_chars);
+  std::vector<FS_POINTF> origins(num_chars);
+  std::vector<FS_RECTF> boxes(num_chars);
+  std::vector<float> font_sizes(num_chars);
+  std::vector<int> object_ids(num_chars);
+  std::vector<int> font_ids(num_chars);
+  ASSERT_EQ(num_chars,
+            FPDFText_GetCharData(textpage.get(), 0, num_chars, unicodes.data(),
+                                 origins.data(), boxes.data(),
+                                 font_sizes.data(), object_ids.data(),
+                                 font_ids.data()));
+
+  std::vector<FPDF_PAGEOBJECT> objects;
+  for (int i = 0; i < num_chars; ++i) {
+    EXPECT_EQ(FPDFText_GetUnicode(textpage.get(), i), unicodes[i]);
+
+    double x;
+    double y;
+    ASSERT_TRUE(FPDFText_GetCharOrigin(textpage.get(), i, &x, &y));
+    EXPECT_FLOAT_EQ(x, origins[i].x);
+    EXPECT_FLOAT_EQ(y, origins[i].y);
+
+    double left;
+    double right;
+    double bottom;
+    double top;
+    ASSERT_TRUE(
+        FPDFText_GetCharBox(textpage.get(), i, &left, &right, &bottom, &top));
+    EXPECT_FLOAT_EQ(left, boxes[i].left);
+    EXPECT_FLOAT_EQ(right, boxes[i].right);
+    EXPECT_FLOAT_EQ(bottom, boxes[i].bottom);
+    EXPECT_FLOAT_EQ(top, boxes[i].top);
+
+    EXPECT_FLOAT_EQ(FPDFText_GetFontSize(textpage.get(), i), font_sizes[i]);
+
+    // Ids number the text objects in order of first appearance.
+    FPDF_PAGEOBJECT text_object = FPDFText_GetTextObject(textpage.get(), i);
+    if (!text_object) {
+      EXPECT_EQ(-1, object_ids[i]);
+      EXPECT_EQ(-1, font_ids[i]);
+      continue;
+    }
+    auto it = std::ranges::find(objects, text_object);
+    EXPECT_EQ(it - objects.begin(), object_ids[i]);
+    if (it == objects.end()) {
+      objects.push_back(text_object);
+    }
+  }
+
+  // hello_world.pdf has one text object per font.
+  EXPECT_EQ(2u, objects.size());
+  EXPECT_EQ(object_ids, font_ids);
+
+  // Ranges are clamped to the end of the page, and ids do not depend on the
+  // range.
+  int object_id = -2;
+  EXPECT_EQ(1, FPDFText_GetCharData(textpage.get(), num_chars - 1, 100,
+                                    nullptr, nullptr, nullptr, nullptr,
+                                    &object_id, nullptr));
+  EXPECT_EQ(object_ids.back(), object_id);
+  EXPECT_EQ(0, FPDFText_GetCharData(textpage.get(), num_chars, 1, nullptr,
+                                    nullptr, nullptr, nullptr, nullptr,
+                                    nullptr));
+  EXPECT_EQ(-1, FPDFText_GetCharData(textpage.get(), -1, 1, nullptr, nullptr,
+                                     nullptr, nullptr, nullptr, nullptr));
+  EXPECT_EQ(-1, FPDFText_GetCharData(textpage.get(), 0, -1, nullptr, nullptr,
+                                     nullptr, nullptr, nullptr, nullptr));
+  EXPECT_EQ(-1, FPDFText_GetCharData(nullptr, 0, 1, nullptr, nullptr, nullptr,
+                                     nullptr, nullptr, nullptr));
+}
+
+TEST_F(FPDFTextEmbedderTest, BuildIndex) {
+  ASSERT_TRUE(OpenDocument("hello_world.pdf"));
+  ScopedFPDFTextIndex index(FPDFText_BuildIndex(document()));
+  ASSERT_TRUE(index);
+
+  ScopedFPDFWideString world = GetFPDFWideString(L"WORLD");
+  std::array<int, 4> page_indices;
+  std::array<int, 4> char_indices;
+  std::array<int, 4> char_counts;
+  std::array<FS_RECTF, 4> rects;
+  ASSERT_EQ(2, FPDFText_SearchIndex(index.get(), world.get(),
+                                    page_indices.data(), char_indices.data(),
+                                    char_counts.data(), rects.data(), 4));
+  EXPECT_EQ(0, page_indices[0]);
+  EXPECT_EQ(7, char_indices[0]);
+  EXPECT_EQ(5, char_counts[0]);
+  EXPECT_EQ(0, page_indices[1]);
+  EXPECT_EQ(24, char_indices[1]);
+  EXPECT_EQ(5, char_counts[1]);
+
+  {
+    // The rectangles match those of the text page.
+    ScopedEmbedderTestPage page = LoadScopedPage(0);
+    ASSERT_TRUE(page);
+    ScopedFPDFTextPage textpage(FPDFText_LoadPage(page.get()));
+    ASSERT_TRUE(textpage);
+    ASSERT_EQ(1, FPDFText_CountRects(textpage.get(), 7, 5));
+    double left;
+    double top;
+    double right;
+    double bottom;
+    ASSERT_TRUE(
+        FPDFText_GetRect(textpage.get(), 0, &left, &top, &right, &bottom));
+    EXPECT_FLOAT_EQ(left, rects[0].left);
+    EXPECT_FLOAT_EQ(top, rects[0].top);
+    EXPECT_FLOAT_EQ(right, rects[0].right);
+    EXPECT_FLOAT_EQ(bottom, rects[0].bottom);
+  }
+
+  // Phrases continue across lines.
+  ScopedFPDFWideString phrase = GetFPDFWideString(L"goodbye, world");
+  ASSERT_EQ(1, FPDFText_SearchIndex(index.get(), phrase.get(), nullptr,
+                                    char_indices.data(), char_counts.data(),
+                                    nullptr, 1));
+  EXPECT_EQ(15, char_indices[0]);
+  EXPECT_EQ(14, char_counts[0]);
+
+  ScopedFPDFWideString nope = GetFPDFWideString(L"nope");
+  EXPECT_EQ(0, FPDFText_SearchIndex(index.get(), nope.get(), nullptr, nullptr,
+                                    nullptr, nullptr, 0));
+  EXPECT_EQ(-1, FPDFText_SearchIndex(index.get(), world.get(), nullptr,
+                                     nullptr, nullptr, nullptr, -1));
+  EXPECT_EQ(-1, FPDFText_SearchIndex(nullptr, world.get(), nullptr, nullptr,
+                                     nullptr, nullptr, 0));
+}
+
+TEST_F(FPDFTextEmbedderTest, SaveAndLoadIndex) {
+  ASSERT_TRUE(OpenDocument("hello_world.pdf"));
+  ScopedFPDFTextIndex index(FPDFText_BuildIndex(document()));
+  ASSERT_TRUE(index);
+
+  const unsigned long size = FPDFText_SaveIndex(index.get(), nullptr, 0);
+  ASSERT_GT(size, 0u);
+  std::vector<uint8_t> data(size);
+  EXPECT_EQ(size, FPDFText_SaveIndex(index.get(), data.data(), size - 1));
+  EXPECT_THAT(data, Each(0));
+  EXPECT_EQ(size, FPDFText_SaveIndex(index.get(), data.data(), size));
+  EXPECT_EQ(0u, FPDFText_SaveIndex(nullptr, data.data(), size));
+
+  // The loaded index does not need the document.
+  CloseDocument();
+  ScopedFPDFTextIndex loaded(FPDFText_LoadIndex(data.data(), size));
+  ASSERT_TRUE(loaded);
+  ScopedFPDFWideString hello = GetFPDFWideString(L"hello");
+  int char_index;
+  ASSERT_EQ(1, FPDFText_SearchIndex(loaded.get(), hello.get(), nullptr,
+                                    &char_index, nullptr, nullptr, 1));
+  EXPECT_EQ(0, char_index);
+
+  EXPECT_FALSE(FPDFText_LoadIndex(data.data(), size - 1));
+  EXPECT_FALSE(FPDFText_LoadIndex(nullptr, size));
+  EXPECT_FALSE(FPDFText_BuildIndex(nullptr));
+}
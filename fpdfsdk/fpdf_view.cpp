@@ -47,8 +47,11 @@
 #include "core/fxcrt/stl_util.h"
 #include "core/fxcrt/unowned_ptr.h"
 #include "core/fxge/cfx_defaultrenderdevice.h"
+#include "core/fxge/cfx_displaylist.h"
+#include "core/fxge/cfx_fontcache.h"
 #include "core/fxge/cfx_gemodule.h"
 #include "core/fxge/cfx_glyphcache.h"
+#include "core/fxge/cfx_recordingrenderdevice.h"
 #include "core/fxge/cfx_renderdevice.h"
 #include "core/fxge/dib/cfx_dibitmap.h"
 #include "fpdfsdk/cpdfsdk_customaccess.h"
@@ -228,6 +231,29 @@ FPDF_DOCUMENT LoadDocumentImpl(RetainPtr<IFX_SeekableReadStream> pFileAccess,
   return FPDFDocumentFromCPDFDocument(pDocument.release());
 }
 
+FPDF_PAGE LoadPageImpl(FPDF_DOCUMENT document, int page_index, bool text_only) {
+  auto* pDoc = CPDFDocumentFromFPDFDocument(document);
+  if (!pDoc) {
+    return nullptr;
+  }
+
+  if (page_index < 0 || page_index >= FPDF_GetPageCount(document)) {
+    return nullptr;
+  }
+
+#ifdef PDF_ENABLE_XFA
+  // XFA pages are not built from content streams, so `text_only` is moot.
+  auto* pContext = static_cast<CPDFXFA_Context*>(pDoc->GetExtension());
+  if (pContext) {
+    return FPDFPageFromIPDFPage(
+        pContext->GetOrCreateXFAPage(page_index).Leak());
+  }
+#endif  // PDF_ENABLE_XFA
+
+  return FPDFPageFromIPDFPage(
+      LoadCPDFPage(pDoc, page_index, text_only).Leak());
+}
+
 }  // namespace
 
 FPDF_EXPORT void FPDF_CALLCONV FPDF_InitLibrary() {
@@ -242,7 +268,9 @@ FPDF_InitLibraryWithConfig(const FPDF_LIBRARY_CONFIG* config) {
 
   FX_InitializeMemoryAllocators();
   CFX_Timer::InitializeGlobals();
-  CFX_GEModule::Create(config ? config->m_pUserFontPaths : nullptr);
+  CFX_GEModule::Create(
+      config ? config->m_pUserFontPaths : nullptr,
+      config && config->version >= 5 ? config->m_pFontCatalogPath : nullptr);
   pdfium::InitializePageModule();
 
 #if defined(PDF_USE_SKIA)
@@ -284,6 +312,7 @@ FPDF_EXPORT void FPDF_CALLCONV FPDF_DestroyLibrary() {
 #endif
 
   pdfium::DestroyPageModule();
+  CFX_GEModule::Get()->GetFontCache()->ReleaseUnusedEmbeddedFonts();
   CFX_GEModule::Destroy();
   CFX_Timer::DestroyGlobals();
   FX_DestroyMemoryAllocators();
@@ -469,33 +498,12 @@ FPDF_EXPORT int FPDF_CALLCONV FPDF_GetPageCount(FPDF_DOCUMENT document) {
 
 FPDF_EXPORT FPDF_PAGE FPDF_CALLCONV FPDF_LoadPage(FPDF_DOCUMENT document,
                                                   int page_index) {
-  auto* pDoc = CPDFDocumentFromFPDFDocument(document);
-  if (!pDoc) {
-    return nullptr;
-  }
-
-  if (page_index < 0 || page_index >= FPDF_GetPageCount(document)) {
-    return nullptr;
-  }
-
-#ifdef PDF_ENABLE_XFA
-  auto* pContext = static_cast<CPDFXFA_Context*>(pDoc->GetExtension());
-  if (pContext) {
-    return FPDFPageFromIPDFPage(
-        pContext->GetOrCreateXFAPage(page_index).Leak());
-  }
-#endif  // PDF_ENABLE_XFA
-
-  RetainPtr<CPDF_Dictionary> pDict = pDoc->GetMutablePageDictionary(page_index);
-  if (!pDict) {
-    return nullptr;
-  }
-
-  auto pPage = pdfium::MakeRetain<CPDF_Page>(pDoc, std::move(pDict));
-  pPage->AddPageImageCache();
-  pPage->ParseContent();
+  return LoadPageImpl(document, page_index, /*text_only=*/false);
+}
 
-  return FPDFPageFromIPDFPage(pPage.Leak());
+FPDF_EXPORT FPDF_PAGE FPDF_CALLCONV
+FPDF_LoadPageTextOnly(FPDF_DOCUMENT document, int page_index) {
+  return LoadPageImpl(document, page_index, /*text_only=*/true);
 }
 
 FPDF_EXPORT float FPDF_CALLCONV FPDF_GetPageWidthF(FPDF_PAGE page) {
@@ -829,6 +837,135 @@ FPDF_RenderPageBitmapWithMatrix(FPDF_BITMAP bitmap,
                      /*color_scheme=*/nullptr);
 }
 
+namespace {
+
+// Owns a recorded display list, and keeps alive what its operations still
+// refer to, such as the fonts of the page and of its annotations.
+class FPDF_DisplayListContext {
+ public:
+  FPDF_DisplayListContext(
+      RetainPtr<CPDF_Page> page,
+      std::unique_ptr<CPDF_PageRenderContext::AnnotListIface> annots,
+      std::unique_ptr<CFX_DisplayList> display_list,
+      float scale)
+      : page_(std::move(page)),
+        annots_(std::move(annots)),
+        display_list_(std::move(display_list)),
+        scale_(scale) {}
+  ~FPDF_DisplayListContext() = default;
+
+  const CFX_DisplayList* display_list() const { return display_list_.get(); }
+  float scale() const { return scale_; }
+
+ private:
+  // Declared before `display_list_`, so they outlive it.
+  RetainPtr<CPDF_Page> const page_;
+  std::unique_ptr<CPDF_PageRenderContext::AnnotListIface> const annots_;
+  std::unique_ptr<CFX_DisplayList> const display_list_;
+  const float scale_;
+};
+
+FPDF_DisplayListContext* FPDFDisplayListContextFromFPDFDisplayList(
+    FPDF_DISPLAYLIST display_list) {
+  return reinterpret_cast<FPDF_DisplayListContext*>(display_list);
+}
+
+FPDF_DISPLAYLIST FPDFDisplayListFromFPDFDisplayListContext(
+    FPDF_DisplayListContext* context) {
+  return reinterpret_cast<FPDF_DISPLAYLIST>(context);
+}
+
+}  // namespace
+
+FPDF_EXPORT FPDF_DISPLAYLIST FPDF_CALLCONV
+FPDF_RecordPageDisplayList(FPDF_PAGE page, float scale, int flags) {
+  CPDF_Page* pPage = CPDFPageFromFPDFPage(page);
+  if (!pPage || !(scale > 0.0f)) {
+    return nullptr;
+  }
+
+  // Use the same page space as FPDF_RenderPageBitmapWithMatrix(), so replay
+  // matrices mean the same thing as its matrices do.
+  const FX_RECT rect(0, 0, pPage->GetPageWidth(), pPage->GetPageHeight());
+  const CFX_Matrix scale_matrix(scale, 0, 0, scale, 0, 0);
+  const FX_RECT device_rect =
+      scale_matrix.TransformRect(CFX_FloatRect(rect)).GetOuterRect();
+  if (!device_rect.Valid() || device_rect.IsEmpty()) {
+    return nullptr;
+  }
+
+  auto owned_context = std::make_unique<CPDF_PageRenderContext>();
+  CPDF_PageRenderContext* context = owned_context.get();
+  CPDF_Page::RenderContextClearer clearer(pPage);
+  pPage->SetRenderContext(std::move(owned_context));
+
+  auto device = std::make_unique<CFX_RecordingRenderDevice>(
+      device_rect.Width(), device_rect.Height());
+  CFX_RecordingRenderDevice* recording_device = device.get();
+  context->device_ = std::move(device);
+
+  CPDFSDK_RenderPage(context, pPage,
+                     pPage->GetDisplayMatrix(rect, 0) * scale_matrix,
+                     device_rect, flags,
+                     /*color_scheme=*/nullptr);
+
+  auto display_list_context = std::make_unique<FPDF_DisplayListContext>(
+      pdfium::WrapRetain(pPage), std::move(context->annots_),
+      recording_device->TakeDisplayList(), scale);
+  return FPDFDisplayListFromFPDFDisplayListContext(
+      display_list_context.release());
+}
+
+FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV
+FPDF_ReplayDisplayList(FPDF_BITMAP bitmap,
+                       FPDF_DISPLAYLIST display_list,
+                       const FS_MATRIX* matrix,
+                       const FS_RECTF* clipping,
+                       int flags) {
+  FPDF_DisplayListContext* context =
+      FPDFDisplayListContextFromFPDFDisplayList(display_list);
+  if (!context) {
+    return false;
+  }
+
+  RetainPtr<CFX_DIBitmap> pBitmap(CFXDIBitmapFromFPDFBitmap(bitmap));
+  if (!pBitmap) {
+    return false;
+  }
+  ValidateBitmapPremultiplyState(pBitmap);
+
+#if defined(PDF_USE_SKIA)
+  CFX_DIBitmap::ScopedPremultiplier scoped_premultiplier(pBitmap);
+#endif
+  CFX_DefaultRenderDevice device;
+  if (!device.AttachWithRgbByteOrder(std::move(pBitmap),
+                                     !!(flags & FPDF_REVERSE_BYTE_ORDER))) {
+    return false;
+  }
+
+  CFX_RenderDevice::StateRestorer restorer(&device);
+  if (clipping) {
+    device.SetClip_Rect(CFXFloatRectFromFSRectF(*clipping).ToFxRect());
+  }
+
+  // The display list is in recorded device pixels. Map those back to page
+  // space before applying `matrix`.
+  const float inverse_scale = 1.0f / context->scale();
+  CFX_Matrix replay_matrix(inverse_scale, 0, 0, inverse_scale, 0, 0);
+  if (matrix) {
+    replay_matrix *= CFXMatrixFromFSMatrix(*matrix);
+  }
+  context->display_list()->Replay(&device, replay_matrix);
+  return true;
+}
+
+FPDF_EXPORT void FPDF_CALLCONV
+FPDF_CloseDisplayList(FPDF_DISPLAYLIST display_list) {
+  // Take ownership back from caller and destroy.
+  std::unique_ptr<FPDF_DisplayListContext>(
+      FPDFDisplayListContextFromFPDFDisplayList(display_list));
+}
+
 #if defined(PDF_USE_SKIA)
 FPDF_EXPORT void FPDF_CALLCONV FPDF_RenderPageSkia(FPDF_SKIA_CANVAS canvas,
                                                    FPDF_PAGE page,
@@ -881,8 +1018,16 @@ FPDF_EXPORT void FPDF_CALLCONV FPDF_ClosePage(FPDF_PAGE page) {
 }
 
 FPDF_EXPORT void FPDF_CALLCONV FPDF_CloseDocument(FPDF_DOCUMENT document) {
+  if (!document) {
+    return;
+  }
+
   // Take it back across the API and throw it away,
   std::unique_ptr<CPDF_Document>(CPDFDocumentFromFPDFDocument(document));
+
+  // Its fonts no longer use their embedded faces, so the glyphs cached for
+  // them are trimmed back to the budget.
+  CFX_GEModule::Get()->GetFontCache()->TrimEmbeddedFonts();
 }
 
 FPDF_EXPORT unsigned long FPDF_CALLCONV FPDF_GetLastError() {
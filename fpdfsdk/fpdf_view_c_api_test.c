@@ -405,6 +405,7 @@ int CheckPDFiumCApi() {
     CHK(FPDF_StructTree_Close);
     CHK(FPDF_StructTree_CountChildren);
     CHK(FPDF_StructTree_GetChildAtIndex);
+    CHK(FPDF_StructTree_GetElementForMarkedContentID);
     CHK(FPDF_StructTree_GetForPage);
 
     // fpdf_sysfontinfo.h
@@ -424,6 +425,8 @@ int CheckPDFiumCApi() {
     CHK(FPDFLink_GetTextRange);
     CHK(FPDFLink_GetURL);
     CHK(FPDFLink_LoadWebLinks);
+    CHK(FPDFText_BuildIndex);
+    CHK(FPDFText_CloseIndex);
     CHK(FPDFText_ClosePage);
     CHK(FPDFText_CountChars);
     CHK(FPDFText_CountRects);
@@ -434,6 +437,7 @@ int CheckPDFiumCApi() {
     CHK(FPDFText_GetBoundedText);
     CHK(FPDFText_GetCharAngle);
     CHK(FPDFText_GetCharBox);
+    CHK(FPDFText_GetCharData);
     CHK(FPDFText_GetCharIndexAtPos);
     CHK(FPDFText_GetCharOrigin);
     CHK(FPDFText_GetFillColor);
@@ -452,7 +456,10 @@ int CheckPDFiumCApi() {
     CHK(FPDFText_HasUnicodeMapError);
     CHK(FPDFText_IsGenerated);
     CHK(FPDFText_IsHyphen);
+    CHK(FPDFText_LoadIndex);
     CHK(FPDFText_LoadPage);
+    CHK(FPDFText_SaveIndex);
+    CHK(FPDFText_SearchIndex);
 
     // fpdf_thumbnail.h
     CHK(FPDFPage_GetDecodedThumbnailData);
@@ -495,6 +502,7 @@ int CheckPDFiumCApi() {
     CHK(FPDF_BStr_Init);
     CHK(FPDF_BStr_Set);
 #endif
+    CHK(FPDF_CloseDisplayList);
     CHK(FPDF_CloseDocument);
     CHK(FPDF_ClosePage);
     CHK(FPDF_CountNamedDests);
@@ -533,7 +541,9 @@ int CheckPDFiumCApi() {
     CHK(FPDF_LoadMemDocument);
     CHK(FPDF_LoadMemDocument64);
     CHK(FPDF_LoadPage);
+    CHK(FPDF_LoadPageTextOnly);
     CHK(FPDF_PageToDevice);
+    CHK(FPDF_RecordPageDisplayList);
 #ifdef _WIN32
     CHK(FPDF_RenderPage);
 #endif
@@ -542,6 +552,7 @@ int CheckPDFiumCApi() {
 #if defined(PDF_USE_SKIA)
     CHK(FPDF_RenderPageSkia);
 #endif
+    CHK(FPDF_ReplayDisplayList);
 #if defined(_WIN32)
     CHK(FPDF_SetPrintMode);
 #endif
@@ -5,6 +5,7 @@
 #include <math.h>
 
 #include <algorithm>
+#include <array>
 #include <limits>
 #include <memory>
 #include <string>
@@ -1199,6 +1200,55 @@ TEST_F(FPDFViewEmbedderTest, FPDFRenderPageBitmapWithMatrix) {
                                  tile_checksum);
 }
 
+TEST_F(FPDFViewEmbedderTest, DisplayListReplay) {
+  ASSERT_TRUE(OpenDocument("rectangles.pdf"));
+  ScopedEmbedderTestPage page = LoadScopedPage(0);
+  ASSERT_TRUE(page);
+
+  EXPECT_FALSE(FPDF_RecordPageDisplayList(nullptr, 1.0f, 0));
+  EXPECT_FALSE(FPDF_RecordPageDisplayList(page.get(), 0.0f, 0));
+  EXPECT_FALSE(FPDF_ReplayDisplayList(nullptr, nullptr, nullptr, nullptr, 0));
+  FPDF_CloseDisplayList(nullptr);
+
+  FPDF_DISPLAYLIST display_list =
+      FPDF_RecordPageDisplayList(page.get(), 1.0f, 0);
+  ASSERT_TRUE(display_list);
+
+  // Replaying at the recorded scale matches rendering the page directly.
+  constexpr int kPageWidth = 200;
+  constexpr int kPageHeight = 300;
+  {
+    ScopedFPDFBitmap bitmap(FPDFBitmap_Create(kPageWidth, kPageHeight, 0));
+    ASSERT_TRUE(FPDFBitmap_FillRect(bitmap.get(), 0, 0, kPageWidth,
+                                    kPageHeight, 0xFFFFFFFF));
+    EXPECT_TRUE(FPDF_ReplayDisplayList(bitmap.get(), display_list, nullptr,
+                                       nullptr, 0));
+    CompareBitmap(bitmap.get(), kPageWidth, kPageHeight,
+                  pdfium::RectanglesChecksum());
+  }
+
+  // Replaying at another scale and rotation matches rendering the page with
+  // the same matrix.
+  const FS_MATRIX matrix{0, 1.5, -1.5, 0, kPageHeight * 1.5, 0};
+  const FS_RECTF rect{0, 0, kPageHeight * 1.5, kPageWidth * 1.5};
+  constexpr int bitmap_width = kPageHeight * 3 / 2;
+  constexpr int bitmap_height = kPageWidth * 3 / 2;
+  ScopedFPDFBitmap expected(FPDFBitmap_Create(bitmap_width, bitmap_height, 0));
+  ASSERT_TRUE(FPDFBitmap_FillRect(expected.get(), 0, 0, bitmap_width,
+                                  bitmap_height, 0xFFFFFFFF));
+  FPDF_RenderPageBitmapWithMatrix(expected.get(), page.get(), &matrix, &rect,
+                                  0);
+
+  ScopedFPDFBitmap replayed(FPDFBitmap_Create(bitmap_width, bitmap_height, 0));
+  ASSERT_TRUE(FPDFBitmap_FillRect(replayed.get(), 0, 0, bitmap_width,
+                                  bitmap_height, 0xFFFFFFFF));
+  EXPECT_TRUE(FPDF_ReplayDisplayList(replayed.get(), display_list, &matrix,
+                                     &rect, 0));
+  EXPECT_EQ(HashBitmap(expected.get()), HashBitmap(replayed.get()));
+
+  FPDF_CloseDisplayList(display_list);
+}
+
 TEST_F(FPDFViewEmbedderTest, FPDFGetPageSizeByIndexF) {
   ASSERT_TRUE(OpenDocument("rectangles.pdf"));
 
@@ -2158,6 +2208,28 @@ TEST_F(FPDFViewEmbedderTest, RenderTransparencyOnWhiteBackground) {
   EXPECT_EQ(pdfium::kBlankPage200By200Checksum, HashBitmap(bitmap.get()));
 }
 
+TEST_F(FPDFViewEmbedderTest, RenderSoftMaskWithSmallGroupBBox) {
+  ASSERT_TRUE(OpenDocument("smask_bbox.pdf"));
+  static constexpr int kPageCount = 4;
+  std::array<std::string, kPageCount> checksums;
+  for (int i = 0; i < kPageCount; ++i) {
+    ScopedEmbedderTestPage page = LoadScopedPage(i);
+    ASSERT_TRUE(page);
+    ScopedFPDFBitmap bitmap = RenderLoadedPage(page.get());
+    checksums[i] = HashBitmap(bitmap.get());
+  }
+
+  // Pages 0 and 2 use a soft mask group with a /BBox smaller than the page.
+  // Pages 1 and 3 are the same, with a /BBox that covers the page.
+  EXPECT_EQ(checksums[1], checksums[0]);
+  EXPECT_EQ(checksums[3], checksums[2]);
+
+  // Pages 2 and 3 have a white soft mask backdrop, which lets the masked
+  // content show outside of the group.
+  EXPECT_NE(checksums[0], checksums[2]);
+  EXPECT_NE(pdfium::kBlankPage200By200Checksum, checksums[0]);
+}
+
 TEST_F(FPDFViewEmbedderTest, Bug2112) {
   static constexpr int kWidth = 595;
   static constexpr int kHeight = 842;
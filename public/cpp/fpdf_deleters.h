@@ -79,6 +79,10 @@ struct FPDFTextFindDeleter {
   inline void operator()(FPDF_SCHHANDLE handle) { FPDFText_FindClose(handle); }
 };
 
+struct FPDFTextIndexDeleter {
+  inline void operator()(FPDF_TEXTINDEX index) { FPDFText_CloseIndex(index); }
+};
+
 struct FPDFTextPageDeleter {
   inline void operator()(FPDF_TEXTPAGE text) { FPDFText_ClosePage(text); }
 };
@@ -62,6 +62,26 @@ FPDF_StructTree_CountChildren(FPDF_STRUCTTREE struct_tree);
 FPDF_EXPORT FPDF_STRUCTELEMENT FPDF_CALLCONV
 FPDF_StructTree_GetChildAtIndex(FPDF_STRUCTTREE struct_tree, int index);
 
+// Experimental API.
+// Function: FPDF_StructTree_GetElementForMarkedContentID
+//          Get the structure element that marked content on the page belongs
+//          to.
+// Parameters:
+//          struct_tree -   Handle to the structure tree, as returned by
+//                          FPDF_StructTree_GetForPage().
+//          mcid        -   The marked content ID, as returned by
+//                          FPDFPageObj_GetMarkedContentID().
+// Return value:
+//          The element that the structure tree's parent tree lists for |mcid|,
+//          or NULL if there is none. The caller does not own the handle. The
+//          handle remains valid as long as |struct_tree| remains valid.
+// Comments:
+//          This takes a single lookup, rather than a search of the elements of
+//          |struct_tree|.
+FPDF_EXPORT FPDF_STRUCTELEMENT FPDF_CALLCONV
+FPDF_StructTree_GetElementForMarkedContentID(FPDF_STRUCTTREE struct_tree,
+                                             int mcid);
+
 // Function: FPDF_StructElement_GetAltText
 //          Get the alt text for a given element.
 // Parameters:
@@ -345,6 +345,49 @@ FPDFText_GetCharOrigin(FPDF_TEXTPAGE text_page,
                        double* x,
                        double* y);
 
+// Experimental API.
+// Function: FPDFText_GetCharData
+//          Get the data of a range of characters in a single call. Each kind
+//          of data goes into its own caller-provided array, with one element
+//          per character, so the arrays can be copied directly into columnar
+//          storage.
+// Parameters:
+//          text_page   -   Handle to a text page information structure.
+//                          Returned by FPDFText_LoadPage().
+//          start_index -   Zero-based index of the first character.
+//          count       -   Number of characters to get.
+//          unicodes    -   Receives the values FPDFText_GetUnicode() returns.
+//          origins     -   Receives the origins FPDFText_GetCharOrigin()
+//                          returns.
+//          boxes       -   Receives the boxes FPDFText_GetCharBox() returns.
+//          font_sizes  -   Receives the values FPDFText_GetFontSize()
+//                          returns.
+//          object_ids  -   Receives ids for the text objects of the
+//                          characters. Ids number the distinct text objects
+//                          of |text_page| in order of first appearance,
+//                          starting from 0, and are the same for any range.
+//                          Characters without a text object get -1.
+//          font_ids    -   Receives ids for the fonts of the characters,
+//                          numbered like |object_ids|.
+// Return Value:
+//          The number of characters filled in, which is less than |count| if
+//          the range goes past the last character, or -1 if |text_page| is
+//          invalid, or if |start_index| or |count| is negative.
+// Comments:
+//          Any of the arrays may be NULL, to skip that kind of data. The others
+//          must have room for |count| elements.
+//          All positions are measured in PDF "user space".
+//
+FPDF_EXPORT int FPDF_CALLCONV FPDFText_GetCharData(FPDF_TEXTPAGE text_page,
+                                                   int start_index,
+                                                   int count,
+                                                   unsigned int* unicodes,
+                                                   FS_POINTF* origins,
+                                                   FS_RECTF* boxes,
+                                                   float* font_sizes,
+                                                   int* object_ids,
+                                                   int* font_ids);
+
 // Function: FPDFText_GetCharIndexAtPos
 //          Get the index of a character at or nearby a certain position on the
 //          page.
@@ -554,6 +597,97 @@ FPDF_EXPORT int FPDF_CALLCONV FPDFText_GetSchCount(FPDF_SCHHANDLE handle);
 //
 FPDF_EXPORT void FPDF_CALLCONV FPDFText_FindClose(FPDF_SCHHANDLE handle);
 
+// Experimental API.
+// Function: FPDFText_BuildIndex
+//          Build a search index of the words on every page of a document, to
+//          search the whole document without loading its pages again.
+// Parameters:
+//          document    -   Handle to a document. Returned by FPDF_LoadDocument.
+// Return Value:
+//          A handle to the index, or NULL if |document| is invalid.
+//          FPDFText_CloseIndex() must be called to release it.
+// Comments:
+//          Words are runs of letters and digits, and match regardless of case.
+//          The pages are loaded one at a time with FPDF_LoadPageTextOnly(),
+//          and released once their words are indexed. The index does not refer
+//          to |document| and may outlive it.
+//
+FPDF_EXPORT FPDF_TEXTINDEX FPDF_CALLCONV
+FPDFText_BuildIndex(FPDF_DOCUMENT document);
+
+// Experimental API.
+// Function: FPDFText_SaveIndex
+//          Serialize a search index, to store it alongside its document.
+// Parameters:
+//          index       -   Handle to a search index. Returned by
+//                          FPDFText_BuildIndex() or FPDFText_LoadIndex().
+//          buffer      -   A buffer for the serialized index. May be NULL.
+//          buflen      -   The length of |buffer|, in bytes.
+// Return Value:
+//          The length of the serialized index in bytes, or 0 if |index| is
+//          invalid or its length does not fit in an unsigned long. |buffer|
+//          is only modified if |buflen| is at least this length.
+//
+FPDF_EXPORT unsigned long FPDF_CALLCONV
+FPDFText_SaveIndex(FPDF_TEXTINDEX index, void* buffer, unsigned long buflen);
+
+// Experimental API.
+// Function: FPDFText_LoadIndex
+//          Load a search index serialized by FPDFText_SaveIndex().
+// Parameters:
+//          data        -   The serialized index.
+//          size        -   The length of |data|, in bytes.
+// Return Value:
+//          A handle to the index, or NULL if |data| is not a serialized index.
+//          FPDFText_CloseIndex() must be called to release it.
+// Comments:
+//          The caller must make sure the index was built from the same
+//          document it is used with.
+//
+FPDF_EXPORT FPDF_TEXTINDEX FPDF_CALLCONV
+FPDFText_LoadIndex(const void* data, unsigned long size);
+
+// Experimental API.
+// Function: FPDFText_SearchIndex
+//          Find where the words of a query occur one after the other.
+// Parameters:
+//          index        -   Handle to a search index. Returned by
+//                           FPDFText_BuildIndex() or FPDFText_LoadIndex().
+//          query        -   The words to find. Other characters only
+//                           separate the words.
+//          page_indices -   Receives the zero-based page index of each hit.
+//          char_indices -   Receives the index of the first character of each
+//                           hit, as used by FPDFText_GetUnicode().
+//          char_counts  -   Receives the number of characters of each hit.
+//          rects        -   Receives the bounding box of each hit, in PDF
+//                           "user space".
+//          max_hits     -   The number of elements of each non-NULL array.
+// Return Value:
+//          The total number of hits, which may be more than |max_hits|, or -1
+//          if |index| is invalid or |max_hits| is negative.
+// Comments:
+//          Hits are sorted by page, then by character index. Any of the arrays
+//          may be NULL, to skip that kind of data.
+//
+FPDF_EXPORT int FPDF_CALLCONV FPDFText_SearchIndex(FPDF_TEXTINDEX index,
+                                                   FPDF_WIDESTRING query,
+                                                   int* page_indices,
+                                                   int* char_indices,
+                                                   int* char_counts,
+                                                   FS_RECTF* rects,
+                                                   int max_hits);
+
+// Experimental API.
+// Function: FPDFText_CloseIndex
+//          Release a search index.
+// Parameters:
+//          index       -   Handle to a search index. Returned by
+//                          FPDFText_BuildIndex() or FPDFText_LoadIndex().
+// Return Value:
+//          None.
+//
+FPDF_EXPORT void FPDF_CALLCONV FPDFText_CloseIndex(FPDF_TEXTINDEX index);
+
 // Function: FPDFLink_LoadWebLinks
 //          Prepare information about weblinks in a page.
 // Parameters:
@@ -571,6 +705,9 @@ FPDF_EXPORT void FPDF_CALLCONV FPDFText_FindClose(FPDF_SCHHANDLE handle);
 //          applications can allow user to click on those characters to activate
 //          the link, even the PDF doesn't come with link annotations.
 //
+//          The links are detected on first use of the returned handle, so
+//          |text_page| must not be closed before FPDFLink_CloseWebLinks.
+//
 //          FPDFLink_CloseWebLinks must be called to release resources.
 //
 FPDF_EXPORT FPDF_PAGELINK FPDF_CALLCONV
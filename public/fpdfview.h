@@ -67,6 +67,7 @@ typedef struct fpdf_bitmap_t__* FPDF_BITMAP;
 typedef struct fpdf_bookmark_t__* FPDF_BOOKMARK;
 typedef struct fpdf_clippath_t__* FPDF_CLIPPATH;
 typedef struct fpdf_dest_t__* FPDF_DEST;
+typedef struct fpdf_displaylist_t__* FPDF_DISPLAYLIST;
 typedef struct fpdf_document_t__* FPDF_DOCUMENT;
 typedef struct fpdf_font_t__* FPDF_FONT;
 typedef struct fpdf_form_handle_t__* FPDF_FORMHANDLE;
@@ -87,6 +88,7 @@ typedef const struct fpdf_structelement_attr_t__* FPDF_STRUCTELEMENT_ATTR;
 typedef const struct fpdf_structelement_attr_value_t__*
 FPDF_STRUCTELEMENT_ATTR_VALUE;
 typedef struct fpdf_structtree_t__* FPDF_STRUCTTREE;
+typedef struct fpdf_textindex_t__* FPDF_TEXTINDEX;
 typedef struct fpdf_textpage_t__* FPDF_TEXTPAGE;
 typedef struct fpdf_widget_t__* FPDF_WIDGET;
 typedef struct fpdf_xobject_t__* FPDF_XOBJECT;
@@ -280,6 +282,14 @@ typedef struct FPDF_LIBRARY_CONFIG_ {
   // corresponding render library is not included in the build will similarly
   // fail with an immediate crash.
   FPDF_RENDERER_TYPE m_RendererType;
+
+  // Version 5 - Experimental.
+
+  // Path of a file for the built-in FXGE font loading code to cache the fonts
+  // it finds in, or NULL to not cache them. Font files are then only parsed
+  // again when they change. The file is created if it does not exist. May be
+  // ignored entirely depending upon the platform.
+  const char* m_pFontCatalogPath;
 } FPDF_LIBRARY_CONFIG;
 
 // Function: FPDF_InitLibraryWithConfig
@@ -693,6 +703,28 @@ FPDF_EXPORT int FPDF_CALLCONV FPDF_GetPageCount(FPDF_DOCUMENT document);
 FPDF_EXPORT FPDF_PAGE FPDF_CALLCONV FPDF_LoadPage(FPDF_DOCUMENT document,
                                                   int page_index);
 
+// Experimental API.
+// Function: FPDF_LoadPageTextOnly
+//          Load a page inside the document for text extraction only.
+// Parameters:
+//          document    -   Handle to document. Returned by FPDF_LoadDocument
+//          page_index  -   Index number of the page. 0 for the first page.
+// Return value:
+//          A handle to the loaded page, or NULL if page load fails.
+// Comments:
+//          Only the text objects of the page, and the form objects that
+//          contain them, are loaded, along with their fill and stroke
+//          colors. Path, image and shading objects are skipped, as are
+//          clipping paths. This makes loading faster and uses less memory
+//          when the page is only passed to FPDFText_LoadPage(). Rendering the
+//          page does not show the skipped content.
+//          The page is read-only: FPDFPage_InsertObject(),
+//          FPDFPage_RemoveObject() and FPDFPage_GenerateContent() fail for
+//          it, so saving the document keeps the page's original content.
+//          The loaded page can be closed using FPDF_ClosePage.
+FPDF_EXPORT FPDF_PAGE FPDF_CALLCONV
+FPDF_LoadPageTextOnly(FPDF_DOCUMENT document, int page_index);
+
 // Experimental API
 // Function: FPDF_GetPageWidthF
 //          Get page width.
@@ -820,6 +852,9 @@ FPDF_EXPORT int FPDF_CALLCONV FPDF_GetPageSizeByIndex(FPDF_DOCUMENT document,
 #define FPDF_RENDER_NO_SMOOTHIMAGE 0x2000
 // Set to disable anti-aliasing on paths.
 #define FPDF_RENDER_NO_SMOOTHPATH 0x4000
+// Set to position anti-aliased text to a fraction of a pixel, rather than to
+// whole pixels. This has no effect on text rendered with LCD optimization.
+#define FPDF_RENDER_SUBPIXEL_TEXT 0x8000
 // Set whether to render in a reverse Byte order, this flag is only used when
 // rendering to a bitmap.
 #define FPDF_REVERSE_BYTE_ORDER 0x10
@@ -930,6 +965,65 @@ FPDF_RenderPageBitmapWithMatrix(FPDF_BITMAP bitmap,
                                 const FS_RECTF* clipping,
                                 int flags);
 
+// Experimental API.
+// Function: FPDF_RecordPageDisplayList
+//          Record the rendering of a page into a display list, which can be
+//          drawn again at any scale with FPDF_ReplayDisplayList() without
+//          re-interpreting the page contents.
+// Parameters:
+//          page        -   Handle to the page. Returned by FPDF_LoadPage.
+//          scale       -   Device pixels per page unit to record at. Paths and
+//                          text stay sharp at any replay scale, but content
+//                          that has to be rasterized while recording, such as
+//                          transparency groups, shadings and patterns, keeps
+//                          this resolution. Must be positive.
+//          flags       -   0 for normal display, or combination of the Page
+//                          Rendering flags defined above. Flags that only
+//                          affect the output bitmap, such as
+//                          FPDF_REVERSE_BYTE_ORDER, are ignored here and
+//                          should be passed to FPDF_ReplayDisplayList().
+// Return value:
+//          A handle to the display list, or NULL on failure. The display list
+//          keeps |page| alive, and must be closed with FPDF_CloseDisplayList()
+//          before the document is closed. Changes made to |page| after the
+//          display list is recorded are not reflected in it.
+FPDF_EXPORT FPDF_DISPLAYLIST FPDF_CALLCONV
+FPDF_RecordPageDisplayList(FPDF_PAGE page, float scale, int flags);
+
+// Experimental API.
+// Function: FPDF_ReplayDisplayList
+//          Draw a display list to a device independent bitmap.
+// Parameters:
+//          bitmap       -   Handle to the device independent bitmap (as the
+//                           output buffer).
+//          display_list -   Handle to the display list. Returned by
+//                           FPDF_RecordPageDisplayList().
+//          matrix       -   The transform matrix, which must be invertible.
+//                           Same as the |matrix| parameter of
+//                           FPDF_RenderPageBitmapWithMatrix().
+//          clipping     -   The rect to clip to in device coords, or NULL
+//                           to draw to the whole bitmap.
+//          flags        -   0, or FPDF_REVERSE_BYTE_ORDER.
+// Return value:
+//          True on success, false otherwise.
+FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV
+FPDF_ReplayDisplayList(FPDF_BITMAP bitmap,
+                       FPDF_DISPLAYLIST display_list,
+                       const FS_MATRIX* matrix,
+                       const FS_RECTF* clipping,
+                       int flags);
+
+// Experimental API.
+// Function: FPDF_CloseDisplayList
+//          Close a display list and release all its resources.
+// Parameters:
+//          display_list -   Handle to the display list. Returned by
+//                           FPDF_RecordPageDisplayList().
+// Return value:
+//          None.
+FPDF_EXPORT void FPDF_CALLCONV
+FPDF_CloseDisplayList(FPDF_DISPLAYLIST display_list);
+
 #if defined(PDF_USE_SKIA)
 // Experimental API.
 // Function: FPDF_RenderPageSkia
@@ -0,0 +1,191 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Measures how long it takes to render pages made of the paths that tables,
+// forms and charts consist of: axis-aligned rectangles that get filled,
+// stroked or both, and horizontal and vertical rules, some of them dashed.
+// The AGG renderer draws most of these without rasterizing them, while pages
+// of diagonal rules show the cost of rasterizing. Prints the median and the
+// fastest render time of each page over a number of rounds.
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iterator>
+#include <vector>
+
+#include "public/cpp/fpdf_scopers.h"
+#include "public/fpdf_edit.h"
+#include "public/fpdfview.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr int kPageWidth = 612;
+constexpr int kPageHeight = 792;
+
+// Render at twice the page size, as when zooming in.
+constexpr int kBitmapWidth = 2 * kPageWidth;
+constexpr int kBitmapHeight = 2 * kPageHeight;
+
+// The table the pages are made of.
+constexpr int kRows = 70;
+constexpr int kColumns = 10;
+constexpr float kTableLeft = 36;
+constexpr float kTableTop = 756;
+constexpr float kCellWidth = 54;
+constexpr float kCellHeight = 10;
+
+constexpr int kDefaultRounds = 20;
+
+FPDF_PAGEOBJECT NewCell(int row, int column) {
+  return FPDFPageObj_CreateNewRect(kTableLeft + column * kCellWidth,
+                                   kTableTop - (row + 1) * kCellHeight,
+                                   kCellWidth, kCellHeight);
+}
+
+void AddCells(FPDF_PAGE page, bool fill, float stroke_width) {
+  for (int row = 0; row < kRows; ++row) {
+    for (int column = 0; column < kColumns; ++column) {
+      FPDF_PAGEOBJECT cell = NewCell(row, column);
+      FPDFPageObj_SetFillColor(cell, 235, 240, 255, 255);
+      FPDFPageObj_SetStrokeColor(cell, 0, 0, 0, 255);
+      FPDFPageObj_SetStrokeWidth(cell, stroke_width);
+      FPDFPath_SetDrawMode(
+          cell, fill ? FPDF_FILLMODE_WINDING : FPDF_FILLMODE_NONE,
+          stroke_width >= 0);
+      FPDFPage_InsertObject(page, cell);
+    }
+  }
+}
+
+void AddFilledCells(FPDF_PAGE page) {
+  AddCells(page, /*fill=*/true, /*stroke_width=*/-1);
+}
+
+void AddHairlineCells(FPDF_PAGE page) {
+  AddCells(page, /*fill=*/false, /*stroke_width=*/0);
+}
+
+void AddStrokedCells(FPDF_PAGE page) {
+  AddCells(page, /*fill=*/false, /*stroke_width=*/1.5f);
+}
+
+void AddFilledAndStrokedCells(FPDF_PAGE page) {
+  AddCells(page, /*fill=*/true, /*stroke_width=*/1);
+}
+
+// Adds the rules between the rows and the columns of the table, each as a
+// path of its own. Rules that `slant` get their end moved by that much.
+void AddRules(FPDF_PAGE page, bool dashed, float slant) {
+  constexpr float kTableRight = kTableLeft + kColumns * kCellWidth;
+  constexpr float kTableBottom = kTableTop - kRows * kCellHeight;
+  constexpr float kDashes[] = {3, 2};
+  auto add_rule = [&](float x1, float y1, float x2, float y2) {
+    FPDF_PAGEOBJECT rule = FPDFPageObj_CreateNewPath(x1, y1);
+    FPDFPath_LineTo(rule, x2, y2);
+    FPDFPageObj_SetStrokeColor(rule, 96, 96, 96, 255);
+    FPDFPageObj_SetStrokeWidth(rule, 0.75f);
+    if (dashed) {
+      FPDFPageObj_SetDashArray(rule, kDashes, std::size(kDashes), 0);
+    }
+    FPDFPath_SetDrawMode(rule, FPDF_FILLMODE_NONE, /*stroke=*/true);
+    FPDFPage_InsertObject(page, rule);
+  };
+  for (int row = 0; row <= kRows; ++row) {
+    const float y = kTableTop - row * kCellHeight;
+    add_rule(kTableLeft, y, kTableRight, y + slant);
+  }
+  for (int column = 0; column <= kColumns; ++column) {
+    const float x = kTableLeft + column * kCellWidth;
+    add_rule(x, kTableTop, x + slant, kTableBottom);
+  }
+}
+
+void AddSolidRules(FPDF_PAGE page) {
+  AddRules(page, /*dashed=*/false, /*slant=*/0);
+}
+
+void AddDashedRules(FPDF_PAGE page) {
+  AddRules(page, /*dashed=*/true, /*slant=*/0);
+}
+
+void AddDiagonalRules(FPDF_PAGE page) {
+  AddRules(page, /*dashed=*/false, /*slant=*/4);
+}
+
+struct PageKind {
+  const char* name;
+  void (*add_objects)(FPDF_PAGE page);
+};
+
+constexpr PageKind kPageKinds[] = {
+    {"filled cells", AddFilledCells},
+    {"hairline cells", AddHairlineCells},
+    {"stroked cells", AddStrokedCells},
+    {"filled and stroked cells", AddFilledAndStrokedCells},
+    {"rules", AddSolidRules},
+    {"dashed rules", AddDashedRules},
+    {"diagonal rules", AddDiagonalRules},
+};
+
+double RenderMilliseconds(FPDF_PAGE page, FPDF_BITMAP bitmap) {
+  FPDFBitmap_FillRect(bitmap, 0, 0, kBitmapWidth, kBitmapHeight, 0xFFFFFFFF);
+  const Clock::time_point start = Clock::now();
+  FPDF_RenderPageBitmap(bitmap, page, 0, 0, kBitmapWidth, kBitmapHeight, 0, 0);
+  return std::chrono::duration<double, std::milli>(Clock::now() - start)
+      .count();
+}
+
+}  // namespace
+
+int main(int argc, const char* argv[]) {
+  if (argc > 2) {
+    fprintf(stderr, "Usage: %s [rounds]\n", argv[0]);
+    return 1;
+  }
+  const int rounds = argc == 2 ? atoi(argv[1]) : kDefaultRounds;
+  if (rounds <= 0) {
+    fprintf(stderr, "Invalid number of rounds: %s\n", argv[1]);
+    return 1;
+  }
+
+  FPDF_InitLibrary();
+  int result = 0;
+  {
+    ScopedFPDFDocument doc(FPDF_CreateNewDocument());
+    ScopedFPDFBitmap bitmap(FPDFBitmap_Create(kBitmapWidth, kBitmapHeight, 0));
+    if (!doc || !bitmap) {
+      fprintf(stderr, "Failed to create the document\n");
+      result = 1;
+    }
+    for (size_t i = 0; result == 0 && i < std::size(kPageKinds); ++i) {
+      const PageKind& kind = kPageKinds[i];
+      ScopedFPDFPage page(FPDFPage_New(doc.get(), static_cast<int>(i),
+                                       kPageWidth, kPageHeight));
+      if (!page) {
+        fprintf(stderr, "Failed to create a page of %s\n", kind.name);
+        result = 1;
+        break;
+      }
+      kind.add_objects(page.get());
+      FPDFPage_GenerateContent(page.get());
+
+      // The first render also loads whatever the page needs.
+      RenderMilliseconds(page.get(), bitmap.get());
+      std::vector<double> times;
+      for (int round = 0; round < rounds; ++round) {
+        times.push_back(RenderMilliseconds(page.get(), bitmap.get()));
+      }
+      std::sort(times.begin(), times.end());
+      printf("%s: median %.3f ms, fastest %.3f ms\n", kind.name,
+             times[times.size() / 2], times.front());
+    }
+  }
+  FPDF_DestroyLibrary();
+  return result;
+}
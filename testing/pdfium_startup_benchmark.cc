@@ -0,0 +1,80 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Measures how long a short-lived process takes to render the first page of a
+// document: library initialization, loading the document and the page, and
+// rendering it. Startup costs are only paid once per process, so run this
+// several times and compare the medians.
+
+#include <stdio.h>
+
+#include <chrono>
+
+#include "public/cpp/fpdf_scopers.h"
+#include "public/fpdfview.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double MillisecondsSince(Clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(Clock::now() - start)
+      .count();
+}
+
+}  // namespace
+
+int main(int argc, const char* argv[]) {
+  if (argc != 2) {
+    fprintf(stderr, "Usage: %s <pdf-file>\n", argv[0]);
+    return 1;
+  }
+
+  const Clock::time_point start = Clock::now();
+  FPDF_InitLibrary();
+  const double init_ms = MillisecondsSince(start);
+
+  int result = 1;
+  {
+    Clock::time_point step_start = Clock::now();
+    ScopedFPDFDocument doc(FPDF_LoadDocument(argv[1], nullptr));
+    if (!doc) {
+      fprintf(stderr, "Failed to load %s, error %lu\n", argv[1],
+              FPDF_GetLastError());
+      FPDF_DestroyLibrary();
+      return 1;
+    }
+    const double load_document_ms = MillisecondsSince(step_start);
+
+    step_start = Clock::now();
+    ScopedFPDFPage page(FPDF_LoadPage(doc.get(), 0));
+    const double load_page_ms = MillisecondsSince(step_start);
+
+    step_start = Clock::now();
+    if (page) {
+      const int width = static_cast<int>(FPDF_GetPageWidthF(page.get()));
+      const int height = static_cast<int>(FPDF_GetPageHeightF(page.get()));
+      ScopedFPDFBitmap bitmap(FPDFBitmap_Create(width, height, 0));
+      if (bitmap) {
+        FPDFBitmap_FillRect(bitmap.get(), 0, 0, width, height, 0xFFFFFFFF);
+        FPDF_RenderPageBitmap(bitmap.get(), page.get(), 0, 0, width, height,
+                              0, FPDF_ANNOT);
+        result = 0;
+      }
+    }
+    const double render_page_ms = MillisecondsSince(step_start);
+    const double first_page_ms = MillisecondsSince(start);
+
+    if (result != 0) {
+      fprintf(stderr, "Failed to render the first page\n");
+    }
+    printf("init: %.3f ms\n", init_ms);
+    printf("load document: %.3f ms\n", load_document_ms);
+    printf("load page: %.3f ms\n", load_page_ms);
+    printf("render page: %.3f ms\n", render_page_ms);
+    printf("time to first page: %.3f ms\n", first_page_ms);
+  }
+  FPDF_DestroyLibrary();
+  return result;
+}
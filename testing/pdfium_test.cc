@@ -168,6 +168,7 @@ struct Options {
   bool no_smoothtext = false;
   bool no_smoothimage = false;
   bool no_smoothpath = false;
+  bool subpixel_text = false;
   bool reverse_byte_order = false;
   bool save_attachments = false;
   bool save_images = false;
@@ -235,6 +236,9 @@ int PageRenderFlagsFromOptions(const Options& options) {
   if (options.no_smoothpath) {
     flags |= FPDF_RENDER_NO_SMOOTHPATH;
   }
+  if (options.subpixel_text) {
+    flags |= FPDF_RENDER_SUBPIXEL_TEXT;
+  }
   if (options.reverse_byte_order) {
     flags |= FPDF_REVERSE_BYTE_ORDER;
   }
@@ -514,6 +518,8 @@ bool ParseCommandLine(const std::vector<std::string>& args,
       options->no_smoothimage = true;
     } else if (cur_arg == "--no-smoothpath") {
       options->no_smoothpath = true;
+    } else if (cur_arg == "--subpixel-text") {
+      options->subpixel_text = true;
     } else if (cur_arg == "--reverse-byte-order") {
       options->reverse_byte_order = true;
     } else if (cur_arg == "--save-attachments") {
@@ -1786,6 +1792,8 @@ constexpr char kUsageString[] =
     "  --no-smoothtext        - render disabling text anti-aliasing\n"
     "  --no-smoothimage       - render disabling image anti-alisasing\n"
     "  --no-smoothpath        - render disabling path anti-aliasing\n"
+    "  --subpixel-text        - render positioning text to fractions of a "
+    "pixel\n"
     "  --reverse-byte-order   - render to BGRA, if supported by the output "
     "format\n"
     "  --save-attachments     - write embedded attachments "